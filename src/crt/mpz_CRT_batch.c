@@ -0,0 +1,224 @@
+/* This file is part of msolve.
+ *
+ * msolve is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * msolve is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with msolve.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors:
+ * Jérémy Berthomieu
+ * Christian Eder
+ * Mohab Safey El Din */
+
+/**
+
+Batched Chinese remaindering.
+
+Instead of folding primes one by one into a lifted integer (which costs a
+pass over the whole integer per prime), the images modulo a batch of
+primes are first combined along a subproduct tree. The result is then
+merged into the integer lifted so far with a single multiplication by the
+current modulus.
+
+Usage: add the primes of the batch with mpz_CRT_batch_add_prime, call
+mpz_CRT_batch_prepare once, lift all integers with mpz_CRT_batch_lift and
+close the batch with mpz_CRT_batch_done.
+
+ **/
+
+typedef struct{
+  uint32_t alloc; /* maximal number of primes in a batch */
+  uint32_t ld; /* number of primes in the current batch */
+  uint64_t *primes; /* primes of the current batch */
+  mpz_t *tree; /* subproduct tree, node i has children 2i and 2i+1 */
+  mpz_t *inv; /* inverse of the left child modulo the right child */
+  mpz_t mod; /* modulus of the integers lifted so far */
+  mpz_t prod; /* mod times the product of the primes of the batch */
+  mpz_t minv; /* inverse of mod modulo the root of the tree */
+} mpz_CRT_batch_struct;
+
+typedef mpz_CRT_batch_struct mpz_CRT_batch_t[1];
+
+/* maximum number of primes whose images are buffered before being merged
+ * into the lifted integers, used by the multi-modular lifting steps */
+#define CRT_BATCH_NPRIMES 32
+
+/* mod is the modulus of the integers which are going to be lifted */
+static inline void mpz_CRT_batch_init(mpz_CRT_batch_t cb, uint32_t alloc,
+                                      const mpz_t mod){
+  cb->alloc = alloc;
+  cb->ld = 0;
+  cb->primes = (uint64_t *)calloc(alloc, sizeof(uint64_t));
+  cb->tree = (mpz_t *)malloc(sizeof(mpz_t) * 4 * alloc);
+  cb->inv = (mpz_t *)malloc(sizeof(mpz_t) * 4 * alloc);
+  for(uint32_t i = 0; i < 4 * alloc; i++){
+    mpz_init(cb->tree[i]);
+    mpz_init(cb->inv[i]);
+  }
+  mpz_init_set(cb->mod, mod);
+  mpz_init_set(cb->prod, mod);
+  mpz_init(cb->minv);
+}
+
+static inline void mpz_CRT_batch_clear(mpz_CRT_batch_t cb){
+  for(uint32_t i = 0; i < 4 * cb->alloc; i++){
+    mpz_clear(cb->tree[i]);
+    mpz_clear(cb->inv[i]);
+  }
+  free(cb->tree);
+  free(cb->inv);
+  free(cb->primes);
+  mpz_clear(cb->mod);
+  mpz_clear(cb->prod);
+  mpz_clear(cb->minv);
+}
+
+/* returns the index of prime in the batch, images modulo prime have to be
+ * given at that index to mpz_CRT_batch_lift */
+static inline uint32_t mpz_CRT_batch_add_prime(mpz_CRT_batch_t cb,
+                                               uint64_t prime){
+  if(cb->ld >= cb->alloc){
+    fprintf(stderr, "Exception (mpz_CRT_batch). Batch is full.\n");
+    exit(1);
+  }
+  cb->primes[cb->ld] = prime;
+  return cb->ld++;
+}
+
+static void _mpz_CRT_batch_tree(mpz_CRT_batch_t cb, uint32_t node,
+                                uint32_t lo, uint32_t hi){
+  if(hi - lo == 1){
+    mpz_set_ui(cb->tree[node], cb->primes[lo]);
+    return;
+  }
+  const uint32_t mid = lo + (hi - lo) / 2;
+  _mpz_CRT_batch_tree(cb, 2 * node, lo, mid);
+  _mpz_CRT_batch_tree(cb, 2 * node + 1, mid, hi);
+  mpz_mul(cb->tree[node], cb->tree[2 * node], cb->tree[2 * node + 1]);
+  if(mpz_invert(cb->inv[node], cb->tree[2 * node],
+                cb->tree[2 * node + 1]) == 0){
+    fprintf(stderr, "Exception (mpz_CRT_batch). Primes are not coprime.\n");
+    exit(1);
+  }
+}
+
+/* builds the subproduct tree of the batch and the inverse of the current
+ * modulus, to be called once before lifting the integers */
+static inline void mpz_CRT_batch_prepare(mpz_CRT_batch_t cb){
+  if(cb->ld == 0){
+    mpz_set(cb->prod, cb->mod);
+    return;
+  }
+  _mpz_CRT_batch_tree(cb, 1, 0, cb->ld);
+  mpz_mul(cb->prod, cb->mod, cb->tree[1]);
+  if(mpz_invert(cb->minv, cb->mod, cb->tree[1]) == 0){
+    fprintf(stderr, "Exception (mpz_CRT_batch). Modulus is not invertible.\n");
+    exit(1);
+  }
+}
+
+/* out = integer modulo the product of primes lo, ..., hi-1 whose images are
+ * res[lo], ..., res[hi-1] */
+static void _mpz_CRT_batch_combine(mpz_t out, const uint32_t *res,
+                                   const mpz_CRT_batch_t cb, uint32_t node,
+                                   uint32_t lo, uint32_t hi, mpz_t tmp){
+  if(hi - lo == 1){
+    mpz_set_ui(out, res[lo]);
+    return;
+  }
+  const uint32_t mid = lo + (hi - lo) / 2;
+  mpz_t right;
+  mpz_init(right);
+  _mpz_CRT_batch_combine(out, res, cb, 2 * node, lo, mid, tmp);
+  _mpz_CRT_batch_combine(right, res, cb, 2 * node + 1, mid, hi, tmp);
+  /* out + left * ((right - out) / left mod right) */
+  mpz_sub(tmp, right, out);
+  mpz_mul(tmp, tmp, cb->inv[node]);
+  mpz_mod(tmp, tmp, cb->tree[2 * node + 1]);
+  mpz_addmul(out, cb->tree[2 * node], tmp);
+  mpz_clear(right);
+}
+
+/**
+
+   out is given modulo cb->mod, it is replaced by the integer modulo cb->prod
+   which equals out modulo cb->mod and res[i] modulo cb->primes[i]. The
+   result lies in [0, cb->prod) if sign = 0 and in (-cb->prod/2, cb->prod/2]
+   otherwise.
+
+   Different integers may be lifted in parallel.
+
+ **/
+static inline void mpz_CRT_batch_lift(mpz_t out, const uint32_t *res,
+                                      const mpz_CRT_batch_t cb, int sign){
+  if(cb->ld == 0){
+    return;
+  }
+  mpz_t x, tmp;
+  mpz_init(x);
+  mpz_init(tmp);
+
+  _mpz_CRT_batch_combine(x, res, cb, 1, 0, cb->ld, tmp);
+
+  if(mpz_sgn(out) < 0){
+    mpz_add(out, out, cb->mod);
+  }
+  /* out + mod * ((x - out) / mod mod root) */
+  mpz_sub(x, x, out);
+  mpz_mul(x, x, cb->minv);
+  mpz_mod(x, x, cb->tree[1]);
+  mpz_addmul(out, cb->mod, x);
+
+  if(sign){
+    mpz_sub(tmp, out, cb->prod);
+    if(mpz_cmpabs(out, tmp) > 0){
+      mpz_swap(out, tmp);
+    }
+  }
+  mpz_clear(x);
+  mpz_clear(tmp);
+}
+
+static void _mpz_CRT_batch_reduce(uint32_t *res, const mpz_t in,
+                                  const mpz_CRT_batch_t cb, uint32_t node,
+                                  uint32_t lo, uint32_t hi){
+  if(hi - lo <= 8){
+    for(uint32_t i = lo; i < hi; i++){
+      res[i] = mpz_fdiv_ui(in, cb->primes[i]);
+    }
+    return;
+  }
+  const uint32_t mid = lo + (hi - lo) / 2;
+  mpz_t r;
+  mpz_init(r);
+  mpz_fdiv_r(r, in, cb->tree[2 * node]);
+  _mpz_CRT_batch_reduce(res, r, cb, 2 * node, lo, mid);
+  mpz_fdiv_r(r, in, cb->tree[2 * node + 1]);
+  _mpz_CRT_batch_reduce(res, r, cb, 2 * node + 1, mid, hi);
+  mpz_clear(r);
+}
+
+/* res[i] = in modulo cb->primes[i], computed along the subproduct tree,
+ * hence mpz_CRT_batch_prepare must have been called. Different integers may
+ * be reduced in parallel. */
+static inline void mpz_CRT_batch_reduce(uint32_t *res, const mpz_t in,
+                                        const mpz_CRT_batch_t cb){
+  if(cb->ld == 0){
+    return;
+  }
+  _mpz_CRT_batch_reduce(res, in, cb, 1, 0, cb->ld);
+}
+
+/* closes the current batch, all integers must have been lifted */
+static inline void mpz_CRT_batch_done(mpz_CRT_batch_t cb){
+  mpz_set(cb->mod, cb->prod);
+  cb->ld = 0;
+}
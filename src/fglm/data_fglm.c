@@ -199,6 +199,7 @@ static inline fglm_bms_data_t *allocate_fglm_bms_data(szmat_t dim, mp_limb_t pri
   nmod_berlekamp_massey_init(data_bms->BMS, (mp_limb_t)prime);
 
   nmod_poly_factor_init(data_bms->sqf);
+  data_bms->block_dim = 0;
   return data_bms;
 }
 
@@ -39,7 +39,7 @@ double omp_get_wtime(void) { return realtime();}
 #define MIN(x, y) ((x) > (y) ? (y) : (x))
 
 #define DEBUGFGLM 0
-#define BLOCKWIED 0
+#define BLOCKWIED 1
 
 #include <flint/fmpz.h>
 #include <flint/nmod_poly.h>
@@ -517,6 +517,43 @@ static inline void sparse_mat_fglm_mult_vec(CF_t *res, sp_matfglm_t *mat,
 
 /*
 
+Matrix multivector product.
+The nvecs vectors of vecs (leading dimension ldv) are multiplied at once,
+results are stored in res (same leading dimension).
+vres (leading dimension ldr) will contain the products of the dense part.
+
+ */
+static inline void sparse_mat_fglm_mult_multivec(CF_t *res, sp_matfglm_t *mat,
+                                                 CF_t *vecs,
+                                                 CF_t *vres,
+                                                 const uint32_t nvecs,
+                                                 const long ldv,
+                                                 const long ldr,
+                                                 const mod_t prime,
+                                                 const uint32_t RED_32,
+                                                 const uint64_t RED_64,
+                                                 md_t *st){
+
+  szmat_t ncols = mat->ncols;
+  szmat_t nrows = mat->nrows;
+  szmat_t ntriv = ncols - nrows;
+  for(uint32_t v = 0; v < nvecs; v++){
+    for(szmat_t i = 0; i < ntriv; i++){
+      res[v*ldv + mat->triv_idx[i]] = vecs[v*ldv + mat->triv_pos[i]];
+    }
+  }
+  matrix_multivector_product(vres, mat->dense_mat, vecs, mat->dst,
+                             ncols, nrows, nvecs, ldv, ldr,
+                             prime, RED_32, RED_64, st);
+  for(uint32_t v = 0; v < nvecs; v++){
+    for(szmat_t i = 0; i < nrows; i++){
+      res[v*ldv + mat->dense_idx[i]] = vres[v*ldr + i];
+    }
+  }
+}
+
+/*
+
 Matrix vector product.
 Result is stored in res.
 vres will contain the product of the dense part.
@@ -692,76 +729,6 @@ static inline void generate_sequence(sp_matfglm_t *matrix, fglm_data_t * data,
 }
 #endif
 
-static void generate_matrix_sequence(sp_matfglm_t *matxn, fglm_data_t *data,
-                                     szmat_t block_size, long dimquot,
-                                     nvars_t* squvars,
-                                     nvars_t* linvars,
-                                     long nvars,
-                                     mod_t prime,
-                                     md_t *st){
-  uint32_t RED_32 = ((uint64_t)2<<31) % prime;
-  uint32_t RED_64 = ((uint64_t)1<<63) % prime;
-  RED_64 = (RED_64*2) % prime;
-
-  const uint32_t preinv = 2^(62) / prime;
-
-  const szmat_t ncols = matxn->ncols;
-  const szmat_t nrows = matxn->nrows;
-
-  int BL = 0;
-  if(nvars < 16){
-      BL = 16;
-  }
-  else{
-      BL = 32;
-  }
-
-  /* allocates random matrix */
-  CF_t *Rmat ALIGNED32;
-  if(posix_memalign((void **)&Rmat, 32, BL*ncols*sizeof(CF_t))){
-    fprintf(stderr, "posix_memalign failed\n");
-    exit(1);
-  }
-  memset(Rmat, 0, (ncols)*sizeof(CF_t));
-  for(szmat_t i = 0; i < BL*ncols; i++){
-    Rmat[i] = 0;
-  }
-  for(szmat_t i = 0; i < matxn->ncols; i++){
-    Rmat[i] = (CF_t)rand() % prime;
-    Rmat[i] += (CF_t)rand() % prime;
-  }
-
-  /* allocates result matrix (matxn * Rmat) */
-  CF_t *res ALIGNED32;
-  if(posix_memalign((void **)&res, 32, BL*ncols*sizeof(CF_t))){
-    fprintf(stderr, "posix_memalign failed\n");
-    exit(1);
-  }
-  memset(res, 0, BL*ncols*sizeof(CF_t));
-
-  /* allocates temporary matrix */
-  CF_t *tres ALIGNED32;
-  if(posix_memalign((void **)&tres, 32, nrows*ncols*sizeof(CF_t))){
-    fprintf(stderr, "posix_memalign failed\n");
-    exit(1);
-  }
-  memset(tres, 0, nrows*ncols*sizeof(CF_t));
-
-  szmat_t nb = 2 * matxn->ncols / BL;
-  for(szmat_t i = 0; i < nb; i++){
-    sparse_matfglm_mul(res, matxn, Rmat,
-                       tres,
-                       BL,
-                       prime, preinv,
-                       RED_32,
-                       RED_64);
-  }
-  free(Rmat);
-  free(res);
-  free(tres);
-
-}
-
 static void generate_sequence_verif(sp_matfglm_t *matrix, fglm_data_t * data,
                                     szmat_t block_size, szmat_t dimquot,
                                     nvars_t* squvars,
@@ -1114,6 +1081,358 @@ static int compute_parametrizations(param_t *param,
   }
 }
 
+#if BLOCKWIED > 0
+/*
+
+  Block Wiedemann variant of the sequence generation (see Hyun, Neiger,
+  Rahkooy, Schost, Block-Krylov techniques in the context of sparse-FGLM
+  algorithms, JSC 2020).
+
+  The block V = [vecinit, v_1, ..., v_{m-1}] is multiplied by the
+  multiplication matrix at once, so that the dense part of the matrix is
+  read only once per step for the m vectors. One records the m x m matrices S_k = U M^k V for a random
+  m x ncols matrix U together with the entries of M^k V which are needed for
+  the parametrizations. This requires about 2*ncols/m steps instead of
+  2*ncols.
+
+  A minimal right generator P of (S_k) is obtained from an approximant
+  basis, its determinant is the eliminating polynomial. For a projection u,
+  u (xI - M)^{-1} V P is a polynomial row vector from which one deduces
+  u (xI - M)^{-1} vecinit, hence the parametrizations.
+
+ */
+
+#define BLOCKWIED_MINDIM 4
+#define BLOCKWIED_MAXDIM 16
+/* below, the scalar sequence is used */
+#define BLOCKWIED_MINCOLS 256
+
+/* returns the block dimension to use, 0 when the scalar sequence has to be
+ * used */
+static inline long block_wiedemann_dim(sp_matfglm_t *matrix,
+                                       nvars_t nvars, md_t *st){
+  long m = st->nthrds;
+  if(m < BLOCKWIED_MINDIM){
+    m = BLOCKWIED_MINDIM;
+  }
+  if(m > BLOCKWIED_MAXDIM){
+    m = BLOCKWIED_MAXDIM;
+  }
+  if(matrix->ncols < BLOCKWIED_MINCOLS || matrix->ncols <= (szmat_t)nvars){
+    return 0;
+  }
+  return m;
+}
+
+/* scalar products modulo prime of the rows of U by the columns of V,
+ * both being stored contiguously with leading dimension ld */
+static inline void block_project(CF_t *S, const CF_t *U, const CF_t *V,
+                                 const long m, const szmat_t ncols,
+                                 const long ld, const mod_t prime){
+  for(long i = 0; i < m; i++){
+    for(long j = 0; j < m; j++){
+      const CF_t *u = U + i * ld;
+      const CF_t *v = V + j * ld;
+      uint64_t acc = 0;
+      szmat_t k = 0;
+      /* prime < 2^31, four products fit in 64 bits */
+      for(; k + 4 <= ncols; k += 4){
+        acc += (uint64_t)u[k] * v[k] + (uint64_t)u[k+1] * v[k+1];
+        acc %= prime;
+        acc += (uint64_t)u[k+2] * v[k+2] + (uint64_t)u[k+3] * v[k+3];
+        acc %= prime;
+      }
+      for(; k < ncols; k++){
+        acc += (uint64_t)u[k] * v[k];
+        acc %= prime;
+      }
+      S[i * m + j] = acc;
+    }
+  }
+}
+
+/*
+
+  seq is filled with the len matrices S_k = U M^k V (m x m, row-major) and
+  proj with the len matrices made of the first nproj entries of the columns
+  of M^k V (nproj x m, row-major).
+
+ */
+static void generate_block_sequence(sp_matfglm_t *matrix, CF_t *vecinit,
+                                    CF_t *seq, CF_t *proj,
+                                    const long m, const long len,
+                                    const long nproj, const mod_t prime,
+                                    md_t *st){
+  uint32_t RED_32 = ((uint64_t)2<<31) % prime;
+  uint32_t RED_64 = ((uint64_t)1<<63) % prime;
+  RED_64 = (RED_64*2) % prime;
+
+  const szmat_t ncols = matrix->ncols;
+  const szmat_t nrows = matrix->nrows;
+  /* keeps columns aligned */
+  const long ld = ((ncols + 7) / 8) * 8;
+  const long ldr = ((nrows + 7) / 8) * 8;
+
+  CF_t *U ALIGNED32;
+  CF_t *V ALIGNED32;
+  CF_t *W ALIGNED32;
+  CF_t *vres ALIGNED32;
+  if(posix_memalign((void **)&U, 32, m*ld*sizeof(CF_t))
+     || posix_memalign((void **)&V, 32, m*ld*sizeof(CF_t))
+     || posix_memalign((void **)&W, 32, m*ld*sizeof(CF_t))
+     || posix_memalign((void **)&vres, 32, m*ldr*sizeof(CF_t))){
+    fprintf(stderr, "posix_memalign failed\n");
+    exit(1);
+  }
+  memset(U, 0, m*ld*sizeof(CF_t));
+  memset(V, 0, m*ld*sizeof(CF_t));
+  memset(W, 0, m*ld*sizeof(CF_t));
+  memset(vres, 0, m*ldr*sizeof(CF_t));
+
+  for(szmat_t i = 0; i < ncols; i++){
+    V[i] = vecinit[i];
+  }
+  for(long j = 1; j < m; j++){
+    for(szmat_t i = 0; i < ncols; i++){
+      V[j*ld + i] = (CF_t)rand() % prime;
+    }
+  }
+  for(long j = 0; j < m; j++){
+    for(szmat_t i = 0; i < ncols; i++){
+      U[j*ld + i] = (CF_t)rand() % prime;
+    }
+  }
+
+  for(long k = 0; k < len; k++){
+    for(long r = 0; r < nproj; r++){
+      for(long j = 0; j < m; j++){
+        proj[(k*nproj + r)*m + j] = V[j*ld + r];
+      }
+    }
+    block_project(seq + k*m*m, U, V, m, ncols, ld, prime);
+    if(k == len - 1){
+      break;
+    }
+    sparse_mat_fglm_mult_multivec(W, matrix, V, vres, m, ld, ldr,
+                                  prime, RED_32, RED_64, st);
+    CF_t *tmp = V;
+    V = W;
+    W = tmp;
+  }
+
+  free(U);
+  free(V);
+  free(W);
+  free(vres);
+}
+
+/*
+
+  Computes a minimal right generator P of the sequence seq of len matrices
+  of size m x m through a left approximant basis of [S^T ; -I] where
+  S = sum_k S_k x^k. Rows of the basis whose pivot lies in the first block
+  give, once reversed, the transpose of P.
+
+  Returns 0 when no such generator is found.
+
+ */
+static int block_generator(nmod_poly_mat_t P, slong *degmax,
+                           const CF_t *seq, const long m, const long len,
+                           const mod_t prime){
+  nmod_poly_mat_t pmat, appbas;
+  nmod_poly_mat_init(pmat, 2*m, m, prime);
+  nmod_poly_mat_init(appbas, 2*m, 2*m, prime);
+  slong *shift = calloc(2*m, sizeof(slong));
+  for(long i = 0; i < m; i++){
+    for(long j = 0; j < m; j++){
+      nmod_poly_struct *e = nmod_poly_mat_entry(pmat, i, j);
+      for(long k = len - 1; k >= 0; k--){
+        nmod_poly_set_coeff_ui(e, k, seq[k*m*m + j*m + i]);
+      }
+    }
+    nmod_poly_set_coeff_ui(nmod_poly_mat_entry(pmat, m + i, i), 0, prime - 1);
+    shift[m + i] = 1;
+  }
+
+  nmod_poly_mat_pmbasis(appbas, shift, pmat, len);
+
+  int nsel = 0;
+  *degmax = 0;
+  for(long i = 0; i < 2*m && nsel <= m; i++){
+    /* pivot index: rightmost entry reaching the shifted row degree */
+    long piv = -1;
+    for(long j = 2*m - 1; j >= 0; j--){
+      slong d = nmod_poly_degree(nmod_poly_mat_entry(appbas, i, j));
+      if(d >= 0 && d + (j >= m) == shift[i]){
+        piv = j;
+        break;
+      }
+    }
+    if(piv < 0 || piv >= m){
+      continue;
+    }
+    if(nsel < m){
+      for(long j = 0; j < m; j++){
+        nmod_poly_reverse(nmod_poly_mat_entry(P, j, nsel),
+                          nmod_poly_mat_entry(appbas, i, j), shift[i] + 1);
+      }
+      if(shift[i] > *degmax){
+        *degmax = shift[i];
+      }
+    }
+    nsel++;
+  }
+
+  free(shift);
+  nmod_poly_mat_clear(pmat);
+  nmod_poly_mat_clear(appbas);
+  return nsel == m;
+}
+
+/*
+
+  Parametrization through the block Wiedemann algorithm.
+
+  Returns 1 on success. Returns 0 when the matrix is not cyclic or when the
+  parametrization cannot be recovered with this approach (non square-free
+  eliminating polynomial, unlucky projections), the scalar sequence has
+  then to be used.
+
+ */
+static int block_fglm_param(param_t *param,
+                            fglm_data_t *data,
+                            fglm_bms_data_t *data_bms,
+                            sp_matfglm_t *matrix,
+                            const long m,
+                            szmat_t nlins,
+                            nvars_t *linvars,
+                            uint32_t *lineqs,
+                            nvars_t nvars,
+                            const mod_t prime,
+                            long *dim,
+                            md_t *st,
+                            int info_level){
+  const szmat_t dimquot = matrix->ncols;
+  const long nproj = nvars + 1;
+  const long len = 2 * ((dimquot + m - 1) / m) + 2;
+
+  CF_t *seq = malloc(len*m*m*sizeof(CF_t));
+  CF_t *proj = malloc(len*nproj*m*sizeof(CF_t));
+  generate_block_sequence(matrix, data->vecinit, seq, proj, m, len, nproj,
+                          prime, st);
+
+  int ok = 0;
+  slong K = 0;
+  nmod_poly_mat_t P, X, B;
+  nmod_poly_t f, den, a0, inv0, ar, N, tau, tmp;
+  nmod_poly_mat_init(P, m, m, prime);
+  nmod_poly_mat_init(X, m, 1, prime);
+  nmod_poly_mat_init(B, m, 1, prime);
+  nmod_poly_init(f, prime);
+  nmod_poly_init(den, prime);
+  nmod_poly_init(a0, prime);
+  nmod_poly_init(inv0, prime);
+  nmod_poly_init(ar, prime);
+  nmod_poly_init(N, prime);
+  nmod_poly_init(tau, prime);
+  nmod_poly_init(tmp, prime);
+
+  if(block_generator(P, &K, seq, m, len, prime) == 0 || K >= len){
+    goto clean;
+  }
+
+  nmod_poly_mat_det(f, P);
+  if(nmod_poly_degree(f) != (slong)dimquot){
+    goto clean;
+  }
+  nmod_poly_make_monic(f, f);
+  if(!nmod_poly_is_squarefree(f)){
+    goto clean;
+  }
+
+  /* P X = den e_1, so that u (xI - M)^{-1} vecinit = (u (xI - M)^{-1} V P) X / den */
+  nmod_poly_set_coeff_ui(nmod_poly_mat_entry(B, 0, 0), 0, 1);
+  if(nmod_poly_mat_solve(X, den, P, B) == 0){
+    goto clean;
+  }
+
+  /* projection r: ar = numerator of sum_k (M^k vecinit)[r] x^{-k-1} times f */
+  for(nvars_t nc = -1; nc < nvars - 1; nc++){
+    long r = 0;
+    if(nc >= 0){
+      if(linvars[nvars - 2 - nc] != 0){
+        continue;
+      }
+      /* same coordinates as in compute_parametrizations */
+      long dec = 0;
+      for(nvars_t i = 0; i < nc; i++){
+        dec += (linvars[nvars - 2 - i] != 0);
+      }
+      r = nc + 2 - dec;
+    }
+    nmod_poly_zero(ar);
+    for(long c = 0; c < m; c++){
+      nmod_poly_zero(N);
+      for(long j = 0; j < m; j++){
+        nmod_poly_zero(tau);
+        for(slong k = 0; k < K; k++){
+          nmod_poly_set_coeff_ui(tau, K - 1 - k, proj[(k*nproj + r)*m + j]);
+        }
+        nmod_poly_mul(tmp, tau, nmod_poly_mat_entry(P, j, c));
+        nmod_poly_add(N, N, tmp);
+      }
+      nmod_poly_shift_right(N, N, K);
+      nmod_poly_mul(tmp, N, nmod_poly_mat_entry(X, c, 0));
+      nmod_poly_add(ar, ar, tmp);
+    }
+    nmod_poly_mul(ar, ar, f);
+    nmod_poly_div(ar, ar, den);
+
+    if(nc < 0){
+      nmod_poly_set(a0, ar);
+      if(nmod_poly_invmod(inv0, a0, f) == 0){
+        goto clean;
+      }
+      continue;
+    }
+    nmod_poly_mulmod(ar, ar, inv0, f);
+    nmod_poly_neg(param->coords[nvars - 2 - nc], ar);
+  }
+
+  nmod_poly_set(data_bms->BMS->V1, f);
+  *dim = make_square_free_elim_poly(param, data_bms, dimquot, info_level);
+
+  nmod_poly_one(param->denom);
+  for(nvars_t nc = 0; nc < nvars - 1; nc++){
+    if(linvars[nvars - 2 - nc] != 0){
+      nmod_poly_fit_length(param->coords[nvars-2-nc], param->elim->length-1);
+      param->coords[nvars-2-nc]->length = param->elim->length-1;
+      for(deg_t i = 0; i < param->elim->length-1 ; i++){
+        param->coords[nvars-2-nc]->coeffs[i] = 0;
+      }
+    }
+  }
+  set_param_linear_vars(param, nlins, linvars, lineqs, nvars);
+  ok = 1;
+
+clean:
+  free(seq);
+  free(proj);
+  nmod_poly_mat_clear(P);
+  nmod_poly_mat_clear(X);
+  nmod_poly_mat_clear(B);
+  nmod_poly_clear(f);
+  nmod_poly_clear(den);
+  nmod_poly_clear(a0);
+  nmod_poly_clear(inv0);
+  nmod_poly_clear(ar);
+  nmod_poly_clear(N);
+  nmod_poly_clear(tau);
+  nmod_poly_clear(tmp);
+  return ok;
+}
+#endif
+
 static inline int invert_table_polynomial (param_t *param,
 					   fglm_data_t *data,
 					   fglm_bms_data_t *data_bms,
@@ -1559,16 +1878,42 @@ param_t *nmod_fglm_compute_trace_data(sp_matfglm_t *matrix, mod_t prime,
   double cst_fglm = cputime();
 
 #if BLOCKWIED > 0
-  fprintf(stderr, "Starts computation of matrix sequence\n");
-  double st0 = omp_get_wtime();
-  generate_matrix_sequence(matrix, *bdata, block_size, dimquot,
-                           squvars, linvars, nvars, prime, st);
-  double et0 = omp_get_wtime() - st0;
-  fprintf(stderr, "Matrix sequence computed\n");
-  fprintf(stderr, "Elapsed time : %.2f\n", et0);
-  fprintf(stderr, "Implementation to be completed\n");
-  exit(1);
-#else
+  const long bl = block_wiedemann_dim(matrix, nvars, st);
+  if(bl > 0){
+    if (info_level > 1) {
+      fprintf(stdout,
+              "block sequence + param. (block size %2ld)             ", bl);
+      fflush(stdout);
+    }
+    *bdata_bms = allocate_fglm_bms_data(dimquot, prime);
+    long dim = 0;
+    if(block_fglm_param(param, *bdata, *bdata_bms, matrix, bl,
+                        nlins, linvars, lineqs, nvars, prime, &dim,
+                        st, info_level)){
+      if(info_level > 1){
+        double rt_fglm = realtime()-st_fglm;
+        double crt_fglm = cputime()-cst_fglm;
+        fprintf(stdout, "%15.2f | %-13.2f\n",rt_fglm,crt_fglm);
+        fprintf(stdout,
+                "-------------------------------------------------\
+-----------------------------------------------------\n");
+      }
+      st->fglm_rtime = realtime() - st->fglm_rtime;
+      st->fglm_ctime = cputime() - st->fglm_ctime;
+      print_fglm_data (stdout, st, matrix, param);
+      /* further primes use the block sequence as well */
+      (*bdata_bms)->block_dim = bl;
+      return param;
+    }
+    /* falls back to the scalar sequence */
+    if(info_level > 1){
+      fprintf(stdout, "%15s | %-13s\n", "failed", "");
+    }
+    free_fglm_bms_data(*bdata_bms);
+    st_fglm = realtime();
+    cst_fglm = cputime();
+  }
+#endif
   if (info_level > 1) {
     fprintf(stdout,
 	    "scalar sequence                                     ");
@@ -1576,7 +1921,6 @@ param_t *nmod_fglm_compute_trace_data(sp_matfglm_t *matrix, mod_t prime,
   }
   generate_sequence_verif(matrix, *bdata, block_size, dimquot,
                           squvars, linvars, nvars, prime, st);
-#endif
 
   if(info_level > 1){
     double nops = 2 * (matrix->nrows/ 1000.0) * (matrix->ncols / 1000.0)  * (matrix->ncols / 1000.0);
@@ -1769,6 +2113,28 @@ int nmod_fglm_compute_apply_trace_data(sp_matfglm_t *matrix,
 
   //////////////////////////////////////////////////////////////////
 
+#if BLOCKWIED > 0
+  /* the first prime decided between block and scalar sequence */
+  const long bl = data_bms->block_dim;
+  if(bl > 0){
+    fglm_bms_data_set_prime(data_bms, prime);
+    long dim = 0;
+    if(block_fglm_param(param, data_fglm, data_bms, matrix, bl,
+                        nlins, linvars, lineqs, nvars, prime, &dim,
+                        st, info_level)){
+      if(info_level){
+        fprintf(stderr, "Time spent in block Wiedemann (elapsed): %.2f sec\n",
+                realtime()-st_fglm);
+      }
+      if(param->elim->length-1 != deg_init){
+        fprintf(stderr, "Warning: Degree of elim poly = %ld\n", param->elim->length-1);
+        return 1;
+      }
+      return 0;
+    }
+    st_fglm = realtime();
+  }
+#endif
   /* generate_sequence(matrix, data_fglm, block_size, dimquot, prime, st); */
   generate_sequence_verif(matrix, data_fglm, block_size, dimquot,
                           squvars, linvars, nvars, prime, st);
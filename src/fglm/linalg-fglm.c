@@ -35,6 +35,8 @@
 #define AVX2ADD_64(A,B) _mm256_add_epi64(A,B)
 #define AVX2MUL(A,B) _mm256_mul_epu32(A,B)
 #define AVX2SRLI_64(A,i) _mm256_srli_epi64(A,i)
+#elif defined __aarch64__
+#include <arm_neon.h>
 #endif
 
 /* Matrix-vector product in GF(p), with p on 32 bits. */
@@ -777,3 +779,248 @@ static inline void _8mul_matrix_vector_product(uint32_t* vec_res,
     }
 }
 #endif
+
+/**
+
+Dense matrix times multivector.
+
+For v < nvecs, vec_res + v*ldr receives the product of mat (nrows x ncols,
+dst[j] trailing zeros in row j) by the vector vecs + v*ldv.
+
+Columns are handled by chunks of MVCHUNK: a chunk of a row is read once from
+memory and multiplied by the corresponding chunks of all vectors, which stay
+in cache while rows are processed. Hence the matrix is streamed once for all
+vectors instead of once per vector. Products are accumulated on 64 bits, low
+and high 32-bit parts being summed separately as in
+_8mul_matrix_vector_product; reduction modulo PRIME is done once per entry
+of the result. Rows are shared out among threads.
+
+**/
+
+#define MVCHUNK 4096
+#define MVBLOCK 4
+#define MVROWS 16
+
+/* lo + 2^32 * hi mod PRIME */
+static inline uint64_t _mv_reduce(const uint64_t lo, const uint64_t hi,
+                                  const uint32_t PRIME, const uint32_t RED_32,
+                                  const uint32_t RED_64){
+  uint64_t r = lo % PRIME;
+  r += ((hi >> 32) * RED_64) % PRIME;
+  r += ((hi & ((uint64_t)0xFFFFFFFF)) * RED_32) % PRIME;
+  return r % PRIME;
+}
+
+/* lo[v] + 2^32 * hi[v] is increased by <row, vp[v]> on len entries for
+ * v < MVBLOCK */
+static inline void _mvblock_dot_product(uint64_t *lo, uint64_t *hi,
+                                        const uint32_t *row,
+                                        const uint32_t **vp,
+                                        const long len){
+  const uint32_t *v0 = vp[0], *v1 = vp[1], *v2 = vp[2], *v3 = vp[3];
+  long i = 0;
+#if defined HAVE_AVX512_F
+  /* 64 columns: 8 products of 62 bits at most per 64-bit lane */
+  const __m512i mask = _mm512_set1_epi64(MONE32);
+  __m512i l0 = _mm512_setzero_si512(), h0 = _mm512_setzero_si512();
+  __m512i l1 = _mm512_setzero_si512(), h1 = _mm512_setzero_si512();
+  __m512i l2 = _mm512_setzero_si512(), h2 = _mm512_setzero_si512();
+  __m512i l3 = _mm512_setzero_si512(), h3 = _mm512_setzero_si512();
+  for(; i + 64 <= len; i += 64){
+    __m512i r0 = _mm512_setzero_si512(), r1 = _mm512_setzero_si512();
+    __m512i r2 = _mm512_setzero_si512(), r3 = _mm512_setzero_si512();
+    for(int k = 0; k < 64; k += 16){
+      const __m512i m = _mm512_loadu_si512((__m512i*)(row + i + k));
+      const __m512i mh = _mm512_srli_epi64(m, 32);
+      __m512i x;
+#define MV512(r, v)                                                     \
+      x = _mm512_loadu_si512((__m512i*)((v) + i + k));                  \
+      r = _mm512_add_epi64(r, _mm512_mul_epu32(m, x));                  \
+      r = _mm512_add_epi64(r, _mm512_mul_epu32(mh, _mm512_srli_epi64(x, 32)));
+      MV512(r0, v0);
+      MV512(r1, v1);
+      MV512(r2, v2);
+      MV512(r3, v3);
+#undef MV512
+    }
+    l0 = _mm512_add_epi64(l0, _mm512_and_si512(r0, mask));
+    h0 = _mm512_add_epi64(h0, _mm512_srli_epi64(r0, 32));
+    l1 = _mm512_add_epi64(l1, _mm512_and_si512(r1, mask));
+    h1 = _mm512_add_epi64(h1, _mm512_srli_epi64(r1, 32));
+    l2 = _mm512_add_epi64(l2, _mm512_and_si512(r2, mask));
+    h2 = _mm512_add_epi64(h2, _mm512_srli_epi64(r2, 32));
+    l3 = _mm512_add_epi64(l3, _mm512_and_si512(r3, mask));
+    h3 = _mm512_add_epi64(h3, _mm512_srli_epi64(r3, 32));
+  }
+  lo[0] += _mm512_reduce_add_epi64(l0);
+  hi[0] += _mm512_reduce_add_epi64(h0);
+  lo[1] += _mm512_reduce_add_epi64(l1);
+  hi[1] += _mm512_reduce_add_epi64(h1);
+  lo[2] += _mm512_reduce_add_epi64(l2);
+  hi[2] += _mm512_reduce_add_epi64(h2);
+  lo[3] += _mm512_reduce_add_epi64(l3);
+  hi[3] += _mm512_reduce_add_epi64(h3);
+#elif defined HAVE_AVX2
+  /* 32 columns: 8 products of 62 bits at most per 64-bit lane */
+  const __m256i mask = AVX2SET1_64(MONE32);
+  __m256i l0 = AVX2SETZERO(), h0 = AVX2SETZERO();
+  __m256i l1 = AVX2SETZERO(), h1 = AVX2SETZERO();
+  __m256i l2 = AVX2SETZERO(), h2 = AVX2SETZERO();
+  __m256i l3 = AVX2SETZERO(), h3 = AVX2SETZERO();
+  for(; i + 32 <= len; i += 32){
+    __m256i r0 = AVX2SETZERO(), r1 = AVX2SETZERO();
+    __m256i r2 = AVX2SETZERO(), r3 = AVX2SETZERO();
+    for(int k = 0; k < 32; k += 8){
+      const __m256i m = AVX2LOADU(row + i + k);
+      const __m256i mh = AVX2SRLI_64(m, 32);
+      __m256i x;
+#define MV256(r, v)                                                     \
+      x = AVX2LOADU((v) + i + k);                                       \
+      r = AVX2ADD_64(r, AVX2MUL(m, x));                                 \
+      r = AVX2ADD_64(r, AVX2MUL(mh, AVX2SRLI_64(x, 32)));
+      MV256(r0, v0);
+      MV256(r1, v1);
+      MV256(r2, v2);
+      MV256(r3, v3);
+#undef MV256
+    }
+    l0 = AVX2ADD_64(l0, AVX2AND_(r0, mask));
+    h0 = AVX2ADD_64(h0, AVX2SRLI_64(r0, 32));
+    l1 = AVX2ADD_64(l1, AVX2AND_(r1, mask));
+    h1 = AVX2ADD_64(h1, AVX2SRLI_64(r1, 32));
+    l2 = AVX2ADD_64(l2, AVX2AND_(r2, mask));
+    h2 = AVX2ADD_64(h2, AVX2SRLI_64(r2, 32));
+    l3 = AVX2ADD_64(l3, AVX2AND_(r3, mask));
+    h3 = AVX2ADD_64(h3, AVX2SRLI_64(r3, 32));
+  }
+  uint64_t t[4] ALIGNED32;
+#define MVSUM256(acc, a)                        \
+  AVX2STORE(t, a);                              \
+  acc += t[0] + t[1] + t[2] + t[3];
+  MVSUM256(lo[0], l0);
+  MVSUM256(hi[0], h0);
+  MVSUM256(lo[1], l1);
+  MVSUM256(hi[1], h1);
+  MVSUM256(lo[2], l2);
+  MVSUM256(hi[2], h2);
+  MVSUM256(lo[3], l3);
+  MVSUM256(hi[3], h3);
+#undef MVSUM256
+#elif defined __aarch64__
+  /* 16 columns: 8 products of 62 bits at most per 64-bit lane */
+  const uint64x2_t mask = vdupq_n_u64(MONE32);
+  uint64x2_t l0 = vdupq_n_u64(0), h0 = vdupq_n_u64(0);
+  uint64x2_t l1 = vdupq_n_u64(0), h1 = vdupq_n_u64(0);
+  uint64x2_t l2 = vdupq_n_u64(0), h2 = vdupq_n_u64(0);
+  uint64x2_t l3 = vdupq_n_u64(0), h3 = vdupq_n_u64(0);
+  for(; i + 16 <= len; i += 16){
+    uint64x2_t r0 = vdupq_n_u64(0), r1 = vdupq_n_u64(0);
+    uint64x2_t r2 = vdupq_n_u64(0), r3 = vdupq_n_u64(0);
+    for(int k = 0; k < 16; k += 4){
+      const uint32x4_t m = vld1q_u32(row + i + k);
+      const uint32x2_t ml = vget_low_u32(m);
+      uint32x4_t x;
+#define MVNEON(r, v)                                    \
+      x = vld1q_u32((v) + i + k);                       \
+      r = vmlal_u32(r, ml, vget_low_u32(x));            \
+      r = vmlal_high_u32(r, m, x);
+      MVNEON(r0, v0);
+      MVNEON(r1, v1);
+      MVNEON(r2, v2);
+      MVNEON(r3, v3);
+#undef MVNEON
+    }
+    l0 = vaddq_u64(l0, vandq_u64(r0, mask));
+    h0 = vaddq_u64(h0, vshrq_n_u64(r0, 32));
+    l1 = vaddq_u64(l1, vandq_u64(r1, mask));
+    h1 = vaddq_u64(h1, vshrq_n_u64(r1, 32));
+    l2 = vaddq_u64(l2, vandq_u64(r2, mask));
+    h2 = vaddq_u64(h2, vshrq_n_u64(r2, 32));
+    l3 = vaddq_u64(l3, vandq_u64(r3, mask));
+    h3 = vaddq_u64(h3, vshrq_n_u64(r3, 32));
+  }
+  lo[0] += vaddvq_u64(l0);
+  hi[0] += vaddvq_u64(h0);
+  lo[1] += vaddvq_u64(l1);
+  hi[1] += vaddvq_u64(h1);
+  lo[2] += vaddvq_u64(l2);
+  hi[2] += vaddvq_u64(h2);
+  lo[3] += vaddvq_u64(l3);
+  hi[3] += vaddvq_u64(h3);
+#endif
+  /* remaining columns */
+  for(; i < len; i++){
+    const uint64_t m = row[i];
+    uint64_t p;
+    p = m * v0[i];
+    lo[0] += p & ((uint64_t)0xFFFFFFFF);
+    hi[0] += p >> 32;
+    p = m * v1[i];
+    lo[1] += p & ((uint64_t)0xFFFFFFFF);
+    hi[1] += p >> 32;
+    p = m * v2[i];
+    lo[2] += p & ((uint64_t)0xFFFFFFFF);
+    hi[2] += p >> 32;
+    p = m * v3[i];
+    lo[3] += p & ((uint64_t)0xFFFFFFFF);
+    hi[3] += p >> 32;
+  }
+}
+
+static inline void matrix_multivector_product(uint32_t *vec_res,
+                                              const uint32_t *mat,
+                                              const uint32_t *vecs,
+                                              const uint32_t *dst,
+                                              const uint32_t ncols,
+                                              const uint32_t nrows,
+                                              const uint32_t nvecs,
+                                              const long ldv,
+                                              const long ldr,
+                                              const uint32_t PRIME,
+                                              const uint32_t RED_32,
+                                              const uint32_t RED_64,
+                                              md_t *st){
+  const long nrb = (nrows + MVROWS - 1) / MVROWS;
+  /* vectors are handled by blocks of MVBLOCK */
+  const uint32_t nvb = ((nvecs + MVBLOCK - 1) / MVBLOCK) * MVBLOCK;
+#pragma omp parallel num_threads(st->nthrds)
+  {
+    uint64_t *lo = (uint64_t *)malloc(2 * MVROWS * nvb * sizeof(uint64_t));
+    uint64_t *hi = lo + MVROWS * nvb;
+    const uint32_t *vp[MVBLOCK];
+    long rb;
+#pragma omp for schedule(dynamic)
+    for(rb = 0; rb < nrb; rb++){
+      const long jstart = rb * MVROWS;
+      const long jend = (jstart + MVROWS < nrows) ? jstart + MVROWS : nrows;
+      memset(lo, 0, 2 * MVROWS * nvb * sizeof(uint64_t));
+      for(long c = 0; c < ncols; c += MVCHUNK){
+        for(long j = jstart; j < jend; j++){
+          const long rlen = ncols - dst[j];
+          const long e = (c + MVCHUNK < rlen) ? c + MVCHUNK : rlen;
+          if(e <= c){
+            continue;
+          }
+          const uint32_t *r = mat + j * (long)ncols + c;
+          const long off = (j - jstart) * nvb;
+          for(uint32_t v0 = 0; v0 < nvecs; v0 += MVBLOCK){
+            /* missing vectors of the last block are replaced by the first
+             * one of the block, results are not used */
+            for(int v = 0; v < MVBLOCK; v++){
+              vp[v] = vecs + (v0 + v < nvecs ? v0 + v : v0) * ldv + c;
+            }
+            _mvblock_dot_product(lo + off + v0, hi + off + v0, r, vp, e - c);
+          }
+        }
+      }
+      for(long j = jstart; j < jend; j++){
+        const long off = (j - jstart) * nvb;
+        for(uint32_t v = 0; v < nvecs; v++){
+          vec_res[v * ldr + j] = _mv_reduce(lo[off + v], hi[off + v],
+                                            PRIME, RED_32, RED_64);
+        }
+      }
+    }
+    free(lo);
+  }
+}
@@ -251,6 +251,7 @@ static inline void duplicate_data_mthread_trace(int nthreads,
   for(int i = 1; i < nthreads; i++){
     bdata_fglm[i] = allocate_fglm_data(len0, dquot, (st->nvars));
     bdata_bms[i] = allocate_fglm_bms_data(dquot, 65521);
+    bdata_bms[i]->block_dim = bdata_bms[0]->block_dim;
     nmod_params[i] = allocate_fglm_param(nmod_params[0]->charac, (st->nvars));
     nmod_poly_set(nmod_params[i]->elim, nmod_params[0]->elim);
     nmod_poly_set(nmod_params[i]->denom, nmod_params[0]->denom);
@@ -370,6 +371,7 @@ static inline void duplicate_data_mthread(int nthreads,
   for(int i = 1; i < nthreads; i++){
     bdata_fglm[i] = allocate_fglm_data(len_xn, dquot, nv);
     bdata_bms[i] = allocate_fglm_bms_data(dquot, 65521);
+    bdata_bms[i]->block_dim = bdata_bms[0]->block_dim;
     nmod_params[i] = allocate_fglm_param(nmod_params[0]->charac, nv);
     nmod_poly_set(nmod_params[i]->elim, nmod_params[0]->elim);
     nmod_poly_set(nmod_params[i]->denom, nmod_params[0]->denom);
@@ -18,6 +18,10 @@
  * Christian Eder
  * Mohab Safey El Din */
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
 static inline void store_exponent(const char *term, data_gens_ff_t *gens, int32_t pos)
 {
     len_t i, j, k;
@@ -154,6 +158,168 @@ static inline int32_t display_monomial_full(FILE *file, const int nv,
   return b;
 }
 
+/* growable character buffer used to format output in memory: large bases
+ * and parametrizations are formatted in parallel, chunk by chunk, and each
+ * chunk is written with a single fwrite */
+typedef struct{
+  char *s;
+  size_t len;
+  size_t alloc;
+} obuf_t;
+
+static inline void obuf_init(obuf_t *b, size_t alloc){
+  b->alloc = alloc > 0 ? alloc : 64;
+  b->len = 0;
+  b->s = (char *)malloc(b->alloc * sizeof(char));
+  if(b->s == NULL){
+    fprintf(stderr, "Unable to allocate output buffer\n");
+    exit(1);
+  }
+}
+
+static inline void obuf_clear(obuf_t *b){
+  free(b->s);
+  b->s = NULL;
+  b->len = b->alloc = 0;
+}
+
+/* ensures that n more characters fit into b */
+static inline void obuf_reserve(obuf_t *b, size_t n){
+  if(b->len + n > b->alloc){
+    while(b->len + n > b->alloc){
+      b->alloc *= 2;
+    }
+    b->s = (char *)realloc(b->s, b->alloc * sizeof(char));
+    if(b->s == NULL){
+      fprintf(stderr, "Unable to allocate output buffer\n");
+      exit(1);
+    }
+  }
+}
+
+static inline void obuf_putc(obuf_t *b, const char c){
+  obuf_reserve(b, 1);
+  b->s[b->len++] = c;
+}
+
+static inline void obuf_puts(obuf_t *b, const char *str){
+  const size_t n = strlen(str);
+  obuf_reserve(b, n);
+  memcpy(b->s + b->len, str, n);
+  b->len += n;
+}
+
+/* decimal representation of v, same as fprintf "%u" / "%lu" */
+static inline void obuf_put_u(obuf_t *b, uint64_t v){
+  char tmp[20];
+  int n = 0;
+  do{
+    tmp[n++] = (char)('0' + v % 10);
+    v /= 10;
+  }while(v != 0);
+  obuf_reserve(b, n);
+  while(n > 0){
+    b->s[b->len++] = tmp[--n];
+  }
+}
+
+/* decimal representation of z, same as mpz_out_str(file, 10, z) */
+static inline void obuf_put_mpz(obuf_t *b, const mpz_t z){
+  obuf_reserve(b, mpz_sizeinbase(z, 10) + 2);
+  mpz_get_str(b->s + b->len, 10, z);
+  b->len += strlen(b->s + b->len);
+}
+
+static inline void obuf_write(obuf_t *b, FILE *file){
+  if(b->len > 0){
+    fwrite(b->s, sizeof(char), b->len, file);
+  }
+  b->len = 0;
+}
+
+/* formats polynomial i of bs (basis ordered by bs->lmps) into b, including
+ * its trailing separator, the output is the one print_msolve_polynomials_ff
+ * always had */
+static void format_msolve_polynomial_ff(
+        obuf_t *b,
+        const bi_t i,
+        const bi_t to,
+        const bs_t * const bs,
+        const ht_t * const ht,
+        const md_t *st,
+        char **vnames,
+        const int *evi,
+        const int lead_ideal_only
+        )
+{
+    len_t j, k;
+
+    const len_t nv  = ht->nv;
+    const bi_t idx  = bs->lmps[i];
+
+    if (lead_ideal_only != 0) {
+        if (bs->hm[idx] == NULL) {
+            obuf_puts(b, "0,\n");
+            return;
+        }
+        const hm_t *hm = bs->hm[idx]+OFFSET;
+        int ctr = 0;
+        for (k = 0; k < nv; ++k) {
+            if (ht->ev[hm[0]][evi[k]] > 0) {
+                if (ctr > 0) {
+                    obuf_putc(b, '*');
+                }
+                obuf_puts(b, vnames[k]);
+                obuf_putc(b, '^');
+                obuf_put_u(b, ht->ev[hm[0]][evi[k]]);
+                ctr++;
+            }
+        }
+    } else {
+        if (bs->hm[idx] == NULL) {
+            obuf_putc(b, '0');
+        } else {
+            const hm_t *hm  = bs->hm[idx]+OFFSET;
+            const len_t len = bs->hm[idx][LENGTH];
+            const len_t cfp = bs->hm[idx][COEFFS];
+            for (j = 0; j < len; ++j) {
+                if (j > 0) {
+                    obuf_putc(b, '+');
+                }
+                switch (st->ff_bits) {
+                case 8:
+                    obuf_put_u(b, bs->cf_8[cfp][j]);
+                    break;
+                case 16:
+                    obuf_put_u(b, bs->cf_16[cfp][j]);
+                    break;
+                case 32:
+                    obuf_put_u(b, bs->cf_32[cfp][j]);
+                    break;
+                case 64:
+                    obuf_put_u(b, bs->cf_64[cfp][j]);
+                    break;
+                default:
+                    exit(1);
+                }
+                for (k = 0; k < nv; ++k) {
+                    if (ht->ev[hm[j]][evi[k]] > 0) {
+                        obuf_putc(b, '*');
+                        obuf_puts(b, vnames[k]);
+                        obuf_putc(b, '^');
+                        obuf_put_u(b, ht->ev[hm[j]][evi[k]]);
+                    }
+                }
+            }
+        }
+    }
+    if (i < to-1) {
+        obuf_puts(b, ",\n");
+    } else {
+        obuf_puts(b, "]:\n");
+    }
+}
+
 static void print_msolve_polynomials_ff(
         FILE *file,
         const bi_t from,
@@ -166,10 +332,7 @@ static void print_msolve_polynomials_ff(
         const int is_nf
         )
 {
-    len_t i, j, k, idx;
-
-    len_t len   = 0;
-    hm_t *hm    = NULL;
+    len_t i, j;
 
     const len_t nv  = ht->nv;
     const len_t ebl = ht->ebl;
@@ -220,94 +383,32 @@ static void print_msolve_polynomials_ff(
         }
     }
 
-    if (lead_ideal_only != 0) {
-        int ctr = 0;
-        fprintf(file, "[");
-        for (i = from; i < to; ++i) {
-            idx = bs->lmps[i];
-            if (bs->hm[idx] == NULL) {
-                fprintf(file, "0,\n");
-            } else {
-                hm  = bs->hm[idx]+OFFSET;
-                len = bs->hm[idx][LENGTH];
-                ctr = 0;
-                k = 0;
-                while (ctr == 0 && k < nv) {
-                    if (ht->ev[hm[0]][evi[k]] > 0) {
-                        fprintf(file, "%s^%u",vnames[k], ht->ev[hm[0]][evi[k]]);
-                        ctr++;
-                    }
-                    k++;
-                }
-                for (;k < nv; ++k) {
-                    if (ht->ev[hm[0]][evi[k]] > 0) {
-                        fprintf(file, "*%s^%u",vnames[k], ht->ev[hm[0]][evi[k]]);
-                    }
-                }
-                if (i < to-1) {
-                    fprintf(file, ",\n");
-                } else {
-                    fprintf(file, "]:\n");
-                }
-            }
+    /* polynomials are formatted in parallel into one buffer each, in
+     * rounds of a few polynomials per thread in order to bound the memory
+     * used, and written sequentially in the order of the basis */
+    const len_t nthrds  = st->nthrds > 0 ? st->nthrds : 1;
+    const len_t nchunk  = 8 * nthrds;
+    obuf_t *bufs = (obuf_t *)malloc((unsigned long)nchunk * sizeof(obuf_t));
+    for (i = 0; i < nchunk; ++i) {
+        obuf_init(bufs+i, 1024);
+    }
+
+    fprintf(file, "[");
+    for (i = from; i < to; i += nchunk) {
+        const len_t nb = to - i < nchunk ? to - i : nchunk;
+#pragma omp parallel for num_threads(nthrds) schedule(dynamic)
+        for (j = 0; j < nb; ++j) {
+            format_msolve_polynomial_ff(bufs+j, i+j, to, bs, ht, st,
+                    vnames, evi, lead_ideal_only);
         }
-    } else {
-        fprintf(file, "[");
-        for (i = from; i < to; ++i) {
-            idx = bs->lmps[i];
-            if (bs->hm[idx] == NULL) {
-                fprintf(file, "0");
-            } else {
-                hm  = bs->hm[idx]+OFFSET;
-                len = bs->hm[idx][LENGTH];
-                switch (st->ff_bits) {
-                case 0 :
-                  fprintf(file, "%u", bs->cf_32[bs->hm[idx][COEFFS]][0]);
-                  break;
-                case 8:
-                  fprintf(file, "%u", bs->cf_8[bs->hm[idx][COEFFS]][0]);
-                  break;
-                case 16:
-                  fprintf(file, "%u", bs->cf_16[bs->hm[idx][COEFFS]][0]);
-                  break;
-                case 32:
-                  fprintf(file, "%u", bs->cf_32[bs->hm[idx][COEFFS]][0]);
-                  break;
-                }
-                for (k = 0; k < nv; ++k) {
-                    if (ht->ev[hm[0]][evi[k]] > 0) {
-                        fprintf(file, "*%s^%u",vnames[k], ht->ev[hm[0]][evi[k]]);
-                    }
-                }
-                for (j = 1; j < len; ++j) {
-		  switch (st->ff_bits) {
-		  case 0:
-		    fprintf(file, "+%u", bs->cf_32[bs->hm[idx][COEFFS]][j]);
-		    break;
-		  case 8:
-		    fprintf(file, "+%u", bs->cf_8[bs->hm[idx][COEFFS]][j]);
-		    break;
-		  case 16:
-		    fprintf(file, "+%u", bs->cf_16[bs->hm[idx][COEFFS]][j]);
-		    break;
-		  case 32:
-		    fprintf(file, "+%u", bs->cf_32[bs->hm[idx][COEFFS]][j]);
-		    break;
-		  }
-		  for (k = 0; k < nv; ++k) {
-		    if (ht->ev[hm[j]][evi[k]] > 0) {
-		      fprintf(file, "*%s^%u",vnames[k], ht->ev[hm[j]][evi[k]]);
-		    }
-		  }
-                }
-	    }
-	    if (i < to-1) {
-	      fprintf(file, ",\n");
-	    } else {
-	      fprintf(file, "]:\n");
-	    }
+        for (j = 0; j < nb; ++j) {
+            obuf_write(bufs+j, file);
         }
     }
+    for (i = 0; i < nchunk; ++i) {
+        obuf_clear(bufs+i);
+    }
+    free(bufs);
     free(evi);
 }
 
@@ -911,10 +1012,239 @@ static int duplicate_vnames(char **vnames, int32_t nvars) {
   return 0;
 }
 
+/* Binary system files, all entries in native byte order:
+ * - header of 8 int64_t: magic, version, nvars, ngens, field characteristic,
+ *   number of terms, size of a GMP limb and size of the variable names,
+ * - variable names, each terminated by '\0',
+ * - lens (int32_t, ngens entries),
+ * - exps (int32_t, nvars entries per term),
+ * - coefficients: over prime fields one int32_t per term, reduced modulo
+ *   the field characteristic when read, over the rationals
+ *   numerator and denominator of each term, each given by its number of
+ *   limbs as int64_t (negative for negative values) followed by its limbs.
+ * Each section is padded with zeros to a multiple of 8 bytes. */
+#define MSOLVE_BIN_MAGIC 0x4e4942564c4f534d /* "MSOLVBIN" */
+#define MSOLVE_BIN_VERSION 1
+#define MSOLVE_BIN_PAD(n) (((n) + 7) & ~((size_t)7))
+
+static inline int is_bin_system_file(const char *fn){
+  int64_t magic = 0;
+  FILE *fh = fopen(fn, "rb");
+  if(fh == NULL){
+    return 0;
+  }
+  int ret = fread(&magic, sizeof(int64_t), 1, fh) == 1
+    && magic == MSOLVE_BIN_MAGIC;
+  fclose(fh);
+  return ret;
+}
+
+static void bin_file_error(const char *fn){
+  fprintf(stderr, "Bad binary file format (%s).\n", fn);
+  exit(1);
+}
+
+/* checks that cnt entries of esz bytes each fit into the sz bytes of the
+ * file starting at off, without overflowing size_t */
+static inline int bin_section_fits(size_t off, size_t cnt, size_t esz,
+                                   size_t sz){
+  return off <= sz && cnt <= (sz - off) / esz;
+}
+
+/* maps the file and copies its sections into gens, coefficients are
+ * imported limb-wise, no text conversion takes place */
+static void get_data_from_bin_file(char *fn, int32_t *nr_vars,
+                                   int32_t *field_char,
+                                   int32_t *nr_gens, data_gens_ff_t *gens){
+  struct stat sb;
+  int fd = open(fn, O_RDONLY);
+  if(fd == -1 || fstat(fd, &sb) == -1 ||
+     (size_t)sb.st_size < 8 * sizeof(int64_t)){
+    bin_file_error(fn);
+  }
+  const size_t sz = (size_t)sb.st_size;
+  char *map = mmap(NULL, sz, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(map == MAP_FAILED){
+    bin_file_error(fn);
+  }
+#ifdef MADV_SEQUENTIAL
+  madvise(map, sz, MADV_SEQUENTIAL);
+#endif
+
+  int64_t head[8];
+  memcpy(head, map, sizeof(head));
+  if(head[1] != MSOLVE_BIN_VERSION || head[2] <= 0 || head[2] > INT32_MAX ||
+     head[3] <= 0 || head[3] > INT32_MAX || head[4] < 0 || head[4] > INT32_MAX ||
+     head[5] <= 0 || head[5] > INT32_MAX || head[6] != sizeof(mp_limb_t) ||
+     head[7] < 0){
+    bin_file_error(fn);
+  }
+  const int32_t nv = (int32_t)head[2];
+  const int32_t ng = (int32_t)head[3];
+  const int64_t nterms = head[5];
+  const size_t namesz = (size_t)head[7];
+  const size_t nexps = (size_t)nterms * (size_t)nv;
+
+  /* all sections up to the coefficients have to lie inside the file before
+   * anything is allocated */
+  size_t off = sizeof(head);
+  const size_t lensoff = off + MSOLVE_BIN_PAD(namesz);
+  const size_t expsoff = lensoff + MSOLVE_BIN_PAD(ng * sizeof(int32_t));
+  if(!bin_section_fits(off, namesz, 1, sz)
+     || !bin_section_fits(lensoff, ng, sizeof(int32_t), sz)
+     || !bin_section_fits(expsoff, nexps, sizeof(int32_t), sz)){
+    bin_file_error(fn);
+  }
+
+  /* variable names */
+  char **vnames = (char **)malloc(nv * sizeof(char *));
+  const char *name = map + off;
+  const char *end = name + namesz;
+  for(int32_t i = 0; i < nv; i++){
+    size_t l = strnlen(name, end - name);
+    if(name + l >= end){
+      bin_file_error(fn);
+    }
+    vnames[i] = (char *)malloc((l + 1) * sizeof(char));
+    memcpy(vnames[i], name, l + 1);
+    name += l + 1;
+  }
+  gens->vnames = vnames;
+  if(duplicate_vnames(vnames, nv) == 1){
+    exit(1);
+  }
+  off += MSOLVE_BIN_PAD(namesz);
+
+  initialize_data_gens(nv, ng, head[4], gens);
+  memcpy(gens->lens, map + off, ng * sizeof(int32_t));
+  off += MSOLVE_BIN_PAD(ng * sizeof(int32_t));
+  int64_t sum = 0;
+  for(int32_t i = 0; i < ng; i++){
+    if(gens->lens[i] < 0){
+      bin_file_error(fn);
+    }
+    sum += gens->lens[i];
+  }
+  if(sum != nterms){
+    bin_file_error(fn);
+  }
+  gens->nterms = nterms;
+
+  gens->exps = (int32_t *)malloc(nexps * sizeof(int32_t));
+  memcpy(gens->exps, map + off, nexps * sizeof(int32_t));
+  off += MSOLVE_BIN_PAD(nexps * sizeof(int32_t));
+
+  /* each rational coefficient has a numerator and a denominator, each
+   * of them stored with at least its limb count */
+  if(gens->field_char ?
+     !bin_section_fits(off, (size_t)nterms, sizeof(int32_t), sz) :
+     !bin_section_fits(off, 2 * (size_t)nterms, sizeof(int64_t), sz)){
+    bin_file_error(fn);
+  }
+  gens->cfs = (int32_t *)malloc(nterms * sizeof(int32_t));
+  if(gens->field_char){
+    memcpy(gens->cfs, map + off, nterms * sizeof(int32_t));
+    /* coefficients are reduced as in the text format */
+    for(int64_t i = 0; i < nterms; i++){
+      int64_t c = (int64_t)gens->cfs[i] % gens->field_char;
+      gens->cfs[i] = (int32_t)(c < 0 ? c + gens->field_char : c);
+    }
+  }
+  else{
+    gens->mpz_cfs = (mpz_t **)malloc(sizeof(mpz_t *) * 2 * nterms);
+    for(int64_t i = 0; i < 2 * nterms; i++){
+      int64_t n;
+      if(!bin_section_fits(off, 1, sizeof(int64_t), sz)){
+        bin_file_error(fn);
+      }
+      memcpy(&n, map + off, sizeof(int64_t));
+      off += sizeof(int64_t);
+      if(n == INT64_MIN){
+        bin_file_error(fn);
+      }
+      const size_t nl = n < 0 ? -n : n;
+      if(!bin_section_fits(off, nl, sizeof(mp_limb_t), sz)){
+        bin_file_error(fn);
+      }
+      gens->mpz_cfs[i] = (mpz_t *)malloc(sizeof(mpz_t));
+      mpz_init2(*(gens->mpz_cfs[i]), nl * GMP_NUMB_BITS);
+      if(nl > 0){
+        mp_limb_t *l = mpz_limbs_write(*(gens->mpz_cfs[i]), nl);
+        memcpy(l, map + off, nl * sizeof(mp_limb_t));
+        mpz_limbs_finish(*(gens->mpz_cfs[i]), n);
+        off += nl * sizeof(mp_limb_t);
+      }
+    }
+  }
+  munmap(map, sz);
+
+  *nr_vars = nv;
+  *nr_gens = ng;
+  *field_char = gens->field_char;
+}
+
+static inline int write_bin_padding(FILE *fh, size_t n){
+  const char zeros[8] = {0};
+  n = MSOLVE_BIN_PAD(n) - n;
+  return n == 0 || fwrite(zeros, 1, n, fh) == n;
+}
+
+/* writes the input system in gens to fn in the binary format read by
+ * get_data_from_bin_file */
+static void write_data_to_bin_file(const char *fn, const data_gens_ff_t *gens){
+  FILE *fh = fopen(fn, "wb");
+  if(fh == NULL){
+    fprintf(stderr, "Cannot open binary file %s\n", fn);
+    exit(1);
+  }
+  const int64_t nterms = gens->nterms;
+  int64_t namesz = 0;
+  for(int32_t i = 0; i < gens->nvars; i++){
+    namesz += strlen(gens->vnames[i]) + 1;
+  }
+  const int64_t head[8] = {MSOLVE_BIN_MAGIC, MSOLVE_BIN_VERSION, gens->nvars,
+                           gens->ngens, gens->field_char, nterms,
+                           sizeof(mp_limb_t), namesz};
+  int ok = fwrite(head, sizeof(int64_t), 8, fh) == 8;
+  for(int32_t i = 0; ok && i < gens->nvars; i++){
+    const size_t l = strlen(gens->vnames[i]) + 1;
+    ok = fwrite(gens->vnames[i], 1, l, fh) == l;
+  }
+  ok = ok && write_bin_padding(fh, namesz)
+    && fwrite(gens->lens, sizeof(int32_t), gens->ngens, fh) == (size_t)gens->ngens
+    && write_bin_padding(fh, gens->ngens * sizeof(int32_t))
+    && fwrite(gens->exps, sizeof(int32_t), nterms * gens->nvars, fh)
+    == (size_t)(nterms * gens->nvars)
+    && write_bin_padding(fh, nterms * gens->nvars * sizeof(int32_t));
+  if(gens->field_char){
+    ok = ok && fwrite(gens->cfs, sizeof(int32_t), nterms, fh) == (size_t)nterms
+      && write_bin_padding(fh, nterms * sizeof(int32_t));
+  }
+  else{
+    for(int64_t i = 0; ok && i < 2 * nterms; i++){
+      const mpz_t *c = gens->mpz_cfs[i];
+      const int64_t nl = mpz_size(*c);
+      const int64_t n = mpz_sgn(*c) < 0 ? -nl : nl;
+      ok = fwrite(&n, sizeof(int64_t), 1, fh) == 1
+        && fwrite(mpz_limbs_read(*c), sizeof(mp_limb_t), nl, fh) == (size_t)nl;
+    }
+  }
+  fclose(fh);
+  if(!ok){
+    fprintf(stderr, "Could not write binary file %s\n", fn);
+    exit(1);
+  }
+}
+
 //nr_gens is a pointer to the number of generators
 static inline void get_data_from_file(char *fn, int32_t *nr_vars,
                                       int32_t *field_char,
                                       int32_t *nr_gens, data_gens_ff_t *gens){
+  if (is_bin_system_file(fn)) {
+    get_data_from_bin_file(fn, nr_vars, field_char, nr_gens, gens);
+    return;
+  }
   *nr_vars = get_nvars(fn);
   if (*nr_vars == -1)
     printf("Bad file format (first line).\n");
@@ -1142,8 +1472,12 @@ static inline void get_single_param_from_file(FILE *file, mpz_param_t param){
 
 static inline void get_params_from_file_bin(char *fn, mpz_param_array_t lparam){
   FILE *file = fopen(fn,"r");
+  if(file == NULL){
+    fprintf(stderr, "Cannot open binary file %s\n", fn);
+    exit(1);
+  }
   int32_t nb = 0;
-  if(!fscanf(file, "%d\n", &nb)){
+  if(fscanf(file, "%d\n", &nb) != 1 || nb < 0){
     fprintf(stderr, "Issue when reading binary file (nb = %d)\n", nb);
     exit(1);
   }
@@ -1156,6 +1490,49 @@ static inline void get_params_from_file_bin(char *fn, mpz_param_array_t lparam){
   fclose(file);
 }
 
+/* writes pol in the format read by get_poly_bin */
+static inline void write_poly_bin(FILE *file, mpz_upoly_t pol){
+  const int32_t len = pol->length > 0 ? pol->length : 0;
+  fprintf(file, "%d\n", len);
+  for(int32_t i = 0; i < len; i++){
+    if(!mpz_out_raw(file, pol->coeffs[i])){
+      fprintf(stderr, "An error occurred when writing file (i=%d)\n", i);
+      exit(1);
+    }
+  }
+}
+
+static inline void write_single_param_to_file_bin(FILE *file,
+                                                  mpz_param_t param){
+  write_poly_bin(file, param->elim);
+
+  write_poly_bin(file, param->denom);
+
+  fprintf(file, "%d\n", param->nvars);
+
+  for(int32_t i = 0; i < param->nvars - 1; i++){
+    write_poly_bin(file, param->coords[i]);
+
+    if(!mpz_out_raw(file, param->cfs[i])){
+      fprintf(stderr, "An error occurred when writing file (lcm coord i=%d)\n", i);
+      exit(1);
+    }
+  }
+}
+
+/* writes param to fn such that get_params_from_file_bin reads it back as
+ * an array containing this single parametrization */
+static inline void write_param_to_file_bin(char *fn, mpz_param_t param){
+  FILE *file = fopen(fn, "w");
+  if(file == NULL){
+    fprintf(stderr, "Cannot open binary output file %s\n", fn);
+    exit(1);
+  }
+  fprintf(file, "%d\n", 1);
+  write_single_param_to_file_bin(file, param);
+  fclose(file);
+}
+
 static inline void get_params_from_file(char *fn, mpz_param_array_t lparam){
   FILE *file = fopen(fn,"r");
   int32_t nb = 0;
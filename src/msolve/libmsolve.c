@@ -28,6 +28,7 @@
 #include "hilbert.c"
 #include "primes.c"
 #include "../crt/mpz_CRT_ui.c"
+#include "../crt/mpz_CRT_batch.c"
 #include "../crt/mpq_reconstruct.c"
 #include "../usolve/data_usolve.c"
 #include "../usolve/libusolve.h"
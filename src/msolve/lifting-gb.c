@@ -89,6 +89,7 @@ typedef struct{
   int *check1; /* tells whether lifted data are ok with one more prime */
   int *check2; /* tells whether lifted data are ok with two more primes */
   int32_t S;
+  mpz_CRT_batch_t crtb; /* primes not yet merged into crt */
 } data_lift_struct;
 
 typedef data_lift_struct data_lift_t[1];
@@ -96,7 +97,8 @@ typedef data_lift_struct data_lift_t[1];
 
 static inline void data_lift_init(data_lift_t dl,
                                   int32_t npol,
-                                  int32_t *steps, int32_t nsteps){
+                                  int32_t *steps, int32_t nsteps,
+                                  mpz_t mod_p){
   dl->npol = npol;
   dl->rr = 1;
   dl->lstart = 0;
@@ -132,6 +134,7 @@ static inline void data_lift_init(data_lift_t dl,
   dl->end = npol;
   dl->check1 = calloc(npol, sizeof(int));
   dl->check2 = calloc(npol, sizeof(int));
+  mpz_CRT_batch_init(dl->crtb, CRT_BATCH_NPRIMES, mod_p);
 
 }
 
@@ -158,6 +161,7 @@ static inline void data_lift_clear(data_lift_t dl){
   mpz_clear(dl->tmp);
   free(dl->check1);
   free(dl->check2);
+  mpz_CRT_batch_clear(dl->crtb);
 
 }
 
@@ -713,9 +717,7 @@ static int32_t * gb_modular_trace_learning(gb_modpoly_t modgbs,
 }
 
 
-static void gb_modular_trace_application(gb_modpoly_t modgbs,
-                                         int32_t *mgb,
-                                         int32_t *num_gb,
+static void gb_modular_trace_application(int32_t *num_gb,
                                          int32_t **leadmons_ori,
                                          int32_t **leadmons_current,
 
@@ -726,12 +728,10 @@ static void gb_modular_trace_application(gb_modpoly_t modgbs,
                                          md_t *st,
                                          int info_level,
                                          bs_t **obs,
-                                         int32_t *lmb_ori,
-                                         int32_t dquot_ori,
                                          primes_t *lp,
-                                         int32_t start,
                                          double *stf4,
-                                         int *bad_primes)
+                                         int *bad_primes,
+                                         const int nthrds)
 {
 
   double rt = realtime();
@@ -739,60 +739,80 @@ static void gb_modular_trace_application(gb_modpoly_t modgbs,
   st->f4_qq_round = 2;
   /* tracing phase */
 
-  /* F4 and FGLM are run using a single thread */
+  /* the nthrds primes are handled by bundles of at most PRIME_BUNDLE
+   * primes, the matrices of a bundle are reduced in one sweep. the bundles
+   * are handled in parallel, each of them getting its share of the
+   * threads. */
   /* st->nthrds is reset to its original value afterwards */
-  /*at the moment multi-threading is not supprted here*/
-  memset(bad_primes, 0, (unsigned long)st->nprimes * sizeof(int));
+  const int onthrds = st->nthrds;
+  const int nbdl    = (nthrds + PRIME_BUNDLE - 1) / PRIME_BUNDLE;
+  st->nthrds = nthrds / nbdl;
+  memset(bad_primes, 0, (unsigned long)nthrds * sizeof(int));
+
+  int32_t *errs = (int32_t *)calloc((unsigned long)nthrds, sizeof(int32_t));
+#ifdef _OPENMP
+  const int max_levels = omp_get_max_active_levels();
+  omp_set_max_active_levels(2);
+#endif
 
-  bs_t *bs = NULL;
-  int32_t error = 0;
-  bs = core_gba(bs_qq, st, &error, lp->p[0]);
-  *stf4 = realtime()-rt;
-  ht_t **bht = &(bs->ht);
-  if (bs == NULL) {
-      bad_primes[0] = 1;
-      return;
+  len_t i;
+#pragma omp parallel for num_threads(nbdl) \
+    private(i) schedule(dynamic)
+  for (i = 0; i < (len_t)nthrds; i += PRIME_BUNDLE) {
+    const len_t nb = MIN((len_t)PRIME_BUNDLE, (len_t)nthrds - i);
+    core_gba_bundle(obs+i, bs_qq, st, errs+i, lp->p+i, nb);
   }
-  int32_t lml = bs->lml;
-  if (st->nev > 0) {
+#ifdef _OPENMP
+  omp_set_max_active_levels(max_levels);
+#endif
+
+#pragma omp parallel for num_threads(nthrds) \
+    private(i) schedule(dynamic)
+  for (i = 0; i < (len_t)nthrds; ++i) {
+    const int32_t error = errs[i];
+    if (error > 0 || obs[i] == NULL) {
+      if (obs[i] != NULL) {
+        free_basis_and_only_local_hash_table_data(&(obs[i]));
+      }
+      bad_primes[i] = 1;
+      continue;
+    }
+    bs_t *bs = obs[i];
+    ht_t *bht = bs->ht;
+    int32_t lml = bs->lml;
+    if (st->nev > 0) {
       int32_t j = 0;
-      for (len_t i = 0; i < bs->lml; ++i) {
-          if ((*bht)->ev[bs->hm[bs->lmps[i]][OFFSET]][0] == 0) {
-              bs->lm[j]   = bs->lm[i];
-              bs->lmps[j] = bs->lmps[i];
-              ++j;
-          }
+      for (len_t k = 0; k < bs->lml; ++k) {
+        if (bht->ev[bs->hm[bs->lmps[k]][OFFSET]][0] == 0) {
+          bs->lm[j]   = bs->lm[k];
+          bs->lmps[j] = bs->lmps[k];
+          ++j;
+        }
       }
       lml = j;
-  }
-  if (lml != num_gb[0]) {
-      if (bs != NULL) {
-        free_basis_and_only_local_hash_table_data(&bs);
-      }
-      return;
-  }
-
-  if(st->nev){
-    get_lm_from_bs_trace_elim(bs, bht[0], leadmons_current[0], num_gb[0]);
-  }
-  else{
-    get_lm_from_bs_trace(bs, bht[0], leadmons_current[0]);
-  }
-
-  if(!equal_staircase(leadmons_current[0], leadmons_ori[0],
-                      num_gb[0], num_gb[0], bht[0]->nv - st->nev)){
-    bad_primes[0] = 1;
-  }
+    }
+    if (lml != num_gb[i]) {
+      free_basis_and_only_local_hash_table_data(&(obs[i]));
+      bad_primes[i] = 1;
+      continue;
+    }
 
-  if(!bad_primes[0] && bs != NULL){
-    /* copy of data for multi-mod computation */
-    modpgbs_set(modgbs, bs, bht[0], lp->p[0], lmb_ori, dquot_ori, mgb, start, st->nev);
-  }
+    if(st->nev){
+      get_lm_from_bs_trace_elim(bs, bht, leadmons_current[i], num_gb[i]);
+    }
+    else{
+      get_lm_from_bs_trace(bs, bht, leadmons_current[i]);
+    }
 
-  if (bs != NULL) {
-    free_basis_and_only_local_hash_table_data(&bs);
+    if(!equal_staircase(leadmons_current[i], leadmons_ori[i],
+                        num_gb[i], num_gb[i], bht->nv - st->nev)){
+      free_basis_and_only_local_hash_table_data(&(obs[i]));
+      bad_primes[i] = 1;
+    }
   }
-
+  free(errs);
+  st->nthrds = onthrds;
+  *stf4 = realtime()-rt;
 }
 
 static inline void choose_coef_to_lift(gb_modpoly_t modgbs, data_lift_t dlift){
@@ -831,21 +851,31 @@ static inline void incremental_dlift_crt(gb_modpoly_t modgbs, data_lift_t dlift,
 }
 
 
-/* Incremental CRT on the whole array of witness coefficients */
-/* mod is the current modulus */
+/* Batched CRT on the whole array of witness coefficients */
+/* mod is the current modulus, the last prime is only recorded and the
+ * witness coefficients are lifted once flush is nonzero or once the batch
+ * of pending primes is full; their images are read from modgbs */
 static inline void incremental_dlift_crt_full(gb_modpoly_t modgbs, data_lift_t dl,
                                               int32_t *coef, mpz_t mod_p, mpz_t prod_p,
-                                              int thrds){
+                                              int thrds, int flush){
 
   mp_limb_t newprime = modgbs->primes[modgbs->nprimes - 1 ];
   /* all primes are assumed to be good primes */
   mpz_mul_ui(prod_p, mod_p, (uint32_t)newprime);
-  for(int32_t k = 0; k < dl->end; k++){
-      uint64_t c = modgbs->modpolys[k]->cf_32[coef[k]][modgbs->nprimes  - 1 ];
-      mpz_CRT_ui(dl->crt[k], dl->crt[k], mod_p,
-                 c, newprime, prod_p, dl->tmp, 1);
-  }
   mpz_set(mod_p, prod_p);
+  mpz_CRT_batch_add_prime(dl->crtb, newprime);
+  if(flush == 0 && dl->crtb->ld < dl->crtb->alloc){
+    return;
+  }
+  const uint32_t first = modgbs->nprimes - dl->crtb->ld;
+  mpz_CRT_batch_prepare(dl->crtb);
+  int32_t k;
+#pragma omp parallel for num_threads(thrds) private(k) schedule(static)
+  for(k = 0; k < dl->end; k++){
+      mpz_CRT_batch_lift(dl->crt[k], modgbs->modpolys[k]->cf_32[coef[k]] + first,
+                         dl->crtb, 1);
+  }
+  mpz_CRT_batch_done(dl->crtb);
 }
 
 
@@ -1083,10 +1113,13 @@ static void ratrecon_gb(gb_modpoly_t modgbs, data_lift_t dl,
   }
   dl->lstart = dl->start;
 
+  /* witness coefficients are reconstructed every dl->rr primes */
+  const int rec = (modgbs->nprimes % dl->rr == 0);
+
   st = realtime();
   incremental_dlift_crt_full(modgbs, dl,
                              dl->coef, mod_p, prod_p,
-                             thrds);
+                             thrds, rec);
   *st_crt += realtime() - st;
 
   /********************************************************/
@@ -1100,7 +1133,7 @@ static void ratrecon_gb(gb_modpoly_t modgbs, data_lift_t dl,
   set_recdata(dl, recdata1, recdata2, mod_p);
 
   st = realtime();
-  if(modgbs->nprimes % dl->rr == 0){
+  if(rec){
     for(int32_t i = dl->lstart; i < dl->lend; i++){
       int b = reconstructcoeff(dl, i, mod_p,
                                recdata1, recdata2);
@@ -1250,7 +1283,7 @@ gb_modpoly_t *core_groebner_qq(
       int nb = 0;
       int32_t *ldeg = array_nbdegrees((*msd->leadmons_ori), msd->num_gb[0],
                                       msd->bht->nv - st->nev, &nb);
-      data_lift_init(dlift, (*modgbsp)->ld, ldeg, nb);
+      data_lift_init(dlift, (*modgbsp)->ld, ldeg, nb, msd->mod_p);
       choose_coef_to_lift((*modgbsp), dlift);
       free(ldeg);
       dlinit = 1;
@@ -1315,56 +1348,40 @@ gb_modpoly_t *core_groebner_qq(
     /* print postponed */
 
     learn = 0;
+    /* primes are handled by batches of nthrds primes, each of them being
+     * processed by a single thread */
+    const int nthrds = st->nthrds;
     while(apply){
 
-      prime = next_prime(prime);
-      if(prime >= lprime){
-        prime = next_prime(1<<30);
-      }
       /* generate lucky prime numbers */
-      msd->lp->p[0] = prime;
-      while(is_lucky_prime_ui(prime, msd->bs_qq) || prime==primeinit){
+      for(len_t i = 0; i < (len_t)nthrds; i++){
         prime = next_prime(prime);
         if(prime >= lprime){
           prime = next_prime(1<<30);
         }
-        msd->lp->p[0] = prime;
-      }
-      int nthrds = 1; /* mono-threaded mult-mid comp */
-      for(len_t i = 1; i < nthrds/* st->nthrds */; i++){
-        prime = next_prime(prime);
-        if(prime >= lprime){
-          prime = next_prime(1<<30);
-        }
-        msd->lp->p[i] = prime;
         while(is_lucky_prime_ui(prime, msd->bs_qq) || prime==primeinit){
           prime = next_prime(prime);
           if(prime >= lprime){
             prime = next_prime(1<<30);
           }
-          msd->lp->p[i] = prime;
         }
+        msd->lp->p[i] = prime;
       }
-      prime = msd->lp->p[nthrds /* st->nthrds */ - 1];
 
-      if((*modgbsp)->alloc <= nprimes + 2){
-        gb_modpoly_realloc((*modgbsp), 16*st->nthrds, dlift->S);
+      if((*modgbsp)->alloc <= (*modgbsp)->nprimes + nthrds + 1){
+        gb_modpoly_realloc((*modgbsp), 16*nthrds, dlift->S);
       }
 
-      gb_modular_trace_application((*modgbsp), msd->mgb,
-                                   msd->num_gb,
+      gb_modular_trace_application(msd->num_gb,
                                    msd->leadmons_ori,
                                    msd->leadmons_current,
                                    msd->btrace,
                                    msd->btht, msd->bs_qq, msd->blht, st,
                                    0, /* info_level, */
-                                   msd->bs, lmb_ori, *dquot_ptr, msd->lp,
-                                   dlift->S, &stf4, msd->bad_primes);
-
+                                   msd->bs, msd->lp,
+                                   &stf4, msd->bad_primes, nthrds);
 
-      /* nprimes += st->nthrds; */
-      nprimes += 1; /* at the moment, multi-mod comp is mono-threaded */
-      if(nprimes == 1){
+      if(nprimes == 0){
         if(info_level>2){
           fprintf(stderr, "------------------------------------------\n");
           fprintf(stderr, "#ADDITIONS       %13lu\n", (unsigned long)st->application_nr_add * 1000);
@@ -1402,15 +1419,65 @@ gb_modpoly_t *core_groebner_qq(
       }
 
       }
-      int bad = 0;
-      for(int i = 0; i < nthrds/* st->nthrds */; i++){
+      /* modular bases are merged one after the other, in the order of
+       * the primes, into the CRT and rational reconstruction data */
+      for(int i = 0; i < nthrds; i++){
+        if(apply == 0){
+          /* lifting is done, remaining modular bases are not needed */
+          if(msd->bs[i] != NULL){
+            free_basis_and_only_local_hash_table_data(&(msd->bs[i]));
+          }
+          continue;
+        }
+        nprimes++;
         if(msd->bad_primes[i] == 1){
-          bad = 1;
           nbadprimes++;
+          continue;
+        }
+        modpgbs_set((*modgbsp), msd->bs[i], msd->bs[i]->ht, msd->lp->p[i],
+                    lmb_ori, *dquot_ptr, msd->mgb, dlift->S, st->nev);
+        free_basis_and_only_local_hash_table_data(&(msd->bs[i]));
+
+        int lstart = dlift->lstart;
+        double ost_rrec = st_rrec;
+        double ost_crt = st_crt;
+
+        ratrecon_gb((*modgbsp), dlift, msd->mod_p, msd->prod_p, recdata1, recdata2,
+                    1, &st_crt, &st_rrec);
+        /* stf4 / nthrds is the elapsed time spent per prime */
+        if((st_crt -ost_crt) + (st_rrec - ost_rrec) > dlift->rr * stf4 / nthrds){
+          dlift->rr = 2*dlift->rr;
+          if(info_level){
+            fprintf(stdout, "(->%d)", dlift->rr);
+	    fflush(stdout);
+          }
+        }
+        if(info_level){
+          if(!(nprimes & (nprimes - 1))){
+            fprintf(stdout, "{%d}", nprimes);
+	    fflush(stdout);
+          }
+        }
+        apply = 0;
+        for(len_t k = 0; k < (*modgbsp)->ld; k++){
+          if(dlift->check2[k] < NBCHECK){
+            apply = 1;
+            break;
+          }
+        }
+        if(print_gb == 1){
+          apply = 0;
+        }
+        if(dlift->lstart != lstart){
+          if(info_level){
+            fprintf(stdout, "<%.2f%%>", 100* (float)MIN((dlift->lstart + 1), (*modgbsp)->ld)/(*modgbsp)->ld);
+	    fflush(stdout);
+          }
+          lstart = dlift->lstart;
         }
       }
 
-      if(nbadprimes == nprimes){
+      if(apply && nbadprimes == nprimes){
         if(info_level){
           fprintf(stderr, "Too many bad primes, computation will restart\n");
         }
@@ -1424,45 +1491,6 @@ gb_modpoly_t *core_groebner_qq(
         return core_groebner_qq(modgbsp, bs, msd, st, errp, fc, print_gb); 
 
       }
-
-      int lstart = dlift->lstart;
-      double ost_rrec = st_rrec;
-      double ost_crt = st_crt;
-
-      if(!bad){
-        ratrecon_gb((*modgbsp), dlift, msd->mod_p, msd->prod_p, recdata1, recdata2,
-                    nthrds/* st->nthrds */, &st_crt, &st_rrec);
-      }
-      if((st_crt -ost_crt) + (st_rrec - ost_rrec) > dlift->rr * stf4){
-        dlift->rr = 2*dlift->rr;
-        if(info_level){
-          fprintf(stdout, "(->%d)", dlift->rr);
-	  fflush(stdout);
-        }
-      }
-      if(info_level){
-        if(!(nprimes & (nprimes - 1))){
-          fprintf(stdout, "{%d}", nprimes);
-	  fflush(stdout);
-        }
-      }
-      apply = 0;
-      for(len_t i = 0; i < (*modgbsp)->ld; i++){
-        if(dlift->check2[i] < NBCHECK){
-          apply = 1;
-          break;
-        }
-      }
-      if(!bad && print_gb == 1){
-          apply = 0;
-      }
-      if(dlift->lstart != lstart){
-        if(info_level){
-          fprintf(stdout, "<%.2f%%>", 100* (float)MIN((dlift->lstart + 1), (*modgbsp)->ld)/(*modgbsp)->ld);
-	  fflush(stdout);
-        }
-        lstart = dlift->lstart;
-      }
       /* this is where learn could be reset to 1 */
       /* but then duplicated datas and others should be free-ed */
     }
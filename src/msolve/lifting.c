@@ -413,39 +413,6 @@ static inline void crt_lift_dense_rows(mpz_t *rows, uint32_t *mod_rows,
   }
 }
 
-static inline void crt_lift_trace_det(trace_det_fglm_mat_t trace_det,
-                                      uint32_t trace_mod, uint32_t det_mod,
-                                      sp_matfglm_t *mod_mat,
-                                      uint32_t *lineqs, 
-                                      param_t *nmod_param,
-                                      mpz_t modulus, mpz_t prod,
-                                      uint32_t prime, 
-                                      int nthrds
-                                      ) {
-  mpz_CRT_ui(trace_det->trace_crt, trace_det->trace_crt, modulus, trace_mod,
-             prime, prod, trace_det->tmp, 0);
-  mpz_CRT_ui(trace_det->det_crt, trace_det->det_crt, modulus, det_mod, prime,
-             prod, trace_det->tmp, 0);
-
-  int32_t nlins = trace_det->nlins;
-  int32_t lin_lifted = trace_det->lin_lifted;
-
-  if (nlins && (lin_lifted) < 2) {
-      for (int32_t i = 0; i < nlins; i++) {
-          crt_lift_dense_rows(trace_det->crt_linear_forms + i * (nmod_param->nvars + 1),
-                          lineqs + i * (nmod_param->nvars + 1), 0,
-                          nmod_param->nvars + 1, modulus, prod, prime,
-                          trace_det->tmp, nthrds);
-      }
-  }
-
-  for(uint32_t i = trace_det->w_checked; i < mod_mat->nrows; i++){
-      mpz_CRT_ui(trace_det->matmul_wcrt[i], trace_det->matmul_wcrt[i], modulus, 
-                 mod_mat->dense_mat[trace_det->matmul_indices[i]], prime, prod, 
-                 trace_det->tmp, 0);
-  }
-}
-
 static inline void crt_lift_mat(crt_mpz_matfglm_t mat, sp_matfglm_t *mod_mat,
                                 mpz_t modulus, mpz_t prod_crt,
                                 const int32_t prime, mpz_t tmp,
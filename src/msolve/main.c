@@ -35,9 +35,14 @@ static inline void display_help(char *str){
   fprintf(stdout, "FILE1 and FILE2 are respectively the input and output files\n\n");
 
   fprintf(stdout, "Standard options\n\n");
-  fprintf(stdout, "-f FILE  File name (mandatory).\n\n");
+  fprintf(stdout, "-f FILE  File name (mandatory). Input systems in binary\n");
+  fprintf(stdout, "         format (see option -B) are detected automatically.\n\n");
   fprintf(stdout, "-h       Prints this help.\n");
   fprintf(stdout, "-o FILE  Name of output file.\n");
+  fprintf(stdout, "-O FILE  Writes the rational parametrization of the solutions\n");
+  fprintf(stdout, "         to FILE in binary format (with -P 1 or -P 2, over\n");
+  fprintf(stdout, "         the rationals). Binary files are written and read\n");
+  fprintf(stdout, "         much faster than text output for large outputs.\n");
   fprintf(stdout, "-t THR   Number of threads to be used.\n");
   fprintf(stdout, "         Default: 1.\n");
   fprintf(stdout, "-v n     Level of verbosity, 0 - 2\n");
@@ -64,7 +69,10 @@ static inline void display_help(char *str){
 
 
   fprintf(stdout, "\nAdvanced options:\n\n");
-  fprintf(stdout, "-F FILE  File name encoding parametrizations in binary format.\n\n");
+  fprintf(stdout, "-F FILE  Reads the rational parametrization of the solutions\n");
+  fprintf(stdout, "         from FILE instead of computing it, over the rationals.\n");
+  fprintf(stdout, "         FILE has to be written by option -O for the same\n");
+  fprintf(stdout, "         input system.\n\n");
   fprintf(stdout, "-g GB    Prints reduced Groebner bases of input system for\n");
   fprintf(stdout, "         first prime characteristic w.r.t. grevlex ordering.\n");
   fprintf(stdout, "         One element per line is printed, commata separated.\n");
@@ -89,6 +97,10 @@ static inline void display_help(char *str){
   fprintf(stdout, "         2 - Some normal forms are computed. (default)\n");
   fprintf(stdout, "         3 - Lots of normal forms are computed.\n");
   fprintf(stdout, "         4 - All the normal forms are computed.\n");
+  fprintf(stdout, "-B FILE  Writes the input system to FILE in msolve's binary\n");
+  fprintf(stdout, "         format and exits. Binary files are read much faster\n");
+  fprintf(stdout, "         than text files, they are not portable between\n");
+  fprintf(stdout, "         machines of different endianness.\n");
   fprintf(stdout, "-C       Use sparse-FGLM-col algorithm:\n");
   fprintf(stdout, "         Given an input file with k polynomials\n");
   fprintf(stdout, "         compute the quotient of the ideal\n");
@@ -132,6 +144,12 @@ static inline void display_help(char *str){
   fprintf(stdout, "         Default: 1 (yes).\n");
   /* fprintf(stdout, "-R       Refinement fo real roots.\n"); */
   /* fprintf(stdout, "         (not implemented yet).\n"); */
+  fprintf(stdout, "-T FILE  Reads the F4 tracer from FILE instead of learning\n");
+  fprintf(stdout, "         it for the first prime. FILE has to be written by\n");
+  fprintf(stdout, "         option -W for a system with the same support, if it\n");
+  fprintf(stdout, "         does not fit the tracer is learned as usual.\n");
+  fprintf(stdout, "-W FILE  Writes the F4 tracer learned for the first prime\n");
+  fprintf(stdout, "         to FILE, see option -T.\n");
   fprintf(stdout, "-s HTS   Initial hash table size given\n");
   fprintf(stdout, "         as power of two. Default: 17.\n");
   fprintf(stdout, "-S       Use f4sat saturation algorithm:\n");
@@ -180,8 +198,11 @@ static void getoptions(
   char *bin_filename = NULL;
   char *out_fname = NULL;
   char *bin_out_fname = NULL;
+  char *trace_fname = NULL;
+  char *trace_out_fname = NULL;
+  char *system_bin_out_fname = NULL;
   opterr = 1;
-  char options[] = "hf:N:F:v:l:t:e:o:O:u:iI:p:P:L:q:g:c:s:SCr:R:m:M:n:d:Vf:";
+  char options[] = "hf:N:F:v:l:t:e:o:O:u:iI:p:P:L:q:g:c:s:SCr:R:m:M:n:d:T:W:B:Vf:";
   while((opt = getopt(argc, argv, options)) != -1) {
     switch(opt) {
     case 'N':
@@ -261,7 +282,6 @@ static void getoptions(
       filename = optarg;
       break;
     case 'F':
-      fflag = 0;
       bin_filename = optarg;
       break;
     case 'o':
@@ -270,6 +290,15 @@ static void getoptions(
     case 'O':
       bin_out_fname = optarg;
       break;
+    case 'T':
+      trace_fname = optarg;
+      break;
+    case 'W':
+      trace_out_fname = optarg;
+      break;
+    case 'B':
+      system_bin_out_fname = optarg;
+      break;
     case 'P':
       *get_param = strtol(optarg, NULL, 10);
       if (*get_param <= 0) {
@@ -337,6 +366,9 @@ static void getoptions(
   files->bin_file = bin_filename;
   files->out_file = out_fname;
   files->bin_out_file = bin_out_fname;
+  files->trace_file = trace_fname;
+  files->trace_out_file = trace_out_fname;
+  files->system_bin_out_file = system_bin_out_fname;
 }
 
 
@@ -380,6 +412,10 @@ int main(int argc, char **argv){
     files->bin_file = NULL;
     files->out_file = NULL;
     files->bin_out_file = NULL;
+    files->trace_file = NULL;
+    files->trace_out_file = NULL;
+    files->trace_stream = NULL;
+    files->system_bin_out_file = NULL;
     getoptions(argc, argv, &initial_hts, &nr_threads, &max_pairs,
                &elim_block_len, &la_option, &use_signatures, &update_ht,
                &reduce_gb, &print_gb, &truncate_lifting, &genericity_handling, &unstable_staircase, &saturate, &colon,
@@ -425,6 +461,14 @@ int main(int argc, char **argv){
     display_gens(stdout, gens);
 #endif
 
+    /* conversion mode */
+    if(files->system_bin_out_file != NULL){
+      write_data_to_bin_file(files->system_bin_out_file, gens);
+      free_data_gens(gens);
+      free(files);
+      return 0;
+    }
+
     gens->rand_linear           = 0;
     gens->random_linear_form = malloc(sizeof(int32_t)*(nr_vars));
     gens->elim = elim_block_len;
@@ -26,6 +26,9 @@
 #include<flint/fmpz.h>
 #include<flint/fmpq.h>
 #include <unistd.h>
+#ifdef _OPENMP
+#include <pthread.h>
+#endif
 #include <string.h>
 #include <getopt.h>
 #include <ctype.h>
@@ -146,6 +149,8 @@ typedef struct{
   nmod_poly_t V;
   nmod_poly_t param;
   nmod_poly_factor_t sqf;
+  long block_dim; /* block size of the Wiedemann sequence chosen for the
+                   * first prime, 0 for the scalar sequence */
 } fglm_bms_data_t;
 
 typedef struct{
@@ -324,6 +329,10 @@ typedef struct{
   char *bin_file;
   char *out_file;
   char *bin_out_file;
+  char *trace_file; /* F4 tracer to be read */
+  char *trace_out_file; /* F4 tracer to be written */
+  FILE *trace_stream; /* F4 tracer shared by the systems of a batch */
+  char *system_bin_out_file; /* input system converted to binary format */
 } files_gb;
 
 /* data structure for tracing algorithms */
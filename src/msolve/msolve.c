@@ -78,16 +78,41 @@ void mpz_upoly_clear(mpz_upoly_t pol) {
   free(pol->coeffs);
 }
 
-static inline void mpz_upoly_out_str(FILE *file, mpz_upoly_t pol) {
+static inline void mpz_upoly_out_str(FILE *file, mpz_upoly_t pol,
+                                     const int32_t nr_threads) {
   fprintf(file, "[");
   if (pol->length > 0) {
     fprintf(file, "%d, ", pol->length - 1); // degree
     fprintf(file, "[");
-    for (long i = 0; i < pol->length - 1; i++) {
-      mpz_out_str(file, 10, pol->coeffs[i]);
-      fprintf(file, ", ");
+    /* coefficients are converted to decimal strings in parallel, by blocks
+     * of consecutive coefficients, a round of blocks is written at once */
+    const long bsz = 64;
+    const int32_t nthrds = nr_threads > 0 ? nr_threads : 1;
+    const long nbl = 4 * (long)nthrds;
+    obuf_t *bufs = malloc(sizeof(obuf_t) * nbl);
+    for (long j = 0; j < nbl; j++) {
+      obuf_init(bufs + j, 1024);
+    }
+    for (long i = 0; i < pol->length; i += nbl * bsz) {
+#pragma omp parallel for num_threads(nthrds) schedule(dynamic)
+      for (long j = 0; j < nbl; j++) {
+        const long start = i + j * bsz;
+        const long end = start + bsz < pol->length ? start + bsz : pol->length;
+        for (long k = start; k < end; k++) {
+          obuf_put_mpz(bufs + j, pol->coeffs[k]);
+          if (k < pol->length - 1) {
+            obuf_puts(bufs + j, ", ");
+          }
+        }
+      }
+      for (long j = 0; j < nbl; j++) {
+        obuf_write(bufs + j, file);
+      }
+    }
+    for (long j = 0; j < nbl; j++) {
+      obuf_clear(bufs + j);
     }
-    mpz_out_str(file, 10, pol->coeffs[pol->length - 1]);
+    free(bufs);
     fprintf(file, "]");
   } else {
     fprintf(file, "-1, [0]");
@@ -121,7 +146,8 @@ static inline void mpz_param_clear(mpz_param_t param) {
 
 static inline void mpz_param_out_str(FILE *file, const data_gens_ff_t *gens,
                                      const long dquot, mpz_param_t param,
-                                     param_t *mod_param) {
+                                     param_t *mod_param,
+                                     const int32_t nr_threads) {
   fprintf(file, "[");
   fprintf(file, "%d, \n", gens->field_char); /* field charac */
   fprintf(file, "%d, \n", param->nvars);     // nvars
@@ -175,13 +201,13 @@ static inline void mpz_param_out_str(FILE *file, const data_gens_ff_t *gens,
   if (gens->field_char) {
     display_nmod_poly(file, mod_param->elim);
   } else {
-    mpz_upoly_out_str(file, param->elim); // elim. poly
+    mpz_upoly_out_str(file, param->elim, nr_threads); // elim. poly
   }
   fprintf(file, ",\n");
   if (gens->field_char) {
     display_nmod_poly(file, mod_param->denom);
   } else {
-    mpz_upoly_out_str(file, param->denom); // denom. poly
+    mpz_upoly_out_str(file, param->denom, nr_threads); // denom. poly
   }
   fprintf(file, ",\n");
   fprintf(file, "[\n");
@@ -203,7 +229,7 @@ static inline void mpz_param_out_str(FILE *file, const data_gens_ff_t *gens,
     if (param->coords != NULL) {
       for (int i = 0; i < param->nvars - 1; i++) {
         fprintf(file, "[");
-        mpz_upoly_out_str(file, param->coords[i]); // param. polys
+        mpz_upoly_out_str(file, param->coords[i], nr_threads); // param. polys
         fprintf(file, ",\n");
         mpz_out_str(file, 10, param->cfs[i]);
         if (i == param->nvars - 2) {
@@ -222,8 +248,9 @@ static inline void mpz_param_out_str(FILE *file, const data_gens_ff_t *gens,
 static inline void mpz_param_out_str_maple(FILE *file,
                                            const data_gens_ff_t *gens,
                                            const long dquot, mpz_param_t param,
-                                           param_t *mod_param) {
-  mpz_param_out_str(file, gens, dquot, param, mod_param);
+                                           param_t *mod_param,
+                                           const int32_t nr_threads) {
+  mpz_param_out_str(file, gens, dquot, param, mod_param, nr_threads);
   fprintf(file, "]");
 }
 
@@ -971,31 +998,219 @@ static inline void set_mpz_param_nmod(mpz_param_t mpz_param,
   }
 }
 
-static inline void crt_lift_mpz_upoly(mpz_upoly_t pol, nmod_poly_t nmod_pol,
-                                      mpz_t modulus, int32_t prime, mpz_t prod,
-                                      mpz_t tmp, int nthrds) {
-  len_t i;
-  /* #pragma omp parallel for num_threads(nthrds)    \ */
-  /*   private(i) schedule(static) */
-  for (i = 0; i < pol->length; i++) {
-    mpz_CRT_ui(pol->coeffs[i], pol->coeffs[i], modulus, nmod_pol->coeffs[i],
-               prime, prod, tmp, 0);
+/* modular images of the parametrization and of the trace/det data waiting
+ * to be merged into their CRT lifting */
+typedef struct{
+  mpz_CRT_batch_t cb;
+  uint64_t nres; /* number of images per prime */
+  uint32_t *res; /* images of the k-th lifted integer are stored at
+                    res + k * cb->alloc */
+} crt_images_struct;
+
+typedef crt_images_struct crt_images_t[1];
+
+/* number of integers lifted: coefficients of the parametrization, trace,
+ * det, linear forms and witness coefficients of the multiplication matrix */
+static inline void crt_images_init(crt_images_t ci, mpz_param_t mpz_param,
+                                   trace_det_fglm_mat_t trace_det,
+                                   mpz_t modulus){
+  ci->nres = mpz_param->elim->length + 2
+    + trace_det->nlins * (trace_det->nv + 1) + trace_det->nrows;
+  for (long i = 0; i < mpz_param->nvars - 1; i++) {
+    ci->nres += mpz_param->coords[i]->length;
+  }
+  mpz_CRT_batch_init(ci->cb, CRT_BATCH_NPRIMES, modulus);
+  ci->res = (uint32_t *)calloc(ci->nres * CRT_BATCH_NPRIMES, sizeof(uint32_t));
+}
+
+static inline void crt_images_clear(crt_images_t ci){
+  mpz_CRT_batch_clear(ci->cb);
+  free(ci->res);
+}
+
+static inline void crt_images_upoly(uint32_t *res, uint64_t *k,
+                                    const uint32_t alloc, const uint32_t idx,
+                                    mpz_upoly_t pol, nmod_poly_t nmod_pol){
+  for (long i = 0; i < pol->length; i++) {
+    res[(*k) * alloc + idx] = (i < nmod_pol->length) ? nmod_pol->coeffs[i] : 0;
+    (*k)++;
   }
 }
 
-/* assumes that all degrees are the same */
-static inline void crt_lift_mpz_param(mpz_param_t mpz_param,
-                                      param_t *nmod_param, mpz_t modulus,
-                                      mpz_t prod_crt, const int32_t prime,
-                                      mpz_t tmp, const int nthrds) {
+/* stores the images modulo prime, in the order given by crt_images_init */
+static inline void crt_images_add(crt_images_t ci, mpz_param_t mpz_param,
+                                  param_t *nmod_param,
+                                  trace_det_fglm_mat_t trace_det,
+                                  uint32_t trace_mod, uint32_t det_mod,
+                                  sp_matfglm_t *mod_mat, uint32_t *lineqs,
+                                  uint32_t prime){
+  const uint32_t alloc = ci->cb->alloc;
+  const uint32_t idx = mpz_CRT_batch_add_prime(ci->cb, prime);
+  uint32_t *res = ci->res;
+  uint64_t k = 0;
+
+  crt_images_upoly(res, &k, alloc, idx, mpz_param->elim, nmod_param->elim);
+  for (long i = 0; i < mpz_param->nvars - 1; i++) {
+    crt_images_upoly(res, &k, alloc, idx, mpz_param->coords[i],
+                     nmod_param->coords[i]);
+  }
+  res[(k++) * alloc + idx] = trace_mod;
+  res[(k++) * alloc + idx] = det_mod;
+  const uint64_t nl = trace_det->nlins * (trace_det->nv + 1);
+  for (uint64_t i = 0; i < nl; i++) {
+    res[(k++) * alloc + idx] = lineqs[i];
+  }
+  for (uint32_t i = 0; i < trace_det->nrows; i++) {
+    res[(k++) * alloc + idx] = mod_mat->dense_mat[trace_det->matmul_indices[i]];
+  }
+}
+
+/* merges all buffered images into the lifted integers */
+static inline void crt_images_lift(crt_images_t ci, mpz_param_t mpz_param,
+                                   trace_det_fglm_mat_t trace_det,
+                                   const int nthrds){
+  mpz_CRT_batch_prepare(ci->cb);
+
+  const uint32_t alloc = ci->cb->alloc;
+  const long nv = mpz_param->nvars;
+  /* offsets of the polynomials of the parametrization in res */
+  uint64_t *off = (uint64_t *)malloc(sizeof(uint64_t) * (nv + 1));
+  off[0] = 0;
+  off[1] = mpz_param->elim->length;
+  for (long i = 0; i < nv - 1; i++) {
+    off[i + 2] = off[i + 1] + mpz_param->coords[i]->length;
+  }
+  for (long j = 0; j < nv; j++) {
+    mpz_upoly_struct *pol = (j == 0) ? mpz_param->elim : mpz_param->coords[j - 1];
+    long i;
+#pragma omp parallel for num_threads(nthrds) private(i) schedule(static)
+    for (i = 0; i < pol->length; i++) {
+      mpz_CRT_batch_lift(pol->coeffs[i], ci->res + (off[j] + i) * alloc,
+                         ci->cb, 0);
+    }
+  }
+  uint64_t k = off[nv];
+  free(off);
+
+  mpz_CRT_batch_lift(trace_det->trace_crt, ci->res + (k++) * alloc, ci->cb, 0);
+  mpz_CRT_batch_lift(trace_det->det_crt, ci->res + (k++) * alloc, ci->cb, 0);
+
+  const uint64_t nl = trace_det->nlins * (trace_det->nv + 1);
+  if (trace_det->nlins && trace_det->lin_lifted < 2) {
+    for (uint64_t i = 0; i < nl; i++) {
+      mpz_CRT_batch_lift(trace_det->crt_linear_forms[i],
+                         ci->res + (k + i) * alloc, ci->cb, 0);
+    }
+  }
+  k += nl;
+  /* witness coefficients which are already checked are not needed anymore */
+  for (uint32_t i = trace_det->w_checked; i < trace_det->nrows; i++) {
+    mpz_CRT_batch_lift(trace_det->matmul_wcrt[i],
+                       ci->res + (k + i) * alloc, ci->cb, 0);
+  }
+  mpz_CRT_batch_done(ci->cb);
+}
+
+/* Scheduling of the rational reconstructions in msolve_trace_qq.
+
+   The trace and the determinant of the multiplication matrix (coefficients
+   of the eliminating polynomial at trace_det->trace_idx and det_idx) are
+   cheap probes. As long as they are not reconstructed and checked against
+   one more prime, only them and the witness coefficients of the
+   multiplication matrix are reconstructed, after a number of primes which
+   grows geometrically. Once the probes are stable, the whole
+   parametrization is reconstructed. In both cases, the interval between two
+   attempts is chosen such that the time spent in reconstruction stays below
+   RREC_SCHED_RATIO times the time spent computing primes. */
+#define RREC_SCHED_RATIO 0.2
+/* probes are attempted again after 1/RREC_SCHED_PROBE_GROWTH more primes */
+#define RREC_SCHED_PROBE_GROWTH 8
+
+#define RREC_NONE 0
+#define RREC_PROBES 1
+#define RREC_FULL 2
+
+typedef struct{
+  long next; /* number of primes at which reconstruction is attempted next */
+  long step; /* current number of primes between two full attempts */
+  long nprobes; /* number of attempts on the probes */
+  long nprobes_failed;
+  long nfull; /* number of attempts on the whole parametrization */
+  long nfull_failed; /* wasted attempts */
+  double probes_rt; /* elapsed time spent in attempts on the probes */
+  double full_rt; /* elapsed time spent in attempts on the parametrization */
+  double wasted_rt; /* elapsed time spent in wasted attempts */
+} rrec_sched_struct;
+
+typedef rrec_sched_struct rrec_sched_t[1];
+
+static inline void rrec_sched_init(rrec_sched_t rs){
+  memset(rs, 0, sizeof(rrec_sched_struct));
+  rs->next = 1;
+  rs->step = 1;
+}
+
+static inline int rrec_probes_stable(const trace_det_fglm_mat_t trace_det){
+  return trace_det->done_trace > 1 && trace_det->done_det > 1;
+}
+
+/* returns what is attempted once the images modulo the nprimes-th prime
+ * are known */
+static inline int rrec_sched_action(const rrec_sched_t rs,
+                                    const trace_det_fglm_mat_t trace_det,
+                                    const long nprimes){
+  if (nprimes < rs->next) {
+    return RREC_NONE;
+  }
+  return rrec_probes_stable(trace_det) ? RREC_FULL : RREC_PROBES;
+}
 
-  /*assumes prod_crt = modulus * prime */
-  crt_lift_mpz_upoly(mpz_param->elim, nmod_param->elim, modulus, prime,
-                     prod_crt, tmp, nthrds);
-  for (len_t i = 0; i < mpz_param->nvars - 1; i++) {
-    crt_lift_mpz_upoly(mpz_param->coords[i], nmod_param->coords[i], modulus,
-                       prime, prod_crt, tmp, nthrds);
+/* updates the schedule after an attempt of kind action which took rt
+ * seconds and succeeded if br is 1, prime_rt is the elapsed time per prime
+ * of the pipeline */
+static inline void rrec_sched_update(rrec_sched_t rs,
+                                     const trace_det_fglm_mat_t trace_det,
+                                     const int action, const int br,
+                                     const double rt, const double prime_rt,
+                                     const long nprimes){
+  if (action == RREC_NONE) {
+    return;
   }
+  /* number of primes during which the pipeline amortizes rt */
+  long amort = 1;
+  if (prime_rt > 0) {
+    amort = MAX(1, (long)ceil(rt / (RREC_SCHED_RATIO * prime_rt)));
+  }
+  if (action == RREC_PROBES) {
+    rs->nprobes++;
+    rs->probes_rt += rt;
+    if (trace_det->done_trace == 0 || trace_det->done_det == 0) {
+      rs->nprobes_failed++;
+      rs->next = nprimes + MAX(amort, nprimes / RREC_SCHED_PROBE_GROWTH);
+    } else {
+      /* probes are checked with the next prime */
+      rs->next = nprimes + 1;
+    }
+    return;
+  }
+  rs->nfull++;
+  rs->full_rt += rt;
+  if (br != 1) {
+    rs->nfull_failed++;
+    rs->wasted_rt += rt;
+  }
+  rs->step = amort;
+  rs->next = nprimes + amort;
+}
+
+static inline void rrec_sched_print(FILE *file, const rrec_sched_t rs){
+  fprintf(file, "#probe ratrecon   %16ld\n", rs->nprobes);
+  fprintf(file, "#failed           %16ld\n", rs->nprobes_failed);
+  fprintf(file, "#full ratrecon    %16ld\n", rs->nfull);
+  fprintf(file, "#wasted           %16ld\n", rs->nfull_failed);
+  fprintf(file, "probe ratrecon(elapsed) %12.2f sec\n", rs->probes_rt);
+  fprintf(file, "full ratrecon(elapsed)  %12.2f sec\n", rs->full_rt);
+  fprintf(file, "wasted ratrecon(elapsed) %11.2f sec\n", rs->wasted_rt);
 }
 
 /**
@@ -1174,13 +1389,14 @@ static inline int new_rational_reconstruction(
     mpz_param_t mpz_param, mpz_param_t tmp_mpz_param, param_t *nmod_param,
     nvars_t nlins, nvars_t *linvars, uint32_t *lineqs, 
     trace_det_fglm_mat_t trace_det, sp_matfglm_t *mat, mpz_upoly_t numer,
-    mpz_upoly_t denom, mpz_t modulus, mpz_t prod_crt, int32_t prime,
-    mpq_t *coef, mpz_t rnum, mpz_t rden, rrec_data_t recdata,
+    mpz_upoly_t denom, mpz_t modulus, mpz_t prod_crt, crt_images_t crtim,
+    int32_t prime, mpq_t *coef, mpz_t rnum, mpz_t rden, rrec_data_t recdata,
     mpz_t *guessed_num, mpz_t *guessed_den, deg_t *maxrec, 
     deg_t *matrec, deg_t *oldmatrec_checked, deg_t *matrec_checked,
     int *is_lifted, int *mat_lifted, int *lin_lifted, int doit, 
     int nbdoit,
     int nthrds,
+    const int lift_thrds,
     const int info_level) {
 
   uint32_t trace_mod = nmod_param->elim->coeffs[trace_det->trace_idx];
@@ -1206,12 +1422,13 @@ static inline int new_rational_reconstruction(
   }
 
   /**    CRT PART            **/
-  crt_lift_mpz_param(tmp_mpz_param, nmod_param, modulus, prod_crt, prime,
-                     trace_det->tmp, nthrds);
-
-  crt_lift_trace_det(trace_det, trace_mod, det_mod, mat,
-          lineqs, nmod_param,
-          modulus, prod_crt, prime, nthrds);
+  /* images are buffered and only merged when rational reconstruction is
+   * attempted or when the batch is full */
+  crt_images_add(crtim, tmp_mpz_param, nmod_param, trace_det,
+                 trace_mod, det_mod, mat, lineqs, prime);
+  if (doit || crtim->cb->ld == crtim->cb->alloc) {
+    crt_images_lift(crtim, tmp_mpz_param, trace_det, lift_thrds);
+  }
 
   *matrec = *matrec_checked;
 
@@ -1255,7 +1472,7 @@ static inline int new_rational_reconstruction(
   if(trace_det->done_trace < 2 || trace_det->done_det < 2){
       rat_recon_trace_det(trace_det, recdata, modulus, rnum, rden, *guessed_den);
   }
-  if (trace_det->done_trace > 1 && trace_det->done_det > 1) {
+  if (doit == RREC_FULL && rrec_probes_stable(trace_det)) {
 
     mpz_sub_ui(*guessed_num, modulus, 1);
     mpz_fdiv_q_2exp(*guessed_num, *guessed_num, 1);
@@ -1541,6 +1758,16 @@ static int32_t check_for_single_element_groebner_basis(
   return empty_solution_set;
 }
 
+/* the basis of the first prime owns its hash table only if a stored tracer
+ * was applied, see initial_modular_step */
+static inline void free_initial_basis(bs_t **bsp, const bs_t *const gbg) {
+  if ((*bsp)->ht != gbg->ht) {
+    free_basis_and_only_local_hash_table_data(bsp);
+  } else {
+    free_basis_without_hash_table(bsp);
+  }
+}
+
 static int32_t *initial_modular_step(
         sp_matfglm_t **bmatrix,
         int32_t **bdiv_xn,
@@ -1568,6 +1795,9 @@ static int32_t *initial_modular_step(
         long *dquot_ori,
         data_gens_ff_t *gens,
         files_gb *files,
+        int *tr_loaded,
+        const int32_t tr_num_gb,
+        const int32_t *tr_leadmons,
         int *success)
 {
     double rt = realtime();
@@ -1577,7 +1807,38 @@ static int32_t *initial_modular_step(
 
   int32_t error = 0;
   int32_t empty_solution_set = 1;
+  /* a tracer read from file is applied on a copy of the basis hash table,
+   * so that a new tracer can still be learned if it fails for this prime */
+  if (md->trace_level == APPLY_TRACER) {
+    md->f4_qq_round = 2;
+  }
   bs_t *bs = core_gba(gbg, md, &error, fc);
+  /* a stored tracer may apply but lead to another staircase than the one
+   * stored with it, it was then not learned for this system */
+  if (error == 0 && *tr_loaded) {
+    get_leading_ideal_information(num_gb, leadmons, 0, bs);
+    if (num_gb[0] != tr_num_gb ||
+        memcmp(leadmons[0], tr_leadmons,
+               sizeof(int32_t) * num_gb[0] * bs->ht->nv)) {
+      if (md->info_level) {
+        fprintf(stderr, "\nStaircase differs from the one stored with the tracer.");
+      }
+      free_initial_basis(&bs, gbg);
+      error = 1;
+    }
+    free(leadmons[0]);
+    leadmons[0] = NULL;
+  }
+  if (error > 0) {
+    if (md->info_level) {
+      fprintf(stderr, "\nStored tracer does not apply, learning a new one.\n");
+    }
+    free_trace(&(md->tr));
+    md->trace_level = NO_TRACER;
+    md->f4_qq_round = 1;
+    *tr_loaded = 0;
+    bs = core_gba(gbg, md, &error, fc);
+  }
 
   md->learning_rtime = realtime()-rt;
   print_tracer_statistics(stdout, rt, md);
@@ -1645,7 +1906,7 @@ static int32_t *initial_modular_step(
                     *bsz, *nlins_ptr, linvars, lineqs_ptr[0], squvars,
                     md->info_level, bdata_fglm, bdata_bms, success, md);
         }
-        free_basis_without_hash_table(&(bs));
+        free_initial_basis(&bs, gbg);
         *dim = 0;
         *dquot_ori = dquot;
         return lmb;
@@ -1653,7 +1914,7 @@ static int32_t *initial_modular_step(
     else{
         *dim  = 1;
         *dquot_ori = -1;
-        free_basis_without_hash_table(&(bs));
+        free_initial_basis(&bs, gbg);
         return NULL;
     }
 }
@@ -1661,150 +1922,126 @@ static int32_t *initial_modular_step(
 
 
 
-static void secondary_modular_steps(sp_matfglm_t **bmatrix,
-				    int32_t **bdiv_xn,
-				    int32_t **blen_gb_xn,
-				    int32_t **bstart_cf_gb_xn,
-				    long **bextra_nf,
-				    int32_t **blens_extra_nf,
-				    int32_t **bexps_extra_nf,
-				    int32_t **bcfs_extra_nf,
-
-				    nvars_t *bnlins,
-				    nvars_t **blinvars,
-				    uint32_t **blineqs,
-				    nvars_t **bsquvars,
-
-				    fglm_data_t **bdata_fglm,
-				    fglm_bms_data_t **bdata_bms,
-
-				    int32_t *num_gb,
-				    int32_t **leadmons_ori,
-				    int32_t **leadmons_current,
-
-				    uint64_t bsz,
-				    param_t **nmod_params,
-				    /* trace_t **btrace, */
-				    bs_t *bs_qq,
-				    md_t *st,
-				    const int32_t fc,
-				    const int32_t unstable_staircase,
-				    int info_level,
-				    bs_t **bs,
-				    int32_t *lmb_ori,
-				    int32_t dquot_ori,
-				    primes_t *lp,
-				    data_gens_ff_t *gens,
-				    double *stf4,
-				    const long nbsols,
-				    uint32_t *bad_primes,
-                    trace_det_fglm_mat_t trace_det) {
-    st->info_level  = 0;
-    st->f4_qq_round = 2;
+/* Applies the learnt trace modulo the prime stored in lp->p[i] and computes
+ * the corresponding modular parametrization in slot i. bad_primes[i] is set
+ * to 1 if the prime turns out to be unlucky. If lifted is nonzero, the
+ * multiplication matrix and the linear forms are already known over the
+ * rationals and are only reduced modulo the prime. */
+static void secondary_modular_step(sp_matfglm_t **bmatrix,
+				   int32_t **bdiv_xn,
+				   int32_t **blen_gb_xn,
+				   int32_t **bstart_cf_gb_xn,
+				   long **bextra_nf,
+				   int32_t **blens_extra_nf,
+				   int32_t **bexps_extra_nf,
+				   int32_t **bcfs_extra_nf,
+
+				   nvars_t *bnlins,
+				   nvars_t **blinvars,
+				   uint32_t **blineqs,
+				   nvars_t **bsquvars,
+
+				   fglm_data_t **bdata_fglm,
+				   fglm_bms_data_t **bdata_bms,
+
+				   int32_t *num_gb,
+				   int32_t **leadmons_ori,
+				   int32_t **leadmons_current,
+
+				   uint64_t bsz,
+				   param_t **nmod_params,
+				   bs_t *bs_qq,
+				   md_t *st,
+				   int info_level,
+				   bs_t **bs,
+				   int32_t *lmb_ori,
+				   int32_t dquot_ori,
+				   primes_t *lp,
+				   double *stf4,
+				   const long nbsols,
+				   uint32_t *bad_primes,
+				   trace_det_fglm_mat_t trace_det,
+				   const len_t i,
+				   const int lifted) {
+  double rt = realtime();
+  int32_t error = 0;
 
-    double rt = realtime();
-    /* tracing phase */
-    len_t i;
-    int32_t error = 0;
-
-    /* F4 and FGLM are run using a single thread */
-    /* st->nthrds is reset to its original value afterwards */
-    const int nthrds = st->nthrds;
-    st->nthrds = 1;
-    for(nvars_t i = 0; i < st->nprimes; i++){
-      bad_primes[i] = 0;
-    }
-#pragma omp parallel for num_threads(nthrds)  \
-    private(i) schedule(static)
-    for (i = 0; i < st->nprimes; ++i){
-      if (trace_det->mat_lifted < 2 || trace_det->lin_lifted < 2) {
-        bs[i] = core_gba(bs_qq, st, &error, lp->p[i]);
-        *stf4 = realtime()-rt;
-        /* printf("F4 trace timing %13.2f\n", *stf4); */
-
-        if (error > 0) {
-            if (bs[i] != NULL) {
-                free(bs[i]);
-                bs[i] = NULL;
-            }
-            nmod_params[i] = NULL;
-            bad_primes[i] = 1;
-            continue;
-        }
-        int32_t lml = bs[i]->lml;
-        if (st->nev > 0) {
-            int32_t j = 0;
-            for (len_t k = 0; k < bs[i]->lml; ++k) {
-                if (bs[i]->ht->ev[bs[i]->hm[bs[i]->lmps[k]][OFFSET]][0] == 0) {
-                    bs[i]->lm[j]   = bs[i]->lm[k];
-                    bs[i]->lmps[j] = bs[i]->lmps[k];
-                    ++j;
-                }
-            }
-            lml = j;
-        }
-        if(lml != num_gb[i]){
-            if (bs[i] != NULL) {
-                free_basis(&(bs[i]));
-            }
-            /* nmod_params[i] = NULL; */
-            bad_primes[i] = 1;
-            continue;
-            /* return; */
-        }
-        get_lm_from_bs_trace(bs[i], bs[i]->ht, leadmons_current[i]);
+  bad_primes[i] = 0;
+  *stf4 = 0;
+  if (lifted == 0) {
+    bs[i] = core_gba(bs_qq, st, &error, lp->p[i]);
+    *stf4 = realtime()-rt;
+
+    if (error > 0) {
+      if (bs[i] != NULL) {
+        free(bs[i]);
+        bs[i] = NULL;
       }
-      if (trace_det->mat_lifted == 2 && trace_det->lin_lifted == 2) {
-        compute_modular_linear_forms(bnlins[i], bs_qq->ht->nv + 1, blineqs[i],
-                                   trace_det->mpz_linear_forms, lp->p[i]);
-        compute_modular_matrix(bmatrix[i], trace_det, lp->p[i]);
-    } else {
-      if (equal_staircase(leadmons_current[i], leadmons_ori[i], num_gb[i],
-                          num_gb[i], bs[i]->ht->nv)) {
-
-          set_linear_poly(bnlins[i], blineqs[i], blinvars[i], bs[i]->ht,
-                    leadmons_current[i], bs[i]);
-	    /* build_matrixn_from_bs_trace_application(bmatrix[i], */
-	    /* 					    div_xn[i], */
-	    /* 					    len_gb_xn[i], */
-	    /* 					    start_cf_gb_xn[i], */
-	    /* 					    lmb_ori, dquot_ori, bs[i], bs[i]->ht, */
-	    /* 					    leadmons_ori[i], bs[i]->ht->nv, */
-	    /* 					    lp->p[i]); */
-	       build_matrixn_unstable_from_bs_trace_application(bmatrix[i],
-							     bdiv_xn[i],
-							     blen_gb_xn[i],
-							     bstart_cf_gb_xn[i],
-							     bextra_nf[i],
-							     blens_extra_nf[i],
-							     bexps_extra_nf[i],
-							     bcfs_extra_nf[i],
-							     lmb_ori, dquot_ori, bs[i], bs[i]->ht,
-							     leadmons_ori[i], st, bs[i]->ht->nv,
-							     lp->p[i],i);
-        }
-        else{
-            bad_primes[i] = 1;
-            }
-     }
-        if(nmod_fglm_compute_apply_trace_data(bmatrix[i], lp->p[i],
-                                              nmod_params[i],
-                                              bs_qq->ht->nv,
-                                              bsz,
-                                              bnlins[i], blinvars[i], blineqs[i],
-                                              bsquvars[i],
-                                              bdata_fglm[i],
-                                              bdata_bms[i],
-                                              nbsols,
-                                              info_level,
-                                              st)){
-                bad_primes[i] = 1;
-            }
-        if (bs[i] != NULL) {
-            free_basis_and_only_local_hash_table_data(&(bs[i]));
+      bad_primes[i] = 1;
+      return;
+    }
+    int32_t lml = bs[i]->lml;
+    if (st->nev > 0) {
+      int32_t j = 0;
+      for (len_t k = 0; k < bs[i]->lml; ++k) {
+        if (bs[i]->ht->ev[bs[i]->hm[bs[i]->lmps[k]][OFFSET]][0] == 0) {
+          bs[i]->lm[j]   = bs[i]->lm[k];
+          bs[i]->lmps[j] = bs[i]->lmps[k];
+          ++j;
         }
+      }
+      lml = j;
     }
-  st->nthrds = nthrds;
+    if (lml != num_gb[i]) {
+      if (bs[i] != NULL) {
+        free_basis(&(bs[i]));
+      }
+      bad_primes[i] = 1;
+      return;
+    }
+    get_lm_from_bs_trace(bs[i], bs[i]->ht, leadmons_current[i]);
+    if (equal_staircase(leadmons_current[i], leadmons_ori[i], num_gb[i],
+                        num_gb[i], bs[i]->ht->nv)) {
+
+      set_linear_poly(bnlins[i], blineqs[i], blinvars[i], bs[i]->ht,
+                      leadmons_current[i], bs[i]);
+      build_matrixn_unstable_from_bs_trace_application(bmatrix[i],
+                                                       bdiv_xn[i],
+                                                       blen_gb_xn[i],
+                                                       bstart_cf_gb_xn[i],
+                                                       bextra_nf[i],
+                                                       blens_extra_nf[i],
+                                                       bexps_extra_nf[i],
+                                                       bcfs_extra_nf[i],
+                                                       lmb_ori, dquot_ori, bs[i], bs[i]->ht,
+                                                       leadmons_ori[i], st, bs[i]->ht->nv,
+                                                       lp->p[i],i);
+    }
+    else{
+      bad_primes[i] = 1;
+    }
+  } else {
+    compute_modular_linear_forms(bnlins[i], bs_qq->ht->nv + 1, blineqs[i],
+                                 trace_det->mpz_linear_forms, lp->p[i]);
+    compute_modular_matrix(bmatrix[i], trace_det, lp->p[i]);
+  }
+  if (bad_primes[i] == 0 &&
+      nmod_fglm_compute_apply_trace_data(bmatrix[i], lp->p[i],
+                                         nmod_params[i],
+                                         bs_qq->ht->nv,
+                                         bsz,
+                                         bnlins[i], blinvars[i], blineqs[i],
+                                         bsquvars[i],
+                                         bdata_fglm[i],
+                                         bdata_bms[i],
+                                         nbsols,
+                                         info_level,
+                                         st)){
+    bad_primes[i] = 1;
+  }
+  if (bs[i] != NULL) {
+    free_basis_and_only_local_hash_table_data(&(bs[i]));
+  }
 }
 
 
@@ -1874,6 +2111,249 @@ static inline int is_lucky_matmul_prime_ui(uint32_t prime,
   return 0;
 }
 
+/* returns the next prime after prime which is lucky for bs_qq and differs
+ * from primeinit; if matmul is nonzero, primes dividing the denominators of
+ * the lifted multiplication matrix are skipped as well */
+static inline uint32_t next_trace_prime(uint32_t prime,
+        const uint32_t primeinit, const uint32_t lprime,
+        bs_t *bs_qq, trace_det_fglm_mat_t trace_det, const int matmul) {
+  do {
+    prime = next_prime(prime);
+    if (prime >= lprime) {
+      prime = next_prime(1 << 30);
+    }
+  } while (is_lucky_prime_ui(prime, bs_qq) || prime == primeinit ||
+           (matmul && is_lucky_matmul_prime_ui(prime, trace_det)));
+  return prime;
+}
+
+/* minimal elapsed time (in seconds) of a prime in the trace application
+ * pipeline for giving several threads to a prime */
+#define PIPELINE_SPLIT_MIN_TIME 0.5
+
+/* Returns the number of threads given to the next prime of the trace
+ * application pipeline, free_cores being the number of cores not used by
+ * the primes in flight. As long as many primes are still needed, the
+ * throughput is best with a single thread per prime. Otherwise, the free
+ * cores are shared among the primes which are still expected, these then
+ * use the parallel linear algebra of F4 and the parallel sequence
+ * generation of FGLM. needed is the number of primes still expected (-1 if
+ * unknown), inflight the number of primes launched but not yet merged and
+ * mean_rt the mean elapsed time of the primes computed so far. */
+static inline int pipeline_threads_per_prime(const int free_cores,
+                                             const long needed,
+                                             const long inflight,
+                                             const double mean_rt){
+  if (free_cores <= 1 || needed < 0 || mean_rt < PIPELINE_SPLIT_MIN_TIME) {
+    return 1;
+  }
+  const long left = MAX(1, needed - inflight);
+  if (left >= free_cores) {
+    return 1;
+  }
+  return free_cores / left;
+}
+
+/* Threads of the trace pipeline which find neither a free core nor the
+ * reconstruction idle block until another thread frees cores or slots,
+ * leaves the reconstruction or stops the pipeline. Each of these events
+ * increments nev, a waiting thread sleeps until nev differs from the value
+ * it saw when it looked for work. */
+typedef struct {
+  long nev;
+#ifdef _OPENMP
+  pthread_mutex_t mtx;
+  pthread_cond_t cond;
+#endif
+} pipeline_wait_t;
+
+static void pipeline_wait_init(pipeline_wait_t *pw){
+  pw->nev = 0;
+#ifdef _OPENMP
+  pthread_mutex_init(&pw->mtx, NULL);
+  pthread_cond_init(&pw->cond, NULL);
+#endif
+}
+
+static void pipeline_wait_clear(pipeline_wait_t *pw){
+#ifdef _OPENMP
+  pthread_mutex_destroy(&pw->mtx);
+  pthread_cond_destroy(&pw->cond);
+#endif
+}
+
+static long pipeline_events(pipeline_wait_t *pw){
+#ifdef _OPENMP
+  pthread_mutex_lock(&pw->mtx);
+  const long n = pw->nev;
+  pthread_mutex_unlock(&pw->mtx);
+  return n;
+#else
+  return pw->nev;
+#endif
+}
+
+static void pipeline_signal(pipeline_wait_t *pw){
+#ifdef _OPENMP
+  pthread_mutex_lock(&pw->mtx);
+  pw->nev++;
+  pthread_cond_broadcast(&pw->cond);
+  pthread_mutex_unlock(&pw->mtx);
+#else
+  pw->nev++;
+#endif
+}
+
+static void pipeline_wait(pipeline_wait_t *pw, const long seen){
+#ifdef _OPENMP
+  pthread_mutex_lock(&pw->mtx);
+  while (pw->nev == seen) {
+    pthread_cond_wait(&pw->cond, &pw->mtx);
+  }
+  pthread_mutex_unlock(&pw->mtx);
+#endif
+}
+
+/* Tracer files: the F4 tracer learned in initial_modular_step, written by
+ * write_trace() together with the basis hash table, followed by the
+ * staircase found for the learning prime, i.e. num_gb, the leading
+ * monomials, dquot and the monomial basis lmb. */
+static int write_tracer_data(FILE *f, const md_t *st, const bs_t *bs_qq,
+                             const int32_t num_gb, const int32_t *leadmons,
+                             const long dquot, const int32_t *lmb){
+  const int32_t nv = bs_qq->ht->nv;
+  const int64_t dq = dquot;
+  return write_trace(f, st->tr, bs_qq) == 0
+    && fwrite(&num_gb, sizeof(int32_t), 1, f) == 1
+    && fwrite(leadmons, sizeof(int32_t), num_gb * nv, f) == (size_t)num_gb * nv
+    && fwrite(&dq, sizeof(int64_t), 1, f) == 1
+    && fwrite(lmb, sizeof(int32_t), dq * nv, f) == (size_t)dq * nv;
+}
+
+/* number of bytes between the current position of f and its end */
+static int64_t tracer_bytes_left(FILE *f){
+  const long pos = ftell(f);
+  if(pos < 0 || fseek(f, 0, SEEK_END) != 0){
+    return 0;
+  }
+  const long end = ftell(f);
+  if(fseek(f, pos, SEEK_SET) != 0 || end < pos){
+    return 0;
+  }
+  return (int64_t)(end - pos);
+}
+
+/* Reads tracer data into st and bs_qq->ht. On success st applies the
+ * tracer from the first prime on and the stored staircase is returned in
+ * num_gb, leadmons, dquot and lmb. Returns 0 if the data does not fit the
+ * input system, the tracer is then learned as usual. */
+static int read_tracer_data(FILE *f, md_t *st, bs_t *bs_qq,
+                            int32_t *num_gb, int32_t **leadmons,
+                            long *dquot, int32_t **lmb){
+  const int64_t nv = bs_qq->ht->nv;
+  int64_t dq = 0;
+  int ok = 0;
+  trace_t *tr = read_trace(f, bs_qq);
+  if(tr != NULL && fread(num_gb, sizeof(int32_t), 1, f) == 1 && *num_gb > 0
+     && nv > 0){
+    /* the staircase cannot be longer than the rest of the file */
+    const int64_t left = tracer_bytes_left(f) / (int64_t)sizeof(int32_t);
+    const int64_t nlm = (int64_t)(*num_gb) * nv;
+    if(nlm <= left){
+      *leadmons = malloc(sizeof(int32_t) * nlm);
+    }
+    ok = *leadmons != NULL
+      && fread(*leadmons, sizeof(int32_t), nlm, f) == (size_t)nlm
+      && fread(&dq, sizeof(int64_t), 1, f) == 1 && dq >= 0
+      && dq <= (left - nlm) / nv;
+    if(ok){
+      *lmb = malloc(sizeof(int32_t) * (dq * nv + 1));
+      ok = *lmb != NULL
+        && fread(*lmb, sizeof(int32_t), dq * nv, f) == (size_t)(dq * nv);
+    }
+  }
+  if(!ok){
+    free_trace(&tr);
+    free(*leadmons);
+    free(*lmb);
+    *leadmons = NULL;
+    *lmb = NULL;
+    return 0;
+  }
+  *dquot = dq;
+  st->tr = tr;
+  st->trace_level = APPLY_TRACER;
+  return 1;
+}
+
+/* A tracer is read from files->trace_file, or from files->trace_stream
+ * if the latter already holds a tracer, see msolve_julia_batch. */
+static int load_tracer(files_gb *files, md_t *st, bs_t *bs_qq,
+                       int32_t *num_gb, int32_t **leadmons,
+                       long *dquot, int32_t **lmb){
+  int ok = 0;
+  if(files->trace_file != NULL){
+    FILE *f = fopen(files->trace_file, "rb");
+    if(f == NULL){
+      fprintf(stderr, "Cannot open tracer file %s\n", files->trace_file);
+      return 0;
+    }
+    ok = read_tracer_data(f, st, bs_qq, num_gb, leadmons, dquot, lmb);
+    fclose(f);
+    if(!ok){
+      fprintf(stderr, "Tracer file %s does not fit the input system, ",
+              files->trace_file);
+      fprintf(stderr, "learning a new tracer.\n");
+    }
+  }
+  else{
+    if(files->trace_stream != NULL){
+      FILE *f = files->trace_stream;
+      fseek(f, 0, SEEK_END);
+      if(ftell(f) > 0){
+        rewind(f);
+        ok = read_tracer_data(f, st, bs_qq, num_gb, leadmons, dquot, lmb);
+      }
+    }
+  }
+  if(ok && st->info_level){
+    fprintf(stderr, "Tracer loaded (%u rounds)\n", st->tr->ltd);
+  }
+  return ok;
+}
+
+/* Writes the tracer to files->trace_out_file, resp. to an empty
+ * files->trace_stream. */
+static void save_tracer(files_gb *files, const md_t *st, const bs_t *bs_qq,
+                        const int32_t num_gb, const int32_t *leadmons,
+                        const long dquot, const int32_t *lmb){
+  if(files->trace_out_file != NULL){
+    FILE *f = fopen(files->trace_out_file, "wb");
+    if(f == NULL){
+      fprintf(stderr, "Cannot open tracer file %s\n", files->trace_out_file);
+      return;
+    }
+    int ok = write_tracer_data(f, st, bs_qq, num_gb, leadmons, dquot, lmb);
+    fclose(f);
+    if(!ok){
+      fprintf(stderr, "Could not write tracer to %s\n", files->trace_out_file);
+    }
+    else if(st->info_level){
+      fprintf(stderr, "Tracer written to %s\n", files->trace_out_file);
+    }
+  }
+  if(files->trace_stream != NULL){
+    FILE *f = files->trace_stream;
+    fseek(f, 0, SEEK_END);
+    if(ftell(f) == 0 &&
+       !write_tracer_data(f, st, bs_qq, num_gb, leadmons, dquot, lmb)){
+      /* an incomplete tracer is rejected when it is read */
+      fprintf(stderr, "Could not store tracer\n");
+    }
+    fflush(f);
+  }
+}
+
 /*
 
   - renvoie 0 si le calcul est ok.
@@ -1963,6 +2443,10 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
     return -3;
   }
 
+  /* the multi-modular computations are pipelined over more slots than
+   * threads, so that workers do not wait for the rational reconstruction */
+  const int nslots = 2 * st->nthrds;
+
   /* lucky primes */
   primes_t *lp = (primes_t *)calloc(st->nthrds, sizeof(primes_t));
 
@@ -1988,7 +2472,7 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
   if (gens->field_char == 0) {
     remove_content_of_initial_basis(bs_qq);
     /* generate lucky prime numbers */
-    generate_lucky_primes(lp, bs_qq, st->prime_start, st->nthrds);
+    generate_lucky_primes(lp, bs_qq, st->prime_start, nslots);
   } else {
     lp->old = 0;
     lp->ld = 1;
@@ -1997,12 +2481,12 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
   }
 
   /* generate array to store modular bases */
-  bs_t **bs = (bs_t **)malloc((unsigned long)st->nthrds * sizeof(bs_t *));
+  bs_t **bs = (bs_t **)calloc((unsigned long)nslots, sizeof(bs_t *));
 
   param_t **nmod_params =
-      (param_t **)malloc((unsigned long)st->nthrds * sizeof(param_t *));
+      (param_t **)malloc((unsigned long)nslots * sizeof(param_t *));
 
-  uint32_t *bad_primes = calloc((unsigned long)st->nthrds, sizeof(uint32_t));
+  uint32_t *bad_primes = calloc((unsigned long)nslots, sizeof(uint32_t));
 
   uint32_t prime = 0;
   uint32_t primeinit = 0;
@@ -2019,24 +2503,24 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
     lp->p[0] = gens->field_char;
   }
   sp_matfglm_t **bmatrix =
-      (sp_matfglm_t **)malloc(st->nthrds * sizeof(sp_matfglm_t *));
+      (sp_matfglm_t **)malloc(nslots * sizeof(sp_matfglm_t *));
 
-  int32_t **bdiv_xn = (int32_t **)malloc(st->nthrds * sizeof(int32_t *));
-  int32_t **blen_gb_xn = (int32_t **)malloc(st->nthrds * sizeof(int32_t *));
-  int32_t **bstart_cf_gb_xn = (int32_t **)malloc(st->nthrds * sizeof(int32_t *));
-  long **bextra_nf = (long **)malloc(st->nthrds * sizeof(long *));
-  int32_t **blens_extra_nf = (int32_t **)malloc(st->nthrds * sizeof(int32_t *));
-  int32_t **bexps_extra_nf = (int32_t **)malloc(st->nthrds * sizeof(int32_t *));
-  int32_t **bcfs_extra_nf = (int32_t **)malloc(st->nthrds * sizeof(int32_t *));
+  int32_t **bdiv_xn = (int32_t **)malloc(nslots * sizeof(int32_t *));
+  int32_t **blen_gb_xn = (int32_t **)malloc(nslots * sizeof(int32_t *));
+  int32_t **bstart_cf_gb_xn = (int32_t **)malloc(nslots * sizeof(int32_t *));
+  long **bextra_nf = (long **)malloc(nslots * sizeof(long *));
+  int32_t **blens_extra_nf = (int32_t **)malloc(nslots * sizeof(int32_t *));
+  int32_t **bexps_extra_nf = (int32_t **)malloc(nslots * sizeof(int32_t *));
+  int32_t **bcfs_extra_nf = (int32_t **)malloc(nslots * sizeof(int32_t *));
 
   fglm_data_t **bdata_fglm =
-      (fglm_data_t **)malloc(st->nthrds * sizeof(fglm_data_t *));
+      (fglm_data_t **)malloc(nslots * sizeof(fglm_data_t *));
   fglm_bms_data_t **bdata_bms =
-      (fglm_bms_data_t **)malloc(st->nthrds * sizeof(fglm_bms_data_t *));
-  int32_t *num_gb = (int32_t *)calloc(st->nthrds, sizeof(int32_t));
-  int32_t **leadmons_ori = (int32_t **)malloc(st->nthrds * sizeof(int32_t *));
+      (fglm_bms_data_t **)malloc(nslots * sizeof(fglm_bms_data_t *));
+  int32_t *num_gb = (int32_t *)calloc(nslots, sizeof(int32_t));
+  int32_t **leadmons_ori = (int32_t **)malloc(nslots * sizeof(int32_t *));
   int32_t **leadmons_current =
-      (int32_t **)malloc(st->nthrds * sizeof(int32_t *));
+      (int32_t **)malloc(nslots * sizeof(int32_t *));
 
   uint64_t bsz = 0;
 
@@ -2044,16 +2528,16 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
 
   /* data for linear forms */
   nvars_t nlins = 0; /*number of linear forms*/
-  nvars_t *bnlins = (nvars_t *)calloc(st->nthrds, sizeof(nvars_t));
+  nvars_t *bnlins = (nvars_t *)calloc(nslots, sizeof(nvars_t));
   nvars_t **blinvars = (nvars_t **)malloc(
-      st->nthrds * sizeof(nvars_t *)); /*indicates which variables are linear*/
+      nslots * sizeof(nvars_t *)); /*indicates which variables are linear*/
   nvars_t *linvars = calloc(bs_qq->ht->nv, sizeof(nvars_t));
   blinvars[0] = linvars;
   uint32_t **lineqs_ptr =
-      malloc(st->nthrds * sizeof(uint32_t *)); /*coeffs of linear forms*/
+      malloc(nslots * sizeof(uint32_t *)); /*coeffs of linear forms*/
 
   /*data for squared variables*/
-  nvars_t **bsquvars = (nvars_t **)malloc(st->nthrds * sizeof(nvars_t *));
+  nvars_t **bsquvars = (nvars_t **)malloc(nslots * sizeof(nvars_t *));
   nvars_t *squvars = calloc(nr_vars - 1, sizeof(nvars_t));
   bsquvars[0] = squvars;
 
@@ -2063,6 +2547,17 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
   int success = 1;
   int squares = 1;
 
+  /* staircase stored together with a tracer read from file */
+  int32_t tr_num_gb = 0;
+  int32_t *tr_leadmons = NULL;
+  long tr_dquot = 0;
+  int32_t *tr_lmb = NULL;
+  int tr_loaded = 0;
+  if (files != NULL && print_gb == 0) {
+    tr_loaded = load_tracer(files, st, bs_qq, &tr_num_gb,
+                            &tr_leadmons, &tr_dquot, &tr_lmb);
+  }
+
   int32_t *lmb_ori = initial_modular_step(bmatrix, bdiv_xn, blen_gb_xn,
 					  bstart_cf_gb_xn,
 					  bextra_nf,
@@ -2085,6 +2580,7 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
 					  dim_ptr, dquot_ptr,
 					  gens,
 					  files,
+					  &tr_loaded, tr_num_gb, tr_leadmons,
 					  &success);
 
   if (*dim_ptr == 0 && success && *dquot_ptr > 0 && print_gb == 0) {
@@ -2101,6 +2597,17 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
   (*mpz_paramp)->dim = *dim_ptr;
   (*mpz_paramp)->dquot = *dquot_ptr;
 
+  /* a tracer learned here, also in place of a stored one that did not
+   * apply, is stored */
+  if (lmb_ori != NULL && success) {
+    if (files != NULL && !tr_loaded) {
+      save_tracer(files, st, bs_qq, num_gb[0],
+                  leadmons_ori[0], *dquot_ptr, lmb_ori);
+    }
+  }
+  free(tr_leadmons);
+  free(tr_lmb);
+
   if (lmb_ori == NULL || success == 0 || print_gb || gens->field_char) {
     free(bs);
     if (gens->field_char == 0) {
@@ -2154,7 +2661,7 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
   }
 
   /* duplicate data for multi-threaded multi-mod computation */
-  duplicate_data_mthread_trace(st->nthrds, bs_qq, st, num_gb,
+  duplicate_data_mthread_trace(nslots, bs_qq, st, num_gb,
                               leadmons_ori, leadmons_current,
                                bdata_bms, bdata_fglm,
                                bstart_cf_gb_xn, blen_gb_xn, bdiv_xn,
@@ -2203,6 +2710,8 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
   mpz_init_set_ui(modulus, primeinit);
   mpz_t prod_crt;
   mpz_init_set_ui(prod_crt, primeinit);
+  /* images waiting to be merged by the batched CRT */
+  crt_images_t crtim;
 
   mpq_t result, test;
   mpq_init(result);
@@ -2213,6 +2722,7 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
   mpz_init(rden);
   mpz_set_ui(rden, 1);
   set_mpz_param_nmod(tmp_mpz_param, nmod_params[0]);
+  crt_images_init(crtim, tmp_mpz_param, trace_det, modulus);
 
   deg_t nsols = tmp_mpz_param->nsols;
 
@@ -2246,11 +2756,10 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
   if(nlins == 0){
       lin_lifted = 2;
   }
-  int nbdoit = 1;
-  int doit = 1;
-  int prdone = 0;
-  int lpow2 = 1;
+  int doit = RREC_FULL;
   int clog = 0;
+  rrec_sched_t rsched;
+  rrec_sched_init(rsched);
   int br = 0;
 
   rrec_data_t recdata;
@@ -2259,156 +2768,240 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
   /* measures time spent in rational reconstruction */
   double strat = 0;
 
-  while (rerun == 1 || mcheck == 1) {
-    /* controls call to rational reconstruction */
-    doit = ((prdone % nbdoit) == 0);
+  /* Prime pipeline: each thread repeatedly takes a free slot, applies the
+   * trace modulo a new lucky prime in this slot and marks it as ready. The
+   * thread which finds the reconstruction idle then merges all ready slots,
+   * in launch order, into the CRT and rational reconstruction data, so that
+   * slow primes and reconstruction steps do not stall the other threads.
+   * slot_state[i] is 0 for a free slot, 1 while slot i is computed and 2
+   * once its modular parametrization is ready. */
+  int *slot_state = (int *)calloc(nslots, sizeof(int));
+  long *slot_seq = (long *)calloc(nslots, sizeof(long));
+  int *slot_lifted = (int *)calloc(nslots, sizeof(int));
+  double *slot_rt = (double *)calloc(nslots, sizeof(double));
+  double *slot_f4 = (double *)calloc(nslots, sizeof(double));
+  long nlaunched = 0;
+  int done = 0;
+  int recon_busy = 0;
+  int ret = 0;
+  /* published by the reconstruction thread once the multiplication matrix,
+   * resp. the matrix and the linear forms, are lifted over the rationals */
+  int matmul_lifted = 0;
+  int all_lifted = 0;
+
+  /* Cores are shared between the primes in flight: a prime takes
+   * slot_thrds[i] of the free cores and runs F4 and FGLM with as many
+   * threads, see pipeline_threads_per_prime. Nested parallel regions are
+   * enabled for that purpose, the reconstruction thread lifts with a single
+   * thread as before. The number of primes still
+   * needed is unknown until the trace of the multiplication matrix is
+   * reconstructed; from then on it is estimated as twice the number of
+   * primes this took. Once the parametrization is reconstructed, only the
+   * checking prime is needed. */
+  int *slot_thrds = (int *)calloc(nslots, sizeof(int));
+  int free_cores = st->nthrds;
+  long nmerged = 0;
+  long trace_primes = 0;
+  int rec_done = 0;
+  double merged_rt = 0;
+
+  /* st->nthrds is reset to its original value afterwards */
+  const int nthrds = st->nthrds;
+  st->nthrds = 1;
+  st->info_level  = 0;
+  st->f4_qq_round = 2;
+  const double pstart = realtime();
+  pipeline_wait_t pwait;
+  pipeline_wait_init(&pwait);
+#ifdef _OPENMP
+  const int max_levels = omp_get_max_active_levels();
+  omp_set_max_active_levels(2);
+#endif
 
-    /* generate lucky prime numbers */
-    prime = next_prime(prime);
-    if (prime >= lprime) {
-      prime = next_prime(1 << 30);
-    }
-    lp->p[0] = prime;
-    while (is_lucky_prime_ui(prime, bs_qq) || prime == primeinit) {
-      prime = next_prime(prime);
-      if (prime >= lprime) {
-        prime = next_prime(1 << 30);
+#pragma omp parallel num_threads(nthrds)
+  while (1) {
+    int slot = -1;
+    int stop = 0;
+    int recon = 0;
+    /* each prime works on its own copy of the meta data: F4 sets the
+     * number of threads and writes the application statistics into it */
+    md_t wst;
+    long seen;
+#pragma omp critical(trace_pipeline)
+    {
+      seen = pipeline_events(&pwait);
+      stop = done;
+      if (stop == 0 && free_cores > 0) {
+        for (int k = 0; k < nslots; ++k) {
+          if (slot_state[k] == 0) {
+            slot = k;
+            break;
+          }
+        }
+        if (slot >= 0) {
+          long needed = -1;
+          if (rec_done) {
+            needed = 1;
+          } else if (trace_primes > 0) {
+            needed = MAX(1, 2 * trace_primes - nmerged);
+          }
+          slot_thrds[slot] = pipeline_threads_per_prime(
+              free_cores, needed, nlaunched - nmerged,
+              nmerged > 0 ? merged_rt / nmerged : 0);
+          free_cores -= slot_thrds[slot];
+          slot_state[slot] = 1;
+          slot_seq[slot] = nlaunched++;
+          slot_lifted[slot] = all_lifted;
+          prime = next_trace_prime(prime, primeinit, lprime, bs_qq, trace_det,
+                                   trace_det->lift_matrix && matmul_lifted);
+          lp->p[slot] = prime;
+        }
       }
-      lp->p[0] = prime;
     }
-
-    for (len_t i = 1; i < st->nthrds; i++) {
-      prime = next_prime(prime);
-      if (prime >= lprime) {
-        prime = next_prime(1 << 30);
+    if (stop) {
+      break;
+    }
+    if (slot >= 0) {
+      double ca0 = realtime();
+      wst = *st;
+      wst.nthrds = slot_thrds[slot];
+      secondary_modular_step(bmatrix,
+                             bdiv_xn,
+                             blen_gb_xn,
+                             bstart_cf_gb_xn,
+                             bextra_nf,
+                             blens_extra_nf,
+                             bexps_extra_nf,
+                             bcfs_extra_nf,
+
+                             bnlins,
+                             blinvars,
+                             lineqs_ptr,
+                             bsquvars,
+
+                             bdata_fglm,
+                             bdata_bms,
+                             num_gb,
+                             leadmons_ori,
+                             leadmons_current,
+
+                             bsz,
+                             nmod_params,
+                             bs_qq, &wst,
+                             0, /* info_level, */
+                             bs, lmb_ori, *dquot_ptr, lp,
+                             slot_f4 + slot, nsols, bad_primes,
+                             trace_det, slot, slot_lifted[slot]);
+      slot_rt[slot] = realtime() - ca0;
+    }
+#pragma omp critical(trace_pipeline)
+    {
+      if (slot >= 0) {
+        slot_state[slot] = 2;
+        free_cores += slot_thrds[slot];
+        /* statistics of the first prime are printed by the reconstruction */
+        if (slot_seq[slot] == 0) {
+          st->application_nr_add = wst.application_nr_add;
+          st->application_nr_mult = wst.application_nr_mult;
+          st->application_nr_red = wst.application_nr_red;
+        }
       }
-      lp->p[i] = prime;
-      if(trace_det->lift_matrix){
-          while (is_lucky_prime_ui(prime, bs_qq) || prime == primeinit ||
-             is_lucky_matmul_prime_ui(prime, trace_det)) {
-              prime = next_prime(prime);
-              if (prime >= lprime) {
-                  prime = next_prime(1 << 30);
-              }
-              lp->p[i] = prime;
-          }
+      if (recon_busy == 0) {
+        recon_busy = 1;
+        recon = 1;
+      }
+    }
+    if (slot >= 0) {
+      pipeline_signal(&pwait);
+    }
+    if (recon == 0) {
+      if (slot < 0) {
+        /* the cores are used by primes with several threads */
+        pipeline_wait(&pwait, seen);
       }
-      else{
-        while (is_lucky_prime_ui(prime, bs_qq) || prime == primeinit) {
-          prime = next_prime(prime);
-          if (prime >= lprime) {
-            prime = next_prime(1 << 30);
+      continue;
+    }
+    /* this thread is now in charge of the reconstruction */
+    while (1) {
+      int k = -1;
+#pragma omp critical(trace_pipeline)
+      {
+        if (done == 0) {
+          for (int l = 0; l < nslots; ++l) {
+            if (slot_state[l] == 2 &&
+                (k == -1 || slot_seq[l] < slot_seq[k])) {
+              k = l;
+            }
           }
-          lp->p[i] = prime;
         }
       }
-    }
-    prime = lp->p[st->nthrds - 1];
-
-    double ca0 = realtime();
-    double stf4 = 0;
-    secondary_modular_steps(bmatrix,
-			    bdiv_xn,
-			    blen_gb_xn,
-			    bstart_cf_gb_xn,
-			    bextra_nf,
-			    blens_extra_nf,
-			    bexps_extra_nf,
-			    bcfs_extra_nf,
-
-			    bnlins,
-			    blinvars,
-			    lineqs_ptr,
-			    bsquvars,
-
-			    bdata_fglm,
-			    bdata_bms,
-			    num_gb,
-			    leadmons_ori,
-			    leadmons_current,
-
-			    bsz,
-			    nmod_params, /* btrace, */
-			    bs_qq, st,
-			    field_char, unstable_staircase, 0, /* info_level, */
-			    bs, lmb_ori, *dquot_ptr, lp,
-			    gens, &stf4, nsols, bad_primes,
-                trace_det);
-    double ca1 = realtime() - ca0;
-
-    if (nprimes == 1) {
-      if (info_level > 2) {
-        fprintf(stderr, "------------------------------------------\n");
-        fprintf(stderr, "#ADDITIONS       %13lu\n",
-                (unsigned long)st->application_nr_add * 1000);
-        fprintf(stderr, "#MULTIPLICATIONS %13lu\n",
-                (unsigned long)st->application_nr_mult * 1000);
-        fprintf(stderr, "#REDUCTIONS      %13lu\n",
-                (unsigned long)st->application_nr_red);
-        fprintf(stderr, "------------------------------------------\n");
-      }
-      /* if (info_level > 1) { */
-      /*   fprintf(stderr, "Application phase %.2f Gops/sec\n", */
-      /*           (st->application_nr_add + st->application_nr_mult) / 1000.0 / */
-      /*               1000.0 / (stf4)); */
-      /*   fprintf(stderr, "Multi-mod time: GB + fglm (elapsed): %.2f sec\n", */
-      /*           (ca1) ); */
-      /* } */
-      if(info_level){
-	    fprintf(stdout,
-		    "\n---------------- TIMINGS ----------------\n");
-	    fprintf(stdout,
-		    "multi-mod overall(elapsed) %9.2f sec\n",
-		    ca1);
-	    fprintf(stdout,
-		    "multi-mod F4               %9.2f sec\n",
-		    stf4);
-	    fprintf(stdout,
-		    "multi-mod FGLM             %9.2f sec\n",
-		    ca1-stf4);
-	    if (info_level > 1){
-	      fprintf(stdout,
-		      "learning phase             %9.2f Gops/sec\n",
-		      (st->trace_nr_add+st->trace_nr_mult)/1000.0/1000.0/(st->learning_rtime));
-	      fprintf(stdout,
-		      "application phase          %9.2f Gops/sec\n",
-		      (st->application_nr_add+st->application_nr_mult)/1000.0/1000.0/(stf4));
-	    }
-	    fprintf(stdout,
-		    "-----------------------------------------\n");
+      if (k == -1) {
+        break;
       }
-      if (info_level) {
-	  fprintf(stdout,
-		  "\nmulti-modular steps\n");
-	  fprintf(stdout, "-------------------------------------------------\
+      if (nprimes == 1) {
+        if (info_level > 2) {
+          fprintf(stderr, "------------------------------------------\n");
+          fprintf(stderr, "#ADDITIONS       %13lu\n",
+                  (unsigned long)st->application_nr_add * 1000);
+          fprintf(stderr, "#MULTIPLICATIONS %13lu\n",
+                  (unsigned long)st->application_nr_mult * 1000);
+          fprintf(stderr, "#REDUCTIONS      %13lu\n",
+                  (unsigned long)st->application_nr_red);
+          fprintf(stderr, "------------------------------------------\n");
+        }
+        if(info_level){
+          fprintf(stdout,
+                  "\n---------------- TIMINGS ----------------\n");
+          fprintf(stdout,
+                  "multi-mod overall(elapsed) %9.2f sec\n",
+                  slot_rt[k]);
+          fprintf(stdout,
+                  "multi-mod F4               %9.2f sec\n",
+                  slot_f4[k]);
+          fprintf(stdout,
+                  "multi-mod FGLM             %9.2f sec\n",
+                  slot_rt[k]-slot_f4[k]);
+          if (info_level > 1){
+            fprintf(stdout,
+                    "learning phase             %9.2f Gops/sec\n",
+                    (st->trace_nr_add+st->trace_nr_mult)/1000.0/1000.0/(st->learning_rtime));
+            fprintf(stdout,
+                    "application phase          %9.2f Gops/sec\n",
+                    (st->application_nr_add+st->application_nr_mult)/1000.0/1000.0/(slot_f4[k]));
+          }
+          fprintf(stdout,
+                  "-----------------------------------------\n");
+        }
+        if (info_level) {
+          fprintf(stdout,
+                  "\nmulti-modular steps\n");
+          fprintf(stdout, "-------------------------------------------------\
 -----------------------------------------------------\n");
+        }
       }
-
-    }
-    for (int i = 0; i < st->nthrds; i++) {
-      if (bad_primes[i] == 0) {
-        normalize_nmod_param(nmod_params[i]);
-      }
-    }
-    /* scrr measures time spent in ratrecon for modular images */
-    double crr = 0, scrr = 0;
-    /* CRT + rational reconstruction */
-    for (len_t i = 0; i < st->nthrds; i++) {
-      if (bad_primes[i] == 0) {
+      /* scrr measures time spent in ratrecon for modular images */
+      double crr = 0, scrr = 0;
+      if (bad_primes[k] == 0) {
+        normalize_nmod_param(nmod_params[k]);
+        /* controls call to rational reconstruction */
+        doit = rrec_sched_action(rsched, trace_det, nprimes);
+        /* CRT + rational reconstruction */
         if (rerun == 0) {
-          mcheck = check_param_modular(*mpz_paramp, nmod_params[i], lp->p[i],
+          mcheck = check_param_modular(*mpz_paramp, nmod_params[k], lp->p[k],
                                        is_lifted, trace_det, info_level);
         }
         crr = realtime();
         if (mcheck == 1) {
           br = new_rational_reconstruction(
-              *mpz_paramp, tmp_mpz_param, nmod_params[i], 
-              bnlins[i], blinvars[i], lineqs_ptr[i], 
-              trace_det, bmatrix[i], numer,
-              denom, modulus, prod_crt, lp->p[i], &result, rnum, rden, recdata,
-              &guessed_num, &guessed_den, &maxrec, &matrec, &oldmatrec_checked, 
+              *mpz_paramp, tmp_mpz_param, nmod_params[k],
+              bnlins[k], blinvars[k], lineqs_ptr[k],
+              trace_det, bmatrix[k], numer,
+              denom, modulus, prod_crt, crtim, lp->p[k], &result, rnum, rden,
+              recdata,
+              &guessed_num, &guessed_den, &maxrec, &matrec, &oldmatrec_checked,
               &matrec_checked, is_lifted,
-              &mat_lifted, &lin_lifted, doit, nbdoit, st->nthrds, info_level);
+              &mat_lifted, &lin_lifted, doit, rsched->step, nthrds, 1,
+              info_level);
 
           if (br == 1) {
             rerun = 0;
@@ -2416,54 +3009,85 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
             rerun = 1;
           }
         }
-        scrr += realtime() - crr;
+        scrr = realtime() - crr;
         nprimes++;
+        strat += scrr;
+
+        /* elapsed time needed to get a new prime out of the pipeline */
+        const long ostep = rsched->step;
+        const double t = (realtime() - pstart) / (nprimes - 1);
+        if (mcheck == 1) {
+          rrec_sched_update(rsched, trace_det, doit, br, scrr, t, nprimes - 1);
+        }
+        if (info_level && rsched->step != ostep) {
+          fprintf(stdout, "\n<Step:%ld/%.2f/%.2f>", rsched->step, scrr, t);
+          fflush(stdout);
+        }
+
+        if (LOG2(nprimes) > clog) {
+          if (info_level) {
+            fprintf(stdout, "{%d}", nprimes);
+            fflush(stdout);
+          }
+          clog++;
+        }
       } else {
         if (info_level) {
-          fprintf(stdout, "<bp: %d>\n", lp->p[i]);
-	  fflush(stdout);
+          fprintf(stdout, "<bp: %d>\n", lp->p[k]);
+          fflush(stdout);
         }
         nbadprimes++;
         if (nbadprimes > nprimes) {
-          free(linvars);
-          free(bnlins);
-          free(lineqs_ptr[0]);
-          free(lineqs_ptr);
-          free(squvars);
-          free_rrec_data(recdata);
-          mpz_clear(prod_crt);
-          trace_det_clear(trace_det);
-          free_rrec_data(recdata);
-          fprintf(stderr, "Many other data should be cleaned\n");
-          return -4;
+          ret = -4;
         }
       }
-    }
-    strat += scrr;
-
-    double t = ((double)nbdoit) * ca1;
-    if ((t == 0) || (scrr >= 0.2 * t && br == 0)) {
-      nbdoit = 2 * nbdoit;
-      lpow2 = 2 * nprimes;
-      doit = 0;
-      if (info_level) {
-        fprintf(stdout, "\n<Step:%d/%.2f/%.2f>", nbdoit, scrr, t);
-	fflush(stdout);
+#pragma omp critical(trace_pipeline)
+      {
+        slot_state[k] = 0;
+        nmerged++;
+        merged_rt += slot_rt[k];
+        if (trace_primes == 0 && trace_det->done_trace > 1) {
+          trace_primes = nprimes;
+        }
+        rec_done = (rerun == 0);
+        matmul_lifted = (trace_det->mat_lifted == 2);
+        all_lifted = (trace_det->mat_lifted == 2 && trace_det->lin_lifted == 2);
+        if (ret != 0 || (rerun == 0 && mcheck == 0)) {
+          done = 1;
+        }
       }
-      prdone = 0;
-    } else {
-      prdone++;
+      pipeline_signal(&pwait);
     }
+#pragma omp critical(trace_pipeline)
+    recon_busy = 0;
+    pipeline_signal(&pwait);
+  }
+  pipeline_wait_clear(&pwait);
+#ifdef _OPENMP
+  omp_set_max_active_levels(max_levels);
+#endif
+  st->nthrds = nthrds;
+  free(slot_thrds);
 
-    if ((LOG2(nprimes) > clog) ||
-        (nbdoit != 1 && (nprimes % (lpow2 + 1) == 0))) {
-      if (info_level) {
-        fprintf(stdout, "{%d}", nprimes);
-	fflush(stdout);
-      }
-      clog++;
-      lpow2 = 2 * lpow2;
-    }
+  free(slot_state);
+  free(slot_seq);
+  free(slot_lifted);
+  free(slot_rt);
+  free(slot_f4);
+
+  if (ret == -4) {
+    free(linvars);
+    free(bnlins);
+    free(lineqs_ptr[0]);
+    free(lineqs_ptr);
+    free(squvars);
+    free_rrec_data(recdata);
+    mpz_clear(prod_crt);
+    trace_det_clear(trace_det);
+    crt_images_clear(crtim);
+    free_rrec_data(recdata);
+    fprintf(stderr, "Many other data should be cleaned\n");
+    return -4;
   }
 
   (*mpz_paramp)->denom->length = (*mpz_paramp)->nsols;
@@ -2489,6 +3113,7 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
     fprintf(stdout, "-----------------------------------------\n");
     fprintf(stdout, "\n---------------- TIMINGS ----------------\n");
     fprintf(stdout, "CRT and ratrecon(elapsed) %10.2f sec\n", st->fglm_rtime);
+    rrec_sched_print(stdout, rsched);
     fprintf(stdout, "-----------------------------------------\n");
   }
   mpz_param_clear(tmp_mpz_param);
@@ -2504,11 +3129,12 @@ int msolve_trace_qq(mpz_param_t *mpz_paramp,
   mpz_clear(prod_crt);
   free_rrec_data(recdata);
   trace_det_clear(trace_det);
+  crt_images_clear(crtim);
 
 
   // here we should clean nmod_params
 
-  for (i = 0; i < st->nthrds; ++i) {
+  for (i = 0; i < nslots; ++i) {
     if (bs[i] != NULL) {
       free_basis(&(bs[i]));
     }
@@ -3146,80 +3772,115 @@ void normalize_points(real_point_t *pts, int64_t nb, int32_t nv) {
   }
 }
 
-void extract_real_roots_param(mpz_param_t param, interval *roots, long nb,
-                              real_point_t *pts, long prec, long nbits,
-                              double step, int info_level) {
-  long nsols = param->elim->length - 1;
-  mpz_t *xup = malloc(sizeof(mpz_t) * nsols);
-  mpz_t *xdo = malloc(sizeof(mpz_t) * nsols);
-  mpz_t c, tmp, den_up, den_do, val_up, val_do;
-  mpz_init(c);
-  mpz_init(tmp);
-  mpz_init(den_up);
-  mpz_init(den_do);
-  mpz_init(val_up);
-  mpz_init(val_do);
-  for (long i = 0; i < nsols; i++) {
-    mpz_init_set_ui(xup[i], 1);
-    mpz_init_set_ui(xdo[i], 1);
-  }
-  mpz_t *tab =
-      (mpz_t *)(calloc(8, sizeof(mpz_t))); // table for some intermediate values
+/* scratch data needed to extract one real root of a parametrization */
+typedef struct{
+  long nsols;
+  long len; /* length of the eliminating polynomial */
+  mpz_t *xup;
+  mpz_t *xdo;
+  mpz_t c, tmp, den_up, den_do, val_up, val_do, s;
+  mpz_t *tab; /* table for some intermediate values */
+  mpz_t *polelim; /* copy of the eliminating polynomial, modified in place */
+  interval *pos_root;
+} root_scratch_struct;
+
+typedef root_scratch_struct root_scratch_t[1];
+
+static void root_scratch_init(root_scratch_t rs, mpz_param_t param){
+  rs->nsols = param->elim->length - 1;
+  rs->len = param->elim->length;
+  rs->xup = malloc(sizeof(mpz_t) * rs->nsols);
+  rs->xdo = malloc(sizeof(mpz_t) * rs->nsols);
+  mpz_init(rs->c);
+  mpz_init(rs->tmp);
+  mpz_init(rs->den_up);
+  mpz_init(rs->den_do);
+  mpz_init(rs->val_up);
+  mpz_init(rs->val_do);
+  mpz_init(rs->s);
+  for (long i = 0; i < rs->nsols; i++) {
+    mpz_init_set_ui(rs->xup[i], 1);
+    mpz_init_set_ui(rs->xdo[i], 1);
+  }
+  rs->tab = (mpz_t *)(calloc(8, sizeof(mpz_t)));
   for (int i = 0; i < 8; i++) {
-    mpz_init(tab[i]);
-    mpz_set_ui(tab[i], 0);
+    mpz_init(rs->tab[i]);
+    mpz_set_ui(rs->tab[i], 0);
+  }
+  rs->polelim = calloc(rs->len, sizeof(mpz_t));
+  for (long i = 0; i < rs->len; i++) {
+    mpz_init_set(rs->polelim[i], param->elim->coeffs[i]);
   }
+  rs->pos_root = calloc(1, sizeof(interval));
+  mpz_init(rs->pos_root->numer);
+}
 
-  mpz_t *polelim = calloc(param->elim->length, sizeof(mpz_t));
-  for (long i = 0; i < param->elim->length; i++) {
-    mpz_init_set(polelim[i], param->elim->coeffs[i]);
+static void root_scratch_clear(root_scratch_t rs){
+  for (long i = 0; i < rs->nsols; i++) {
+    mpz_clear(rs->xup[i]);
+    mpz_clear(rs->xdo[i]);
+  }
+  free(rs->xup);
+  free(rs->xdo);
+  mpz_clear(rs->c);
+  mpz_clear(rs->s);
+  mpz_clear(rs->tmp);
+  mpz_clear(rs->den_up);
+  mpz_clear(rs->den_do);
+  mpz_clear(rs->val_up);
+  mpz_clear(rs->val_do);
+  for (int i = 0; i < 8; i++)
+    mpz_clear(rs->tab[i]);
+  free(rs->tab);
+
+  for (long i = 0; i < rs->len; i++) {
+    mpz_clear(rs->polelim[i]);
   }
-  interval *pos_root = calloc(1, sizeof(interval));
-  mpz_init(pos_root->numer);
-  mpz_t s;
-  mpz_init(s);
+  free(rs->polelim);
+  mpz_clear(rs->pos_root->numer);
+  free(rs->pos_root);
+}
+
+/* roots are handled in parallel, each thread having its own scratch data;
+ * the i-th point is always computed from the i-th root, hence the output
+ * does not depend on the number of threads */
+void extract_real_roots_param(mpz_param_t param, interval *roots, long nb,
+                              real_point_t *pts, long prec, long nbits,
+                              double step, int nr_threads, int info_level) {
 
   double et = realtime();
+  long ndone = 0;
 
-  for (long nc = 0; nc < nb; nc++) {
-    interval *rt = roots + nc;
+#pragma omp parallel num_threads(nr_threads)
+  {
+    root_scratch_t rs;
+    root_scratch_init(rs, param);
 
-    lazy_single_real_root_param(param, polelim, rt, nb, pos_root, xdo, xup,
-                                den_up, den_do, c, tmp, val_do, val_up, tab,
-                                pts[nc], prec, nbits, s, info_level);
+    long nc;
+#pragma omp for schedule(dynamic)
+    for (nc = 0; nc < nb; nc++) {
+      interval *rt = roots + nc;
 
-    if (info_level) {
-      if (realtime() - et >= step) {
-        fprintf(stderr, "{%.2f%%}", 100 * nc / ((double)nb));
-        et = realtime();
+      lazy_single_real_root_param(param, rs->polelim, rt, nb, rs->pos_root,
+                                  rs->xdo, rs->xup, rs->den_up, rs->den_do,
+                                  rs->c, rs->tmp, rs->val_do, rs->val_up,
+                                  rs->tab, pts[nc], prec, nbits, rs->s,
+                                  info_level);
+
+      if (info_level) {
+#pragma omp critical(extract_real_roots)
+        {
+          ndone++;
+          if (realtime() - et >= step) {
+            fprintf(stderr, "{%.2f%%}", 100 * ndone / ((double)nb));
+            et = realtime();
+          }
+        }
       }
     }
+    root_scratch_clear(rs);
   }
 
-  for (long i = 0; i < nsols; i++) {
-    mpz_clear(xup[i]);
-    mpz_clear(xdo[i]);
-  }
-  free(xup);
-  free(xdo);
-  mpz_clear(c);
-  mpz_clear(s);
-  mpz_clear(tmp);
-  mpz_clear(den_up);
-  mpz_clear(den_do);
-  mpz_clear(val_up);
-  mpz_clear(val_do);
-  for (int i = 0; i < 8; i++)
-    mpz_clear(tab[i]);
-  free(tab);
-
-  for (long i = 0; i < param->elim->length; i++) {
-    mpz_clear(polelim[i]);
-  }
-  free(polelim);
-  mpz_clear(pos_root->numer);
-  free(pos_root);
-
   normalize_points(pts, nb, param->nvars);
 }
 
@@ -3266,7 +3927,7 @@ real_point_t *isolate_real_roots_param(mpz_param_t param, long *nb_real_roots_pt
     }
 
     extract_real_roots_param(param, roots, nb, pts, precision, maxnbits, step,
-                             info_level);
+                             nr_threads, info_level);
     if (info_level) {
       fprintf(stderr, "Elapsed time (real root extraction) = %.2f\n",
               realtime() - st);
@@ -3304,6 +3965,31 @@ void isolate_real_roots_lparam(mpz_param_array_t lparams, long **lnbr_ptr,
   (*lreal_pts_ptr) = lreal_pts;
 }
 
+/* reads the rational parametrization written by option -O for the same
+ * input system instead of computing it, returns -3 if it does not fit */
+static int read_mpz_param_from_file_bin(char *fn, mpz_param_t param,
+                                        int *dim_ptr, long *dquot_ptr,
+                                        const data_gens_ff_t *gens){
+  mpz_param_array_t lparam;
+  get_params_from_file_bin(fn, lparam);
+  if (lparam->nb != 1 || lparam->params[0]->nvars != gens->nvars) {
+    fprintf(stderr, "Parametrization in %s does not fit the input system\n",
+            fn);
+    for (len_t i = 0; i < lparam->nb; i++) {
+      mpz_param_clear(lparam->params[i]);
+    }
+    free(lparam->params);
+    return -3;
+  }
+  mpz_param_clear(param);
+  param[0] = lparam->params[0][0];
+  free(lparam->params);
+  param->dim = 0;
+  *dim_ptr = 0;
+  *dquot_ptr = param->dquot;
+  return 0;
+}
+
 int real_msolve_qq(mpz_param_t *mpz_paramp, param_t **nmod_param, int *dim_ptr,
                    long *dquot_ptr, long *nb_real_roots_ptr,
                    interval **real_roots_ptr, real_point_t **real_pts_ptr,
@@ -3336,25 +4022,32 @@ int real_msolve_qq(mpz_param_t *mpz_paramp, param_t **nmod_param, int *dim_ptr,
 
   double ct0 = cputime();
   double rt0 = realtime();
-  int b = msolve_trace_qq(mpz_paramp,
-                          nmod_param,
-                          dim_ptr,
-                          dquot_ptr,
-                          gens,
-                          ht_size, //initial_hts,
-			  unstable_staircase,
-                          nr_threads,
-                          max_nr_pairs,
-                          elim_block_len,
-                          reset_ht,
-                          la_option,
-                          use_signatures,
-                          lift_matrix,
-                          info_level,
-                          print_gb,
-                          pbm_file,
-                          files,
-                          round);
+  int b;
+  if (files != NULL && files->bin_file != NULL && gens->field_char == 0) {
+    b = read_mpz_param_from_file_bin(files->bin_file, *mpz_paramp, dim_ptr,
+                                     dquot_ptr, gens);
+  }
+  else {
+    b = msolve_trace_qq(mpz_paramp,
+                            nmod_param,
+                            dim_ptr,
+                            dquot_ptr,
+                            gens,
+                            ht_size, //initial_hts,
+                            unstable_staircase,
+                            nr_threads,
+                            max_nr_pairs,
+                            elim_block_len,
+                            reset_ht,
+                            la_option,
+                            use_signatures,
+                            lift_matrix,
+                            info_level,
+                            print_gb,
+                            pbm_file,
+                            files,
+                            round);
+  }
   double ct1 = cputime();
   double rt1 = realtime();
 
@@ -3448,7 +4141,8 @@ void display_output(int b, int dim, int dquot, files_gb *files,
                     data_gens_ff_t *gens, param_t *param,
                     mpz_param_t *mpz_paramp, int get_param,
                     long *nb_real_roots_ptr, interval **real_roots_ptr,
-                    real_point_t **real_pts_ptr, int info_level) {
+                    real_point_t **real_pts_ptr, const int32_t nr_threads,
+                    int info_level) {
   if (dquot == 0) {
     if (files->out_file != NULL) {
       FILE *ofile = fopen(files->out_file, "a+");
@@ -3466,7 +4160,8 @@ void display_output(int b, int dim, int dquot, files_gb *files,
       FILE *ofile = fopen(files->out_file, "a+");
       fprintf(ofile, "[0, ");
       if (get_param >= 1 || gens->field_char) {
-        mpz_param_out_str_maple(ofile, gens, dquot, *mpz_paramp, param);
+        mpz_param_out_str_maple(ofile, gens, dquot, *mpz_paramp, param,
+                                nr_threads);
       }
       if (get_param <= 1 && gens->field_char == 0) {
         if (get_param) {
@@ -3479,7 +4174,8 @@ void display_output(int b, int dim, int dquot, files_gb *files,
     } else {
       fprintf(stdout, "[0, ");
       if (get_param >= 1 || gens->field_char) {
-        mpz_param_out_str_maple(stdout, gens, dquot, *mpz_paramp, param);
+        mpz_param_out_str_maple(stdout, gens, dquot, *mpz_paramp, param,
+                                nr_threads);
       }
       if (get_param <= 1 && gens->field_char == 0) {
         if (get_param) {
@@ -3489,6 +4185,12 @@ void display_output(int b, int dim, int dquot, files_gb *files,
       }
       fprintf(stdout, "]:\n");
     }
+    /* the rational parametrization is also written in binary format, it
+     * can be read back with get_params_from_file_bin */
+    if (files->bin_out_file != NULL && get_param >= 1 &&
+        gens->field_char == 0) {
+      write_param_to_file_bin(files->bin_out_file, *mpz_paramp);
+    }
   }
   if (dim > 0) {
     if (info_level > 0) {
@@ -3509,10 +4211,12 @@ void manage_output(int b, int dim, int dquot, files_gb *files,
                    data_gens_ff_t *gens, param_t *param,
                    mpz_param_t *mpz_paramp, int get_param,
                    long *nb_real_roots_ptr, interval **real_roots_ptr,
-                   real_point_t **real_pts_ptr, int info_level) {
+                   real_point_t **real_pts_ptr, const int32_t nr_threads,
+                   int info_level) {
   if (b == 0) {
     display_output(b, dim, dquot, files, gens, param, mpz_paramp, get_param,
-                   nb_real_roots_ptr, real_roots_ptr, real_pts_ptr, info_level);
+                   nb_real_roots_ptr, real_roots_ptr, real_pts_ptr, nr_threads,
+                   info_level);
   }
   if (b == -2) {
     fprintf(stderr, "Characteristic of the field here shouldn't be positive\n");
@@ -4066,6 +4770,7 @@ restart:
                         nb_real_roots_ptr,
                         real_roots_ptr,
                         real_pts_ptr,
+                        nr_threads,
                         info_level);
 
 
@@ -4757,6 +5462,7 @@ restart:
                           nb_real_roots_ptr,
                           real_roots_ptr,
                           real_pts_ptr,
+                          nr_threads,
                           info_level);
             if (b == 1) {
                 free(bld);
@@ -4951,7 +5657,9 @@ void export_julia_rational_parametrization_qq(
 }
 
 
-void msolve_julia(
+/* solves one system for msolve_julia resp. msolve_julia_batch, files
+ * may hold a tracer shared with other systems */
+static void solve_julia_system(
         void *(*mallocp) (size_t),
         int32_t *rp_ld,
         int32_t *rp_nr_vars,
@@ -4968,7 +5676,7 @@ void msolve_julia(
         int32_t *exps,
         void *cfs,
         char **var_names,
-        char *output_file,
+        files_gb *files,
         const uint32_t field_char,
         const int32_t mon_order,
         const int32_t elim_block_len,
@@ -4987,16 +5695,7 @@ void msolve_julia(
         const int32_t info_level
         )
 {
-    /* timinigs */
-    double st0 = cputime();
-    double rt0 = realtime();
-
     len_t i;
-    files_gb *files = calloc(1, sizeof(files_gb));
-
-    if (output_file != NULL) {
-        files->out_file = output_file;
-    }
 
     data_gens_ff_t *gens = allocate_data_gens();
 
@@ -5094,6 +5793,64 @@ void msolve_julia(
         free(real_pts);
     }
 
+}
+
+void msolve_julia(
+        void *(*mallocp) (size_t),
+        int32_t *rp_ld,
+        int32_t *rp_nr_vars,
+        int32_t *rp_dim,
+        int32_t *rp_dquot,
+        int32_t **rp_lens,
+        char ***rp_var_namesp,
+        void **rp_cfs_linear_form,
+        void **rp_cfs,
+        int32_t *n_real_sols,
+        void **real_sols_num,
+        int32_t **real_sols_den,
+        int32_t *lens,
+        int32_t *exps,
+        void *cfs,
+        char **var_names,
+        char *output_file,
+        const uint32_t field_char,
+        const int32_t mon_order,
+        const int32_t elim_block_len,
+        const int32_t nr_vars,
+        const int32_t nr_gens,
+        const int32_t initial_hts,
+        const int32_t nr_threads,
+        const int32_t max_nr_pairs,
+        const int32_t reset_ht,
+        const int32_t la_option,
+        const int32_t use_signatures,
+        const int32_t print_gb,
+        const int32_t get_param,
+        const int32_t genericity_handling,
+        const int32_t precision,
+        const int32_t info_level
+        )
+{
+    /* timinigs */
+    double st0 = cputime();
+    double rt0 = realtime();
+
+    files_gb *files = calloc(1, sizeof(files_gb));
+
+    if (output_file != NULL) {
+        files->out_file = output_file;
+    }
+
+    solve_julia_system(mallocp, rp_ld, rp_nr_vars, rp_dim, rp_dquot,
+            rp_lens, rp_var_namesp, rp_cfs_linear_form, rp_cfs, n_real_sols,
+            real_sols_num, real_sols_den, lens, exps, cfs, var_names, files,
+            field_char, mon_order, elim_block_len, nr_vars, nr_gens,
+            initial_hts, nr_threads, max_nr_pairs, reset_ht, la_option,
+            use_signatures, print_gb, get_param, genericity_handling,
+            precision, info_level);
+
+    free(files);
+
     /* timings */
     if (info_level > 0) {
         double st1 = cputime();
@@ -5108,6 +5865,95 @@ void msolve_julia(
 }
 
 
+/* Solves nr_systems systems which share the monomial support given by lens
+ * and exps, cfs[k] holding the coefficients of the k-th system in the
+ * format of msolve_julia. Each output array has nr_systems entries, entry
+ * k is what msolve_julia returns for the k-th system.
+ *
+ * The F4 tracer and the basis hash table are learned for the first system
+ * and then applied to all further systems, whose multi-modular computations
+ * are run on nr_threads threads. If the tracer does not apply to a system,
+ * e.g. since its staircase differs, a new one is learned for this system.
+ * The systems are solved one after the other: neogb's linear algebra and
+ * monomial order routines are selected through function pointers shared
+ * by the whole process, so systems must not be in flight at the same time. */
+void msolve_julia_batch(
+        void *(*mallocp) (size_t),
+        const int32_t nr_systems,
+        int32_t *rp_ld,
+        int32_t *rp_nr_vars,
+        int32_t *rp_dim,
+        int32_t *rp_dquot,
+        int32_t **rp_lens,
+        char ***rp_var_namesp,
+        void **rp_cfs_linear_form,
+        void **rp_cfs,
+        int32_t *n_real_sols,
+        void **real_sols_num,
+        int32_t **real_sols_den,
+        int32_t *lens,
+        int32_t *exps,
+        void **cfs,
+        char **var_names,
+        const uint32_t field_char,
+        const int32_t mon_order,
+        const int32_t elim_block_len,
+        const int32_t nr_vars,
+        const int32_t nr_gens,
+        const int32_t initial_hts,
+        const int32_t nr_threads,
+        const int32_t max_nr_pairs,
+        const int32_t reset_ht,
+        const int32_t la_option,
+        const int32_t use_signatures,
+        const int32_t print_gb,
+        const int32_t get_param,
+        const int32_t genericity_handling,
+        const int32_t precision,
+        const int32_t info_level
+        )
+{
+    /* timinigs */
+    double st0 = cputime();
+    double rt0 = realtime();
+
+    int32_t k;
+    files_gb *files = calloc(1, sizeof(files_gb));
+
+    files->trace_stream = tmpfile();
+    if (files->trace_stream == NULL && info_level > 0) {
+        fprintf(stderr, "No tracer storage, learning a tracer for each system.\n");
+    }
+
+    for (k = 0; k < nr_systems; ++k) {
+        solve_julia_system(mallocp, rp_ld+k, rp_nr_vars+k, rp_dim+k,
+                rp_dquot+k, rp_lens+k, rp_var_namesp+k, rp_cfs_linear_form+k,
+                rp_cfs+k, n_real_sols+k, real_sols_num+k, real_sols_den+k,
+                lens, exps, cfs[k], var_names, files, field_char, mon_order,
+                elim_block_len, nr_vars, nr_gens, initial_hts, nr_threads,
+                max_nr_pairs, reset_ht, la_option, use_signatures, print_gb,
+                get_param, genericity_handling, precision, info_level);
+    }
+
+    if (files->trace_stream != NULL) {
+        fclose(files->trace_stream);
+    }
+    free(files);
+
+    /* timings */
+    if (info_level > 0) {
+        double st1 = cputime();
+        double rt1 = realtime();
+        fprintf(stderr, "\n-------------------------------------------------\
+-----------------------------------\n");
+        fprintf(stderr, "msolve batch of %d systems  %6.2f sec (elapsed) / %5.2f sec (cpu)\n",
+                nr_systems, rt1-rt0, st1-st0);
+        fprintf(stderr, "-------------------------------------------------\
+-----------------------------------\n");
+    }
+}
+
+
 
 /* The parameters themselves are handled by julia, thus we only
  * free what they are pointing to, julia's garbage collector then
@@ -181,6 +181,42 @@ void msolve_julia(
         const int32_t info_level
         );
 
+void msolve_julia_batch(
+        void *(*mallocp) (size_t),
+        const int32_t nr_systems,
+        int32_t *rp_ld,
+        int32_t *rp_nr_vars,
+        int32_t *rp_dim,
+        int32_t *rp_dquot,
+        int32_t **rp_lens,
+        char ***rp_var_namesp,
+        void **rp_cfs_linear_form,
+        void **rp_cfs,
+        int32_t *n_real_sols,
+        void **real_sols_num,
+        int32_t **real_sols_den,
+        int32_t *lens,
+        int32_t *exps,
+        void **cfs,
+        char **var_names,
+        const uint32_t field_char,
+        const int32_t mon_order,
+        const int32_t elim_block_len,
+        const int32_t nr_vars,
+        const int32_t nr_gens,
+        const int32_t initial_hts,
+        const int32_t nr_threads,
+        const int32_t max_nr_pairs,
+        const int32_t reset_ht,
+        const int32_t la_option,
+        const int32_t use_signatures,
+        const int32_t print_gb,
+        const int32_t get_param,
+        const int32_t genericity_handling,
+        const int32_t precision,
+        const int32_t info_level
+        );
+
 void free_msolve_julia_result_data(
         void (*freep) (void *),
         int32_t **res_len,
@@ -591,6 +591,9 @@ static void return_normal_forms_to_basis(
                 case 32:
                     bs->cf_32[bs->ld] = mat->cf_32[rows[i][COEFFS]];
                     break;
+                case 64:
+                    bs->cf_64[bs->ld] = mat->cf_64[rows[i][COEFFS]];
+                    break;
                 default:
                     bs->cf_32[bs->ld] = mat->cf_32[rows[i][COEFFS]];
                     break;
@@ -611,6 +614,9 @@ static void return_normal_forms_to_basis(
                 case 32:
                     bs->cf_32[bs->ld] = NULL;
                     break;
+                case 64:
+                    bs->cf_64[bs->ld] = NULL;
+                    break;
                 default:
                     bs->cf_32[bs->ld] = NULL;
                     break;
@@ -665,6 +671,8 @@ static void convert_sparse_matrix_rows_to_basis_elements(
         } else {
             i = k;
         }
+        /* rows taken from the row arena would not survive this round */
+        rows[i] = move_row_out_of_arena(mat->ra, rows[i]);
         const len_t len = rows[i][LENGTH]+OFFSET;
         for (j = OFFSET; j < len; ++j) {
             rows[i][j] = hcm[rows[i][j]];
@@ -691,6 +699,9 @@ static void convert_sparse_matrix_rows_to_basis_elements(
             case 32:
                 bs->cf_32[bl+k] = mat->cf_32[rows[i][COEFFS]];
                 break;
+            case 64:
+                bs->cf_64[bl+k] = mat->cf_64[rows[i][COEFFS]];
+                break;
             default:
                 bs->cf_32[bl+k] = mat->cf_32[rows[i][COEFFS]];
                 break;
@@ -797,7 +808,8 @@ static void convert_sparse_matrix_rows_to_basis_elements_use_sht(
         } else {
             i = k;
         }
-        row = rows[i];
+        /* rows taken from the row arena would not survive this round */
+        row = rows[i] = move_row_out_of_arena(mat->ra, rows[i]);
         deg = sht->hd[hcm[rows[i][OFFSET]]].deg;
         const len_t len = rows[i][LENGTH]+OFFSET;
         if (st->nev ==  0) {
@@ -825,6 +837,9 @@ static void convert_sparse_matrix_rows_to_basis_elements_use_sht(
             case 32:
                 bs->cf_32[bl+k] = mat->cf_32[rows[i][COEFFS]];
                 break;
+            case 64:
+                bs->cf_64[bl+k] = mat->cf_64[rows[i][COEFFS]];
+                break;
             default:
                 bs->cf_32[bl+k] = mat->cf_32[rows[i][COEFFS]];
                 break;
@@ -41,6 +41,8 @@ inline omp_int_t omp_get_max_threads(void) { return 1;}
 #endif
 
 #define PARALLEL_HASHING 0
+/* maximal number of primes for which a tracer is applied at once */
+#define PRIME_BUNDLE 4
 #define ORDER_COLUMNS 1
 /* loop unrolling in sparse linear algebra:
  * we store the offset of the first elements not unrolled
@@ -72,6 +74,7 @@ inline omp_int_t omp_get_max_threads(void) { return 1;}
 typedef uint8_t cf8_t;   /* coefficient type finite field (8 bit) */
 typedef uint16_t cf16_t; /* coefficient type finite field (16 bit) */
 typedef uint32_t cf32_t; /* coefficient type finite field (32 bit) */
+typedef uint64_t cf64_t; /* coefficient type finite field (64 bit) */
 typedef uint32_t val_t;  /* core values like hashes */
 typedef val_t hi_t;      /* index of hash table entries*/
 typedef hi_t hm_t;       /* hashed monomials for polynomial entries */
@@ -128,6 +131,14 @@ struct ht_t
     hl_t eld;     /* load of exponent vector */
     hl_t esz;     /* size of exponent vector */
     hl_t hsz;     /* size of hash map, might be 2^32 */
+    hl_t vsz;     /* number of elements for which hd and ev are
+                   * reserved as virtual memory, 0 if they are
+                   * allocated on the heap */
+    len_t irs;    /* 1 if the hash map is resized incrementally */
+    hi_t *ohmap;  /* old hash map during incremental resizing */
+    hl_t ohsz;    /* size of old hash map */
+    hl_t omig;    /* elements below omig are moved to hmap */
+    hl_t oeld;    /* elements below oeld are stored in ohmap */
     len_t ebl;    /* elimination block length:
                    * degree + #elimination variables,
                    * 0 if no elimination order */
@@ -195,10 +206,45 @@ struct bs_t
     cf8_t **cf_8;   /* coefficients for finite fields (8 bit) */
     cf16_t **cf_16; /* coefficients for finite fields (16 bit) */
     cf32_t **cf_32; /* coefficients for finite fields (32 bit) */
+    cf64_t **cf_64; /* coefficients for finite fields (64 bit) */
     mpz_t **cf_qq;  /* coefficients for rationals (always multiplied such that
                        the denominator is 1) */
 };
 
+/* divisibility index over the non-redundant lead monomials of a basis:
+ * for each entry of the exponent vectors a bit array over the positions
+ * in bs->lm marking the lead monomials having a zero entry there */
+typedef struct dvi_t dvi_t;
+struct dvi_t
+{
+    len_t nw;       /* number of 64 bit words per bit array */
+    len_t evl;      /* number of bit arrays, i.e. exponent vector length */
+    bl_t lml;       /* number of lead monomials indexed */
+    uint64_t *z;    /* bit arrays, z[k*nw + w] */
+};
+
+/* row arena: memory for the rows generated during symbolic preprocessing,
+ * handed out by bumping a pointer in per-thread blocks taken from one
+ * reserved region, released at once after each round */
+typedef struct rab_t rab_t;
+struct rab_t
+{
+    char *cur;      /* next free byte of the current block */
+    char *end;      /* end of the current block */
+    char pad[48];   /* blocks of different threads on different cache lines */
+};
+
+typedef struct ra_t ra_t;
+struct ra_t
+{
+    char *base;     /* reserved region */
+    size_t sz;      /* size of the reserved region */
+    size_t ld;      /* bytes of the region handed out as blocks */
+    size_t ovf;     /* bytes of rows malloc'ed once the region was full */
+    int32_t nthrds; /* number of threads, i.e. of blocks */
+    rab_t *tb;      /* current block of each thread */
+};
+
 /* matrix stuff */
 typedef struct mat_t mat_t;
 struct mat_t
@@ -214,9 +260,12 @@ struct mat_t
     hm_t **rr;          /* reducer rows of the matrix, only column */
                         /* entries, coefficients are handled via linking */
                         /* to coefficient arrays. */
+    ra_t *ra;           /* arena for rows generated in symbolic */
+                        /* preprocessing, NULL if rows are malloc'ed */
     cf8_t **cf_8;       /* coefficients for finite fields (8 bit) */
     cf16_t **cf_16;     /* coefficients for finite fields (16 bit) */
     cf32_t **cf_32;     /* coefficients for finite fields (32 bit) */
+    cf64_t **cf_64;     /* coefficients for finite fields (64 bit) */
     mpz_t **cf_qq;      /* coefficients for rationals */
     mpz_t **cf_ab_qq;   /* coefficients for rationals */
     len_t sz;           /* number of rows allocated resp. size */
@@ -298,6 +347,24 @@ struct td_t
     len_t nlm;    /* number of new leading monomials in this step */
 };
 
+/* symbolic data of one round of a tracer application: the matrix rows
+ * given by column indices, ready for linear algebra, and the columns which
+ * may appear in new basis elements */
+typedef struct sd_t sd_t;
+struct sd_t
+{
+    hm_t *rows;   /* storage of all rows */
+    hm_t **rr;    /* reducer rows */
+    hm_t **tr;    /* to be reduced rows */
+    ht_t *ht;     /* columns: entry 0 is the first column, entry i > 0
+                   * is the right column ncl+i-1 */
+    len_t nru;    /* number of upper rows */
+    len_t nrl;    /* number of lower rows */
+    len_t ncl;    /* number of left columns */
+    len_t ncr;    /* number of right columns */
+    double density;
+};
+
 /* possible trace levels */
 typedef enum {NO_TRACER, LEARN_TRACER, APPLY_TRACER} tl_t;
 typedef struct trace_t trace_t;
@@ -320,6 +387,16 @@ struct trace_t
                    * non-trivial kernels */
     len_t rld;    /* load of rounds stored, i.e. how often do saturate */
     len_t rsz;    /* size of rounds stored */
+    /* symbolic data generated by the first prime applying the tracer and
+     * shared by all other primes */
+    sd_t *sd;     /* symbolic data of each round */
+    int32_t *sds; /* 1 if the symbolic data of the round is available */
+    hm_t **bsup;  /* supports of the basis elements the symbolic data is
+                   * generated from, NULL if it cannot be shared */
+    len_t bsz;    /* number of basis elements */
+    const ht_t *sdht; /* basis hash table all primes start with */
+    hl_t sdeld;   /* load of sdht when applying the tracer */
+    size_t sdnt;  /* number of entries stored in the symbolic data */
 };
 
 
@@ -340,6 +417,12 @@ struct md_t
     hi_t *hcm;
     ps_t *ps;
 
+    /* shared symbolic data of a tracer application */
+    int32_t sdg;  /* 1 if this run generates the symbolic data */
+    int32_t sdu;  /* 1 if the current round uses the symbolic data */
+    int8_t *sdv;  /* basis element supports compared to the ones of the
+                   * symbolic data: 0 unknown, 1 equal, 2 different */
+
     double round_ctime;
     double select_ctime;
     double symbol_ctime;
@@ -388,7 +471,9 @@ struct md_t
     int32_t mnsel;
     int32_t homogeneous;
     uint32_t gfc; /* global field characteristic */
-    uint32_t fc;
+    uint64_t fc;  /* field characteristic of the current run, primes
+                     of more than 31 bits are handled with 64 bit
+                     coefficients */
     int32_t nev; /* number of elimination variables */
     int32_t mo; /* monomial ordering: 0=DRL, 1=LEX*/
     int32_t laopt;
@@ -442,7 +527,7 @@ struct md_t
  *         ); */
 extern void (*normalize_initial_basis)(
         bs_t *bs,
-        const uint32_t fc
+        const uint64_t fc
         );
 
 extern int (*initial_input_cmp)(
@@ -116,12 +116,25 @@ bs_t *core_gba(
         bs_t *bs,
         md_t *md,
         int32_t *errp,
-        const len_t fc
+        const uint64_t fc
         )
 {
     return core_f4(bs, md, errp, fc);
 }
 
+/* applies the tracer of md for several primes at once, see core_f4_bundle */
+void core_gba_bundle(
+        bs_t **bsp,
+        bs_t *bs,
+        md_t *md,
+        int32_t *errp,
+        const len_t *fc,
+        const len_t nb
+        )
+{
+    core_f4_bundle(bsp, bs, md, errp, fc, nb);
+}
+
 int64_t export_results_from_gba(
     /* return values */
     int32_t *bld,   /* basis load */
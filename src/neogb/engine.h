@@ -54,7 +54,16 @@ bs_t *core_gba(
         bs_t *bs,
         md_t *md,
         int32_t *errp,
-        const len_t fc
+        const uint64_t fc
+        );
+
+void core_gba_bundle(
+        bs_t **bsp,
+        bs_t *bs,
+        md_t *md,
+        int32_t *errp,
+        const len_t *fc,
+        const len_t nb
         );
 
 int64_t export_results_from_gba(
@@ -128,10 +128,14 @@ static void clear_matrix(
     mat->cf_16  = NULL;
     free(mat->cf_32);
     mat->cf_32  = NULL;
+    free(mat->cf_64);
+    mat->cf_64  = NULL;
     free(mat->cf_qq);
     mat->cf_qq  = NULL;
     free(mat->cf_ab_qq);
     mat->cf_ab_qq  = NULL;
+    /* all rows of this round are freed or moved to the basis by now */
+    reset_row_arena(mat->ra);
 }
 
 #if 0
@@ -215,6 +219,10 @@ static void intermediate_reduce_basis(
                         free(bs->cf_32[i]);
                         bs->cf_32[i] = bs->cf_32[bs->ld+j];
                         break;
+                    case 64:
+                        free(bs->cf_64[i]);
+                        bs->cf_64[i] = bs->cf_64[bs->ld+j];
+                        break;
                 }
             }
         }
@@ -231,6 +239,9 @@ static void intermediate_reduce_basis(
             case 32:
                 bs->cf_32[i] = NULL;
                 break;
+            case 64:
+                bs->cf_64[i] = NULL;
+                break;
         }
     }
     *hcmp = hcm;
@@ -278,7 +289,7 @@ static void reduce_basis(
     /* add all non-redundant basis elements as matrix rows */
     for (i = 0; i < bs->lml; ++i) {
         mat->rr[mat->nr] = multiplied_poly_to_matrix_row(
-                sht, bht, 0, etmp, bs->hm[bs->lmps[i]]);
+                mat->ra, sht, bht, 0, etmp, bs->hm[bs->lmps[i]]);
         sht->hd[mat->rr[mat->nr][OFFSET]].idx  = 1;
         mat->nr++;
     }
@@ -345,7 +356,7 @@ static int32_t initialize_f4(
         mat_t **matp,
         md_t *gmd,
         bs_t *gbs,
-        len_t fc
+        uint64_t fc
         )
 {
     bs_t *bs     = *lbsp;
@@ -375,6 +386,7 @@ static int32_t initialize_f4(
     /* matrix holding sparse information generated
        during symbolic preprocessing */
     mat = (mat_t *)calloc(1, sizeof(mat_t));
+    mat->ra = initialize_row_arena(md->nthrds);
 
     if (md->trace_level != APPLY_TRACER) {
         /* pair set */
@@ -384,6 +396,7 @@ static int32_t initialize_f4(
         bs->ld  = 0;
     } else {
         bs->ld = md->ngens;
+        initialize_symbolic_data(md, bs, gbs);
     }
 
     /* TODO: make this a command line argument */
@@ -411,7 +424,25 @@ static int32_t initialize_f4(
     return done;
 }
 
-static int32_t compute_new_elements(
+/* maps hashes to columns, returns 1 if the rows are the ones of the
+ * shared symbolic data of the current round */
+static int prepare_linear_algebra(
+    mat_t *mat,
+    md_t *md
+    )
+{
+    /* rows of shared symbolic data are already given by columns */
+    if (md->sdu == 1) {
+        return 1;
+    }
+    convert_hashes_to_columns(mat, md, md->ht);
+    sort_matrix_rows_decreasing(mat->rr, mat->nru);
+
+    return store_symbolic_data(mat, md, md->ht);
+}
+
+/* adds the rows of mat reduced by linear algebra to the basis */
+static int32_t add_new_elements(
     mat_t *mat,
     bs_t *bs,
     md_t *md,
@@ -423,10 +454,6 @@ static int32_t compute_new_elements(
     ht_t *ht  = bs->ht;
     ht_t *sht = md->ht;
 
-    convert_hashes_to_columns(mat, md, sht);
-    sort_matrix_rows_decreasing(mat->rr, mat->nru);
-    linear_algebra(mat, bs, bs, md);
-
     /* check for bad prime */
     if (md->trace_level == APPLY_TRACER) {
         if (mat->np != md->tr->td[md->trace_rd].nlm) {
@@ -440,7 +467,8 @@ static int32_t compute_new_elements(
     /* columns indices are mapped back to exponent hashes */
     if (mat->np > 0) {
         convert_sparse_matrix_rows_to_basis_elements(
-                -1, mat, bs, ht, sht, md);
+                -1, mat, bs, ht, md->sdu == 0 ? sht :
+                md->tr->sd[md->trace_rd].ht, md);
     }
     clean_hash_table(sht);
     /* all rows in mat are now polynomials in the basis,
@@ -465,6 +493,9 @@ static int32_t compute_new_elements(
         md->tr->ltd++;
     }
     if (md->trace_level == APPLY_TRACER) {
+        if (md->sdg == 1) {
+            record_symbolic_supports(md->tr, bs, bs->ld, bs->ld+md->np);
+        }
         bs->ld += md->np;
         md->trace_rd++;
         if (md->trace_rd >= md->tr->ltd) {
@@ -475,6 +506,19 @@ static int32_t compute_new_elements(
     return 0;
 }
 
+static int32_t compute_new_elements(
+    mat_t *mat,
+    bs_t *bs,
+    md_t *md,
+    int32_t *errp
+    )
+{
+    prepare_linear_algebra(mat, md);
+    linear_algebra(mat, bs, bs, md);
+
+    return add_new_elements(mat, bs, md, errp);
+}
+
 static void process_redundant_elements(
         bs_t *bs,
         md_t *md
@@ -639,6 +683,7 @@ static void free_local_data(
 {
     free_meta_data(mdp);
 
+    free_row_arena(&(*matp)->ra);
     free(*matp);
     *matp = NULL;
 }
@@ -660,15 +705,59 @@ static void finalize_f4(
         gmd->tr = (*lmdp)->tr;
         gmd->trace_level = APPLY_TRACER;
     }
+    /* report the work of this tracer application to the caller, several
+     * primes may be applied at the same time with the same gmd */
+    if ((*lmdp)->trace_level == APPLY_TRACER) {
+#pragma omp critical(application_statistics)
+        {
+            gmd->application_nr_add   = (*lmdp)->application_nr_add;
+            gmd->application_nr_mult  = (*lmdp)->application_nr_mult;
+            gmd->application_nr_red   = (*lmdp)->application_nr_red;
+        }
+    }
     gmd->min_deg_in_first_deg_fall = (*lmdp)->min_deg_in_first_deg_fall;
     free_local_data(matp, lmdp);
 }
 
+static void finish_f4(
+        md_t *gmd,
+        bs_t *gbs,
+        bs_t **bsp,
+        md_t **mdp,
+        mat_t **matp,
+        int32_t err,
+        const double rt,
+        const double ct
+        )
+{
+    bs_t *bs  = *bsp;
+    md_t *md  = *mdp;
+
+    if (err > 0) {
+        free_basis_and_only_local_hash_table_data(bsp);
+    } else {
+        print_round_information_footer(stdout, md);
+
+        /* remove possible redudant elements */
+        process_redundant_elements(bs, md);
+
+        /* reduce final basis? */
+        reduce_final_basis(bs, *matp, md);
+
+        md->f4_rtime = realtime() - rt;
+        md->f4_ctime = cputime() - ct;
+
+        get_and_print_final_statistics(stdout, md, bs);
+
+        finalize_f4(gmd, gbs, bsp, mdp, matp, err);
+    }
+}
+
 bs_t *core_f4(
         bs_t *gbs,
         md_t *gmd,
         int32_t *errp,
-        const len_t fc
+        const uint64_t fc
         )
 {
     double ct = cputime();
@@ -710,25 +799,99 @@ bs_t *core_f4(
 
         print_round_timings(stdout, md, rrt, crt);
     }
-    if (*errp > 0) {
-        free_basis_and_only_local_hash_table_data(&bs);
-    } else {
-        print_round_information_footer(stdout, md);
+    finish_f4(gmd, gbs, &bs, &md, &mat, *errp, rt, ct);
 
-        /* remove possible redudant elements */
-        process_redundant_elements(bs, md);
-
-        /* reduce final basis? */
-        reduce_final_basis(bs, mat, md);
-
-        md->f4_rtime = realtime() - rt;
-        md->f4_ctime = cputime() - ct;
+    return bs;
+}
 
-        get_and_print_final_statistics(stdout, md, bs);
+/* applies the tracer of gmd for the nb primes fc[0], ..., fc[nb-1] at
+ * once: their F4 rounds run in lockstep and whenever the matrices of
+ * several primes share the symbolic data of a round they are reduced by a
+ * single bundled linear algebra sweep. The basis for fc[i] is stored in
+ * bsp[i], errp[i] is set as in core_f4(). */
+void core_f4_bundle(
+        bs_t **bsp,
+        bs_t *gbs,
+        md_t *gmd,
+        int32_t *errp,
+        const len_t *fc,
+        const len_t nb
+        )
+{
+    len_t i, j, na;
+    double ct = cputime();
+    double rt = realtime();
 
-        finalize_f4(gmd, gbs, &bs, &md, &mat, *errp);
+    if (nb > PRIME_BUNDLE || gmd->trace_level != APPLY_TRACER) {
+        for (i = 0; i < nb; ++i) {
+            bsp[i] = core_f4(gbs, gmd, errp+i, fc[i]);
+        }
+        return;
+    }
+
+    bs_t *bs[PRIME_BUNDLE];
+    md_t *md[PRIME_BUNDLE];
+    mat_t *mat[PRIME_BUNDLE];
+    int32_t done[PRIME_BUNDLE];
+    /* primes whose matrix is reduced within the bundle */
+    bs_t *bbs[PRIME_BUNDLE];
+    md_t *bmd[PRIME_BUNDLE];
+    mat_t *bmat[PRIME_BUNDLE];
+
+    for (i = 0; i < nb; ++i) {
+        bs[i]   = NULL;
+        md[i]   = NULL;
+        mat[i]  = NULL;
+        done[i] = initialize_f4(&bs[i], &md[i], &mat[i], gmd, gbs, fc[i]);
+        errp[i] = 0;
+        print_round_information_header(stdout, md[i]);
+    }
+
+    int32_t active  = 1;
+    while (active) {
+        double rrt = realtime();
+        double crt = cputime();
+        /* the first run may generate the symbolic data, thus the other
+         * ones start their round after it */
+        na  = 0;
+        for (i = 0; i < nb; ++i) {
+            if (done[i]) {
+                continue;
+            }
+            md[i]->max_bht_size = md[i]->max_bht_size > bs[i]->ht->esz ?
+                md[i]->max_bht_size : bs[i]->ht->esz;
+            done[i] = preprocessing(mat[i], bs[i], md[i]);
+            if (!done[i]
+                    && prepare_linear_algebra(mat[i], md[i])
+                    && bundle_linear_algebra_ff_32_applies(md[i])) {
+                bbs[na]   = bs[i];
+                bmd[na]   = md[i];
+                bmat[na]  = mat[i];
+                na++;
+            }
+        }
+        if (na < 2 || exact_sparse_linear_algebra_ff_32_bundle(
+                    bmat, (const bs_t * const *)bbs, bmd, na) != 0) {
+            na  = 0;
+        }
+        active  = 0;
+        for (i = 0; i < nb; ++i) {
+            if (done[i]) {
+                continue;
+            }
+            for (j = 0; j < na && bmd[j] != md[i]; ++j);
+            if (j == na) {
+                linear_algebra(mat[i], bs[i], bs[i], md[i]);
+            }
+            done[i] = add_new_elements(mat[i], bs[i], md[i], errp+i);
+            print_round_timings(stdout, md[i], rrt, crt);
+            active  |=  !done[i];
+        }
+    }
+    for (i = 0; i < nb; ++i) {
+        finish_f4(gmd, gbs, &bs[i], &md[i], &mat[i], errp[i], rt, ct);
+        bsp[i]  = bs[i];
     }
-    return bs;
 }
 
 int64_t export_results_from_f4(
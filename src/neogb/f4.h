@@ -73,7 +73,16 @@ bs_t *core_f4(
         bs_t *gbs,
         md_t *gmd,
         int32_t *errp,
-        const len_t fc
+        const uint64_t fc
+        );
+
+void core_f4_bundle(
+        bs_t **bsp,
+        bs_t *gbs,
+        md_t *gmd,
+        int32_t *errp,
+        const len_t *fc,
+        const len_t nb
         );
 
 bs_t *modular_f4(
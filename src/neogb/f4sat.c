@@ -445,7 +445,7 @@ sat_restart:
         }
         const hi_t h      = bht->hd[m].val - bht->hd[sat->hm[j][MULT]].val;
         sat->hm[i]        = multiplied_poly_to_matrix_row(
-                sht, bht, h, etmp, sat->hm[j]);
+                NULL, sht, bht, h, etmp, sat->hm[j]);
         sat->hm[i][MULT] = qb[i];
         deg_t deg = bht->hd[sat->hm[i][OFFSET]].deg;
         if (st->nev > 0) {
@@ -19,8 +19,15 @@
  * Mohab Safey El Din */
 
 
+#include <sys/mman.h>
+#include <sys/resource.h>
+
 #include "hash.h"
 
+#ifdef HAVE_AVX2
+#include <immintrin.h>
+#endif
+
 /* we have three different hash tables:
  * 1. one hash table for elements in the basis (bht)
  * 2. one hash table for the spairs during the update process (uht)
@@ -42,12 +49,441 @@ static val_t pseudo_random_number_generator(
     return (val_t)rseed;
 }
 
+/* Exponents are 16 bit wide, with AVX2 eight of them are handled at once,
+ * the remaining ones are handled one by one. */
+static inline val_t hash_exponent_vector(
+    const exp_t * const a,
+    const val_t * const rn,
+    const len_t evl
+    )
+{
+    len_t j = 0;
+    val_t h = 0;
+
+#ifdef HAVE_AVX2
+    if (evl >= 8) {
+        __m256i acc = _mm256_setzero_si256();
+        for (; j+8 <= evl; j += 8) {
+            const __m256i ea = _mm256_cvtepu16_epi32(
+                    _mm_loadu_si128((__m128i *)(a+j)));
+            const __m256i er = _mm256_loadu_si256((__m256i *)(rn+j));
+            acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(ea, er));
+        }
+        __m128i s = _mm_add_epi32(_mm256_castsi256_si128(acc),
+                _mm256_extracti128_si256(acc, 1));
+        s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+        s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+        h = (val_t)_mm_cvtsi128_si32(s);
+    }
+#endif
+    for (; j < evl; ++j) {
+        h +=  rn[j] * a[j];
+    }
+    return h;
+}
+
+static inline int exponent_vectors_are_equal(
+    const exp_t * const a,
+    const exp_t * const b,
+    const len_t evl
+    )
+{
+    len_t j = 0;
+
+#ifdef HAVE_AVX2
+    for (; j+8 <= evl; j += 8) {
+        const __m128i ea = _mm_loadu_si128((__m128i *)(a+j));
+        const __m128i eb = _mm_loadu_si128((__m128i *)(b+j));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(ea, eb)) != 0xFFFF) {
+            return 0;
+        }
+    }
+#endif
+    for (; j < evl; ++j) {
+        if (a[j] != b[j]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* returns 1 if b divides a, 0 otherwise */
+static inline int exponent_vector_divides(
+    const exp_t * const a,
+    const exp_t * const b,
+    const len_t evl
+    )
+{
+    len_t j = 0;
+
+#ifdef HAVE_AVX2
+    for (; j+8 <= evl; j += 8) {
+        const __m128i ea = _mm_loadu_si128((__m128i *)(a+j));
+        const __m128i eb = _mm_loadu_si128((__m128i *)(b+j));
+        /* b[j] <= a[j] iff max(a[j], b[j]) == a[j] */
+        if (_mm_movemask_epi8(
+                    _mm_cmpeq_epi16(_mm_max_epu16(ea, eb), ea)) != 0xFFFF) {
+            return 0;
+        }
+    }
+#endif
+    for (; j < evl; ++j) {
+        if (a[j] < b[j]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* c = a - b if b divides a, returns 0 and leaves c undefined otherwise */
+static inline int divide_exponent_vectors(
+    exp_t *c,
+    const exp_t * const a,
+    const exp_t * const b,
+    const len_t evl
+    )
+{
+    len_t j = 0;
+
+#ifdef HAVE_AVX2
+    for (; j+8 <= evl; j += 8) {
+        const __m128i ea = _mm_loadu_si128((__m128i *)(a+j));
+        const __m128i eb = _mm_loadu_si128((__m128i *)(b+j));
+        if (_mm_movemask_epi8(
+                    _mm_cmpeq_epi16(_mm_max_epu16(ea, eb), ea)) != 0xFFFF) {
+            return 0;
+        }
+        _mm_storeu_si128((__m128i *)(c+j), _mm_sub_epi16(ea, eb));
+    }
+#endif
+    for (; j < evl; ++j) {
+        if (a[j] < b[j]) {
+            return 0;
+        }
+        c[j] = (exp_t)(a[j] - b[j]);
+    }
+    return 1;
+}
+
+/* c = a + b */
+static inline void multiply_exponent_vectors(
+    exp_t *c,
+    const exp_t * const a,
+    const exp_t * const b,
+    const len_t evl
+    )
+{
+    len_t j = 0;
+
+#ifdef HAVE_AVX2
+    for (; j+8 <= evl; j += 8) {
+        const __m128i ea = _mm_loadu_si128((__m128i *)(a+j));
+        const __m128i eb = _mm_loadu_si128((__m128i *)(b+j));
+        _mm_storeu_si128((__m128i *)(c+j), _mm_add_epi16(ea, eb));
+    }
+#endif
+    for (; j < evl; ++j) {
+        c[j] = (exp_t)(a[j] + b[j]);
+    }
+}
+
+/* Basis hash tables reserve virtual memory for hd, ev and the exponents
+ * once, so enlarging them neither copies data nor moves exponent vectors.
+ * Physical pages are only used when touched and, where supported, are
+ * backed by transparent huge pages. A table reserves room for
+ * 2^HT_VM_GROWTH times its initial size, at most HT_VM_BYTES. All
+ * reservations of the process together stay below VM_TOTAL_BYTES and half
+ * of its address space limit, beyond that memory is taken from the heap. */
+#define HT_VM_BYTES   ((size_t)1 << 38) /* at most 256 GB per hash table */
+#define HT_VM_GROWTH  10
+#define VM_TOTAL_BYTES ((size_t)1 << 40) /* at most 1 TB for all of them */
+
+/* virtual memory currently reserved in bytes */
+static size_t vm_reserved = 0;
+
+static size_t virtual_memory_budget(
+    void
+    )
+{
+    size_t total  = VM_TOTAL_BYTES;
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_AS, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY
+            && (size_t)(rl.rlim_cur / 2) < total) {
+        total = (size_t)(rl.rlim_cur / 2);
+    }
+    return total;
+}
+
+static void *reserve_virtual_memory(
+    const size_t sz
+    )
+{
+    const size_t old  = __atomic_fetch_add(&vm_reserved, sz, __ATOMIC_RELAXED);
+    if (old + sz > virtual_memory_budget()) {
+        __atomic_fetch_sub(&vm_reserved, sz, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    void *p = mmap(NULL, sz, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+        __atomic_fetch_sub(&vm_reserved, sz, __ATOMIC_RELAXED);
+        return NULL;
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(p, sz, MADV_HUGEPAGE);
+#endif
+    return p;
+}
+
+static void release_virtual_memory(
+    void *p,
+    const size_t sz
+    )
+{
+    munmap(p, sz);
+    __atomic_fetch_sub(&vm_reserved, sz, __ATOMIC_RELAXED);
+}
+
+/* number of elements a basis hash table with esz elements reserves
+ * virtual memory for */
+static hl_t virtual_hash_table_size(
+    const hl_t esz,
+    const len_t evl
+    )
+{
+    hl_t vsz  = (hl_t)(HT_VM_BYTES
+            / (sizeof(hd_t) + sizeof(exp_t *) + evl * sizeof(exp_t)));
+    if (esz < vsz >> HT_VM_GROWTH) {
+        vsz = esz << HT_VM_GROWTH;
+    }
+    /* indices of hash table entries are hi_t */
+    if (vsz > (hl_t)1 << 32) {
+        vsz = (hl_t)1 << 32;
+    }
+    return vsz;
+}
+
+/* allocates ev for esz elements, reserves virtual memory for vsz
+ * elements if vsz > 0 and returns NULL if this is not possible */
+static exp_t **allocate_exponent_vectors(
+    const hl_t esz,
+    const len_t evl,
+    const hl_t vsz
+    )
+{
+    hl_t j;
+    exp_t **ev;
+    exp_t *tmp;
+
+    if (vsz > 0) {
+        ev  = (exp_t **)reserve_virtual_memory(vsz * sizeof(exp_t *));
+        tmp = (exp_t *)reserve_virtual_memory(
+                vsz * (unsigned long)evl * sizeof(exp_t));
+        if (ev == NULL || tmp == NULL) {
+            if (ev != NULL) {
+                release_virtual_memory(ev, vsz * sizeof(exp_t *));
+            }
+            if (tmp != NULL) {
+                release_virtual_memory(tmp,
+                        vsz * (unsigned long)evl * sizeof(exp_t));
+            }
+            return NULL;
+        }
+    } else {
+        ev  = (exp_t **)malloc(esz * sizeof(exp_t *));
+        if (ev == NULL) {
+            fprintf(stderr, "Computation needs too much memory on this machine,\n");
+            fprintf(stderr, "could not initialize exponent vector for hash table,\n");
+            fprintf(stderr, "esz = %lu, segmentation fault will follow.\n", (unsigned long)esz);
+        }
+        tmp = (exp_t *)malloc((unsigned long)evl * esz * sizeof(exp_t));
+        if (tmp == NULL) {
+            fprintf(stderr, "Exponent storage needs too much memory on this machine,\n");
+            fprintf(stderr, "initialization failed, esz = %lu,\n", (unsigned long)esz);
+            fprintf(stderr, "segmentation fault will follow.\n");
+        }
+    }
+    for (j = 0; j < esz; ++j) {
+        ev[j]  = tmp + (j*evl);
+    }
+    return ev;
+}
+
+static void free_exponent_vectors(
+    exp_t **ev,
+    const len_t evl,
+    const hl_t vsz
+    )
+{
+    /* note: memory is allocated as one big block,
+     *       so freeing ev[0] is enough */
+    if (vsz > 0) {
+        release_virtual_memory(ev[0], vsz * (unsigned long)evl * sizeof(exp_t));
+        release_virtual_memory(ev, vsz * sizeof(exp_t *));
+    } else {
+        free(ev[0]);
+        free(ev);
+    }
+}
+
+/* allocates hd and ev for ht->esz elements, basis hash tables try to
+ * reserve virtual memory and fall back to the heap */
+static void allocate_hash_table_data(
+    ht_t *ht,
+    const int basis
+    )
+{
+    ht->vsz = 0;
+    if (basis == 1) {
+        const hl_t vsz  = virtual_hash_table_size(ht->esz, ht->evl);
+        if (ht->esz <= vsz) {
+            ht->hd  = (hd_t *)reserve_virtual_memory(vsz * sizeof(hd_t));
+            if (ht->hd != NULL) {
+                ht->ev  = allocate_exponent_vectors(ht->esz, ht->evl, vsz);
+                if (ht->ev != NULL) {
+                    ht->vsz = vsz;
+                    return;
+                }
+                release_virtual_memory(ht->hd, vsz * sizeof(hd_t));
+            }
+        }
+    }
+    ht->hd  = (hd_t *)calloc(ht->esz, sizeof(hd_t));
+    ht->ev  = allocate_exponent_vectors(ht->esz, ht->evl, 0);
+}
+
+static void free_hash_table_data(
+    ht_t *ht
+    )
+{
+    if (ht->hd) {
+        if (ht->vsz > 0) {
+            release_virtual_memory(ht->hd, ht->vsz * sizeof(hd_t));
+        } else {
+            free(ht->hd);
+        }
+        ht->hd  = NULL;
+    }
+    if (ht->ev) {
+        free_exponent_vectors(ht->ev, ht->evl, ht->vsz);
+        ht->ev  = NULL;
+    }
+    ht->vsz = 0;
+}
+
+/* the reserved memory is exhausted, hd and ev are moved to the heap */
+static void move_hash_table_data_to_heap(
+    ht_t *ht,
+    const hl_t osz
+    )
+{
+    hd_t *hd    = (hd_t *)malloc(osz * sizeof(hd_t));
+    memcpy(hd, ht->hd, osz * sizeof(hd_t));
+    exp_t **ev  = allocate_exponent_vectors(osz, ht->evl, 0);
+    memcpy(ev[0], ht->ev[0], osz * (unsigned long)ht->evl * sizeof(exp_t));
+    free_hash_table_data(ht);
+    ht->hd  = hd;
+    ht->ev  = ev;
+}
+
+/* During incremental resizing the elements omig <= i < oeld are only
+ * stored in the old hash map, the ones below omig are already moved to
+ * the new hash map. Newly inserted elements only go to the new hash map. */
+static inline hi_t find_in_old_hash_map(
+    const exp_t * const a,
+    const val_t h,
+    const ht_t * const ht
+    )
+{
+    hl_t i;
+    hi_t k;
+    len_t j;
+
+    const len_t evl = ht->evl;
+    const hi_t mod  = (hi_t)(ht->ohsz - 1);
+
+    k = h;
+    for (i = 0; i < ht->ohsz; ++i) {
+        k = (hi_t)((k+i) & mod);
+        const hi_t hm = ht->ohmap[k];
+        if (!hm) {
+            return 0;
+        }
+        if (hm < ht->omig || ht->hd[hm].val != h) {
+            continue;
+        }
+        const exp_t * const ehm = ht->ev[hm];
+        for (j = 0; j < evl; ++j) {
+            if (a[j] != ehm[j]) {
+                break;
+            }
+        }
+        if (j == evl) {
+            return hm;
+        }
+    }
+    return 0;
+}
+
+/* moves up to nm elements from the old to the new hash map */
+static void move_to_new_hash_map(
+    ht_t *ht,
+    const hl_t nm
+    )
+{
+    hl_t i, j;
+    hi_t k;
+
+    const hl_t hsz  = ht->hsz;
+    const hi_t mod  = (hi_t)(hsz - 1);
+    const hl_t end  = ht->omig + nm < ht->oeld ? ht->omig + nm : ht->oeld;
+
+    for (i = ht->omig; i < end; ++i) {
+        k = ht->hd[i].val;
+        for (j = 0; j < hsz; ++j) {
+            k = (hi_t)((k+j) & mod);
+            if (ht->hmap[k]) {
+                continue;
+            }
+            ht->hmap[k] = (hi_t)i;
+            break;
+        }
+    }
+    ht->omig  = end;
+    if (ht->omig == ht->oeld) {
+        free(ht->ohmap);
+        ht->ohmap = NULL;
+        ht->ohsz  = 0;
+    }
+}
+
+/* Each insertion moves a few elements to the new hash map, so resizing is
+ * finished long before the hash table has to be enlarged again. */
+#define HT_MIGRATION_STEP 4
+
+static inline void continue_hash_map_resizing(
+    ht_t *ht
+    )
+{
+    if (ht->ohmap != NULL) {
+        move_to_new_hash_map(ht, HT_MIGRATION_STEP);
+    }
+}
+
+static inline void finish_hash_map_resizing(
+    ht_t *ht
+    )
+{
+    if (ht->ohmap != NULL) {
+        move_to_new_hash_map(ht, ht->oeld);
+    }
+}
+
 ht_t *initialize_basis_hash_table(
     md_t *st
     )
 {
     len_t i;
-    hl_t j;
 
     const len_t nv  = st->nvars;
 
@@ -105,24 +541,13 @@ ht_t *initialize_basis_hash_table(
     /* generate exponent vector */
     /* keep first entry empty for faster divisibility checks */
     ht->eld = 1;
-    ht->hd  = (hd_t *)calloc(ht->esz, sizeof(hd_t));
-    ht->ev  = (exp_t **)malloc(ht->esz * sizeof(exp_t *));
-    if (ht->ev == NULL) {
-        fprintf(stderr, "Computation needs too much memory on this machine,\n");
-        fprintf(stderr, "could not initialize exponent vector for hash table,\n");
-        fprintf(stderr, "esz = %lu, segmentation fault will follow.\n", (unsigned long)ht->esz);
-    }
-    exp_t *tmp  = (exp_t *)malloc(
-            (unsigned long)ht->evl * ht->esz * sizeof(exp_t));
-    if (tmp == NULL) {
-        fprintf(stderr, "Exponent storage needs too much memory on this machine,\n");
-        fprintf(stderr, "initialization failed, esz = %lu,\n", (unsigned long)ht->esz);
-        fprintf(stderr, "segmentation fault will follow.\n");
-    }
-    const hl_t esz  = ht->esz;
-    for (j = 0; j < esz; ++j) {
-        ht->ev[j]  = tmp + (j*ht->evl);
-    }
+    allocate_hash_table_data(ht, 1);
+    /* the hash map of the basis hash table is resized incrementally */
+    ht->irs   = 1;
+    ht->ohmap = NULL;
+    ht->ohsz  = 0;
+    ht->omig  = 0;
+    ht->oeld  = 0;
     st->max_bht_size  = ht->esz;
     return ht;
 }
@@ -131,8 +556,6 @@ ht_t *copy_hash_table(
     const ht_t *bht
     )
 {
-    hl_t j;
-
     ht_t *ht  = (ht_t *)malloc(sizeof(ht_t));
 
     ht->nv    = bht->nv;
@@ -154,27 +577,22 @@ ht_t *copy_hash_table(
 
     /* generate exponent vector */
     /* keep first entry empty for faster divisibility checks */
-    ht->hd  = (hd_t *)calloc(ht->esz, sizeof(hd_t));
+    allocate_hash_table_data(ht, 1);
 
     memcpy(ht->hd, bht->hd, (unsigned long)ht->esz * sizeof(hd_t));
-    ht->ev  = (exp_t **)malloc(ht->esz * sizeof(exp_t *));
-    if (ht->ev == NULL) {
-        fprintf(stderr, "Computation needs too much memory on this machine,\n");
-        fprintf(stderr, "could not initialize exponent vector for hash table,\n");
-        fprintf(stderr, "esz = %lu, segmentation fault will follow.\n", (unsigned long)ht->esz);
-    }
-    exp_t *tmp  = (exp_t *)malloc(
+    memcpy(ht->ev[0], bht->ev[0],
             (unsigned long)ht->evl * ht->esz * sizeof(exp_t));
-    if (tmp == NULL) {
-        fprintf(stderr, "Exponent storage needs too much memory on this machine,\n");
-        fprintf(stderr, "initialization failed, esz = %lu,\n", (unsigned long)ht->esz);
-        fprintf(stderr, "segmentation fault will follow.\n");
-    }
-    memcpy(tmp, bht->ev[0], (unsigned long)ht->evl * ht->esz * sizeof(exp_t));
     ht->eld = bht->eld;
-    const hl_t esz  = ht->esz;
-    for (j = 0; j < esz; ++j) {
-        ht->ev[j]  = tmp + (j*ht->evl);
+
+    /* take over the state of an unfinished resizing of the hash map */
+    ht->irs   = bht->irs;
+    ht->ohmap = NULL;
+    ht->ohsz  = bht->ohsz;
+    ht->omig  = bht->omig;
+    ht->oeld  = bht->oeld;
+    if (bht->ohmap != NULL) {
+        ht->ohmap = (hi_t *)malloc((unsigned long)ht->ohsz * sizeof(hi_t));
+        memcpy(ht->ohmap, bht->ohmap, (unsigned long)ht->ohsz * sizeof(hi_t));
     }
     return ht;
 }
@@ -185,8 +603,6 @@ ht_t *initialize_secondary_hash_table(
     const md_t * const md
     )
 {
-    hl_t j;
-
     ht_t *ht  = (ht_t *)malloc(sizeof(ht_t)); 
     ht->nv    = bht->nv;
     ht->evl   = bht->evl;
@@ -208,24 +624,12 @@ ht_t *initialize_secondary_hash_table(
     /* generate exponent vector */
     /* keep first entry empty for faster divisibility checks */
     ht->eld = 1;
-    ht->hd  = (hd_t *)calloc(ht->esz, sizeof(hd_t));
-    ht->ev  = (exp_t **)malloc(ht->esz * sizeof(exp_t *));
-    if (ht->ev == NULL) {
-        fprintf(stderr, "Computation needs too much memory on this machine,\n");
-        fprintf(stderr, "could not initialize exponent vector for hash table,\n");
-        fprintf(stderr, "esz = %lu, segmentation fault will follow.\n", (unsigned long)ht->esz);
-    }
-    exp_t *tmp  = (exp_t *)malloc(
-            (unsigned long)ht->evl * ht->esz * sizeof(exp_t));
-    if (tmp == NULL) {
-        fprintf(stderr, "Exponent storage needs too much memory on this machine,\n");
-        fprintf(stderr, "initialization failed, esz = %lu,\n", (unsigned long)ht->esz);
-        fprintf(stderr, "segmentation fault will follow.\n");
-    }
-    const hl_t esz  = ht->esz;
-    for (j = 0; j < esz; ++j) {
-        ht->ev[j]  = tmp + (j*ht->evl);
-    }
+    allocate_hash_table_data(ht, 0);
+    ht->irs   = 0;
+    ht->ohmap = NULL;
+    ht->ohsz  = 0;
+    ht->omig  = 0;
+    ht->oeld  = 0;
     return ht;
 }
 
@@ -258,17 +662,11 @@ void free_hash_table(
         free(ht->hmap);
         ht->hmap = NULL;
     }
-    if (ht->hd) {
-        free(ht->hd);
-        ht->hd  = NULL;
-    }
-    if (ht->ev) {
-        /* note: memory is allocated as one big block,
-            *       so freeing ev[0] is enough */
-        free(ht->ev[0]);
-        free(ht->ev);
-        ht->ev  = NULL;
+    if (ht->ohmap) {
+        free(ht->ohmap);
+        ht->ohmap = NULL;
     }
+    free_hash_table_data(ht);
     free(ht);
     ht    = NULL;
     *htp  = ht;
@@ -283,17 +681,11 @@ void full_free_hash_table(
     free(ht->hmap);
     ht->hmap = NULL;
   }
-  if (ht->hd) {
-    free(ht->hd);
-    ht->hd  = NULL;
-  }
-  if (ht->ev) {
-    /* note: memory is allocated as one big block,
-     *       so freeing ev[0] is enough */
-    free(ht->ev[0]);
-    free(ht->ev);
-    ht->ev  = NULL;
+  if (ht->ohmap) {
+    free(ht->ohmap);
+    ht->ohmap = NULL;
   }
+  free_hash_table_data(ht);
   if (ht != NULL) {
     if (ht->rn) {
       free(ht->rn);
@@ -321,29 +713,41 @@ static void enlarge_hash_table(
     hl_t i, j;
     val_t h, k;
 
+    const hl_t oesz = ht->esz;
     ht->esz = 2 * ht->esz;
     const hl_t esz  = ht->esz;
     const hi_t eld  = ht->eld;
 
-    ht->hd    = realloc(ht->hd, esz * sizeof(hd_t));
-    memset(ht->hd+eld, 0, (esz-eld) * sizeof(hd_t));
-    ht->ev    = realloc(ht->ev, esz * sizeof(exp_t *));
-    if (ht->ev == NULL) {
-        fprintf(stderr, "Enlarging hash table failed for esz = %lu,\n", (unsigned long)esz);
-        fprintf(stderr, "segmentation fault will follow.\n");
-    }
-    /* note: memory is allocated as one big block, so reallocating
-     *       memory from ev[0] is enough    */
-    ht->ev[0] = realloc(ht->ev[0],
-            esz * (unsigned long)ht->evl * sizeof(exp_t));
-    if (ht->ev[0] == NULL) {
-        fprintf(stderr, "Enlarging exponent vector for hash table failed\n");
-        fprintf(stderr, "for esz = %lu, segmentation fault will follow.\n", (unsigned long)esz);
+    if (ht->vsz > 0 && esz > ht->vsz) {
+        move_hash_table_data_to_heap(ht, oesz);
     }
-    /* due to realloc we have to reset ALL ev entries,
-     * memory might have been moved */
-    for (i = 1; i < esz; ++i) {
-        ht->ev[i] = ht->ev[0] + (i*ht->evl);
+    if (ht->vsz > 0) {
+        /* memory is reserved, all data stays in place */
+        memset(ht->hd+eld, 0, (esz-eld) * sizeof(hd_t));
+        for (i = oesz; i < esz; ++i) {
+            ht->ev[i] = ht->ev[0] + (i*ht->evl);
+        }
+    } else {
+        ht->hd    = realloc(ht->hd, esz * sizeof(hd_t));
+        memset(ht->hd+eld, 0, (esz-eld) * sizeof(hd_t));
+        ht->ev    = realloc(ht->ev, esz * sizeof(exp_t *));
+        if (ht->ev == NULL) {
+            fprintf(stderr, "Enlarging hash table failed for esz = %lu,\n", (unsigned long)esz);
+            fprintf(stderr, "segmentation fault will follow.\n");
+        }
+        /* note: memory is allocated as one big block, so reallocating
+         *       memory from ev[0] is enough    */
+        ht->ev[0] = realloc(ht->ev[0],
+                esz * (unsigned long)ht->evl * sizeof(exp_t));
+        if (ht->ev[0] == NULL) {
+            fprintf(stderr, "Enlarging exponent vector for hash table failed\n");
+            fprintf(stderr, "for esz = %lu, segmentation fault will follow.\n", (unsigned long)esz);
+        }
+        /* due to realloc we have to reset ALL ev entries,
+         * memory might have been moved */
+        for (i = 1; i < esz; ++i) {
+            ht->ev[i] = ht->ev[0] + (i*ht->evl);
+        }
     }
 
     /* The hash table should be double the size of the exponent space in
@@ -351,7 +755,21 @@ static void enlarge_hash_table(
      * enlarge to 2^31 elements that's the limit we can go. Thus we cannot
      * enlarge the hash table size any further and have to live with more
      * than 50% fill in. */
-    if (ht->hsz < (hl_t)pow(2,32)) {
+    if (ht->hsz < (hl_t)pow(2,32) && ht->irs == 1) {
+        /* keep the old hash map, its elements are moved to the new one
+         * step by step during the following insertions */
+        finish_hash_map_resizing(ht);
+        ht->ohmap = ht->hmap;
+        ht->ohsz  = ht->hsz;
+        ht->omig  = 1;
+        ht->oeld  = eld;
+        ht->hsz   = 2 * ht->hsz;
+        ht->hmap  = calloc(ht->hsz, sizeof(hi_t));
+        if (ht->hmap == NULL) {
+            fprintf(stderr, "Enlarging hash table failed for hsz = %lu,\n", (unsigned long)ht->hsz);
+            fprintf(stderr, "segmentation fault will follow.\n");
+        }
+    } else if (ht->hsz < (hl_t)pow(2,32)) {
         ht->hsz = 2 * ht->hsz;
         const hl_t hsz  = ht->hsz;
         ht->hmap  = realloc(ht->hmap, hsz * sizeof(hi_t));
@@ -479,8 +897,6 @@ static inline hi_t check_monomial_division(
     const ht_t *ht
     )
 {
-  len_t i;
-
   /* short divisor mask check */
   if (ht->hd[b].sdm & ~ht->hd[a].sdm) {
     return 0;
@@ -493,15 +909,7 @@ static inline hi_t check_monomial_division(
 
   /* printf("! no sdm decision !\n"); */
   /* exponent check */
-  for (i = 0; i < evl-1; i += 2) {
-    if (ea[i] < eb[i] || ea[i+1] < eb[i+1]) {
-      return 0;
-    }
-  }
-  if (ea[evl-1] < eb[evl-1]) {
-    return 0;
-  }
-  return 1;
+  return exponent_vector_divides(ea, eb, evl);
 }
 
 static inline void check_monomial_division_in_update(
@@ -512,16 +920,14 @@ static inline void check_monomial_division_in_update(
     const ht_t *ht
     )
 {
-    len_t i, j;
+    len_t j;
     const len_t evl = ht->evl;
 
     const sdm_t sb        = ht->hd[b].sdm;
     const exp_t *const eb = ht->ev[b];
     /* pairs are sorted, we only have to search entries
      * above the starting point */
-        j = start+1;
-restart:
-    for (; j < end; ++j) {
+    for (j = start+1; j < end; ++j) {
         if (a[j] == 0) {
             continue;
         }
@@ -529,15 +935,8 @@ restart:
         if (~ht->hd[a[j]].sdm & sb) {
             continue;
         }
-        const exp_t *const ea = ht->ev[a[j]];
         /* exponent check */
-        for (i = 0; i < evl-1; i += 2) {
-            if (ea[i] < eb[i] || ea[i+1] < eb[i+1]) {
-                j++;
-                goto restart;
-            }
-        }
-        if (ea[evl-1] < eb[evl-1]) {
+        if (!exponent_vector_divides(ht->ev[a[j]], eb, evl)) {
             continue;
         }
         a[j]  = 0;
@@ -552,7 +951,6 @@ static inline hi_t check_lm_divisibility_and_insert_in_hash_table(
 {
     hl_t i;
     hi_t k, pos;
-    len_t j;
     exp_t *e;
     hd_t *d;
     const len_t lml   = bs->lml;
@@ -575,12 +973,9 @@ start:
         i++;
     }
     if (i < lml) {
-        e = ht->ev[bs->hm[lmps[i]][OFFSET]];
-        for (j = 0; j < evl; ++j) {
-            if (e[j] > a[j]) {
-                i++;
-                goto start;
-            }
+        if (!exponent_vector_divides(a, ht->ev[bs->hm[lmps[i]][OFFSET]], evl)) {
+            i++;
+            goto start;
         }
         /* divisible by lm */
         return 0;
@@ -589,13 +984,10 @@ start:
      * lead monomial and we can add it to the hash table */
 
     /* generate hash value */
-    for (j = 0; j < evl; ++j) {
-        h +=  ht->rn[j] * a[j];
-    }
+    h = hash_exponent_vector(a, ht->rn, evl);
     /* probing */
     k = h;
     i = 0;
-restart:
     for (; i < hsz; ++i) {
         k = (hi_t)((k+i) & mod);
         const hi_t hm = ht->hmap[k];
@@ -605,19 +997,14 @@ restart:
         if (ht->hd[hm].val != h) {
             continue;
         }
-        const exp_t * const ehm = ht->ev[hm];
-        for (j = 0; j < evl-1; j += 2) {
-            if (a[j] != ehm[j] || a[j+1] != ehm[j+1]) {
-                i++;
-                goto restart;
-            }
-        }
-        if (a[evl-1] != ehm[evl-1]) {
-            i++;
-            goto restart;
+        if (!exponent_vectors_are_equal(a, ht->ev[hm], evl)) {
+            continue;
         }
         return hm;
     }
+    if (ht->ohmap != NULL && (pos = find_in_old_hash_map(a, h, ht)) != 0) {
+        return pos;
+    }
 
     /* add element to hash table */
     ht->hmap[k]  = pos = (hi_t)ht->eld;
@@ -630,6 +1017,7 @@ restart:
     d->val  =   h;
 
     ht->eld++;
+    continue_hash_map_resizing(ht);
 
     return pos;
 }
@@ -661,7 +1049,6 @@ static inline hi_t insert_multiplied_signature_in_hash_table(
     /* probing */
     k = h;
     i = 0;
-restart:
     for (; i < hsz; ++i) {
         k = (hi_t)((k+i) & mod);
         const hi_t hm = ht->hmap[k];
@@ -671,19 +1058,14 @@ restart:
         if (ht->hd[hm].val != h) {
             continue;
         }
-        const exp_t * const ehm = ht->ev[hm];
-        for (j = 0; j < evl-1; j += 2) {
-            if (a[j] != ehm[j] || a[j+1] != ehm[j+1]) {
-                i++;
-                goto restart;
-            }
-        }
-        if (a[evl-1] != ehm[evl-1]) {
-            i++;
-            goto restart;
+        if (!exponent_vectors_are_equal(a, ht->ev[hm], evl)) {
+            continue;
         }
         return hm;
     }
+    if (ht->ohmap != NULL && (pos = find_in_old_hash_map(a, h, ht)) != 0) {
+        return pos;
+    }
 
     /* add element to hash table */
     ht->hmap[k]  = pos = (hi_t)ht->eld;
@@ -696,6 +1078,7 @@ restart:
     d->val  =   h;
 
     ht->eld++;
+    continue_hash_map_resizing(ht);
 
     return pos;
 }
@@ -716,7 +1099,6 @@ static inline int32_t is_contained_in_hash_table(
 {
     hl_t i;
     hi_t k;
-    len_t j;
     /* const len_t evl = ht->evl;
      * const hl_t hsz = ht->hsz; */
     /* ht->hsz <= 2^32 => mod is always uint32_t */
@@ -725,27 +1107,25 @@ static inline int32_t is_contained_in_hash_table(
     /* probing */
     k = h;
     i = 0;
-restart:
     for (; i < ht->hsz; ++i) {
         k = (hi_t)((k+i) & mod);
         const hi_t hm = ht->hmap[k];
         if (!hm) {
+            if (ht->ohmap != NULL) {
+                const hi_t ohm = find_in_old_hash_map(a, h, ht);
+                if (ohm != 0) {
+                    *kp = ohm;
+                    return 1;
+                }
+            }
             *kp = k;
             return 0;
         }
         if (ht->hd[hm].val != h) {
             continue;
         }
-        const exp_t * const ehm = ht->ev[hm];
-        for (j = 0; j < ht->evl-1; j += 2) {
-            if (a[j] != ehm[j] || a[j+1] != ehm[j+1]) {
-                i++;
-                goto restart;
-            }
-        }
-        if (a[ht->evl-1] != ehm[ht->evl-1]) {
-            i++;
-            goto restart;
+        if (!exponent_vectors_are_equal(a, ht->ev[hm], ht->evl)) {
+            continue;
         }
         *kp = hm;
         return 1;
@@ -775,6 +1155,7 @@ static inline len_t add_to_hash_table(
     d->val  =   h;
 
     ht->eld++;
+    continue_hash_map_resizing(ht);
 
     return pos;
 }
@@ -787,9 +1168,7 @@ static inline len_t check_insert_in_hash_table(
 {
     if (h == 0) {
         /* generate hash value */
-        for (len_t j = 0; j < ht->evl; ++j) {
-            h +=  ht->rn[j] * a[j];
-        }
+        h = hash_exponent_vector(a, ht->rn, ht->evl);
     }
 
     hi_t k  = 0;
@@ -814,30 +1193,26 @@ static inline len_t check_insert_in_hash_table(
 #endif
 }
 
-static inline hi_t insert_in_hash_table(
+/* h has to be the hash value of a, e.g. the sum of the hash values of
+ * two monomials whose product is a */
+static inline hi_t insert_in_hash_table_with_value(
     const exp_t *a,
+    const val_t h,
     ht_t *ht
     )
 {
     hl_t i;
     hi_t k, pos;
-    len_t j;
     exp_t *e;
     hd_t *d;
-    val_t h = 0;
     const len_t evl = ht->evl;
     const hl_t hsz = ht->hsz;
     /* ht->hsz <= 2^32 => mod is always uint32_t */
     const hi_t mod = (hi_t)(ht->hsz - 1);
 
-    /* generate hash value */
-    for (j = 0; j < evl; ++j) {
-        h +=  ht->rn[j] * a[j];
-    }
     /* probing */
     k = h;
     i = 0;
-restart:
     for (; i < hsz; ++i) {
         k = (hi_t)((k+i) & mod);
         const hi_t hm = ht->hmap[k];
@@ -847,19 +1222,14 @@ restart:
         if (ht->hd[hm].val != h) {
             continue;
         }
-        const exp_t * const ehm = ht->ev[hm];
-        for (j = 0; j < evl-1; j += 2) {
-            if (a[j] != ehm[j] || a[j+1] != ehm[j+1]) {
-                i++;
-                goto restart;
-            }
-        }
-        if (a[evl-1] != ehm[evl-1]) {
-            i++;
-            goto restart;
+        if (!exponent_vectors_are_equal(a, ht->ev[hm], evl)) {
+            continue;
         }
         return hm;
     }
+    if (ht->ohmap != NULL && (pos = find_in_old_hash_map(a, h, ht)) != 0) {
+        return pos;
+    }
 
     /* add element to hash table */
     ht->hmap[k]  = pos = (hi_t)ht->eld;
@@ -872,10 +1242,22 @@ restart:
     d->val  =   h;
 
     ht->eld++;
+    continue_hash_map_resizing(ht);
 
     return pos;
 }
 
+static inline hi_t insert_in_hash_table(
+    const exp_t *a,
+    ht_t *ht
+    )
+{
+    /* generate hash value */
+    const val_t h = hash_exponent_vector(a, ht->rn, ht->evl);
+
+    return insert_in_hash_table_with_value(a, h, ht);
+}
+
 static inline void reinitialize_hash_table(
     ht_t *ht,
     const hl_t size
@@ -923,6 +1305,11 @@ static inline void clean_hash_table(
         ht_t *ht
     )
 {
+    if (ht->ohmap != NULL) {
+        free(ht->ohmap);
+        ht->ohmap = NULL;
+        ht->ohsz  = 0;
+    }
     memset(ht->hd, 0, ht->esz * sizeof(hd_t));
     memset(ht->hmap, 0, ht->hsz * sizeof(hi_t));
 
@@ -969,7 +1356,7 @@ static inline void insert_plcms_in_basis_hash_table(
 {
     hl_t i;
     hi_t k, pos;
-    len_t j, l, m;
+    len_t l, m;
     hd_t *d;
 
     spair_t *ps     = psl->p;
@@ -996,7 +1383,6 @@ letsgo:
         const exp_t * const n = bht->ev[bht->eld];
         k = h;
         i = 0;
-restart:
         for (; i < hsz; ++i) {
             k = (hi_t)(k+i) & mod;
             const hi_t hm = bht->hmap[k];
@@ -1006,21 +1392,18 @@ restart:
             if (bht->hd[hm].val != h) {
                 continue;
             }
-            const exp_t * const ehm = bht->ev[hm];
-            for (j = 0; j < evl-1; j += 2) {
-                if (n[j] != ehm[j] || n[j+1] != ehm[j+1]) {
-                    i++;
-                    goto restart;
-                }
-            }
-            if (n[evl-1] != ehm[evl-1]) {
-                i++;
-                goto restart;
+            if (!exponent_vectors_are_equal(n, bht->ev[hm], evl)) {
+                continue;
             }
             ps[m++].lcm = hm;
             l++;
             goto letsgo;
         }
+        if (bht->ohmap != NULL
+                && (pos = find_in_old_hash_map(n, h, bht)) != 0) {
+            ps[m++].lcm = pos;
+            continue;
+        }
 
         /* add element to hash table */
         bht->hmap[k] = pos = (hi_t)bht->eld;
@@ -1030,6 +1413,7 @@ restart:
         d->val  = h;
 
         bht->eld++;
+        continue_hash_map_resizing(bht);
         ps[m++].lcm =  pos;
     }
     psl->ld = m;
@@ -1119,7 +1503,7 @@ static inline void insert_multiplied_poly_in_hash_table(
     ht_t *ht2
     )
 {
-    len_t j, l;
+    len_t l;
     exp_t *n;
 
     const len_t len = b[LENGTH]+OFFSET;
@@ -1136,15 +1520,14 @@ static inline void insert_multiplied_poly_in_hash_table(
         const exp_t * const eb = ev1[b[l]];
 
         n = ev2[ht2->eld];
-        for (j = 0; j < evl; ++j) {
-            n[j]  = (exp_t)(ea[j] + eb[j]);
-        }
+        multiply_exponent_vectors(n, ea, eb, evl);
 
-#if PARALLEL_HASHING
+        /* hash values are linear */
         const val_t h   = h1 + hd1[b[l]].val;
+#if PARALLEL_HASHING
         row[l] = check_insert_in_hash_table(n, h, ht2);
 #else
-        row[l] = insert_in_hash_table(n, ht2);
+        row[l] = insert_in_hash_table_with_value(n, h, ht2);
 #endif
     }
 }
@@ -1157,7 +1540,7 @@ static inline void reinsert_in_hash_table(
 {
     hl_t i;
     hi_t k, pos;
-    len_t j, l;
+    len_t l;
     exp_t *e;
     hd_t *d;
     val_t h;
@@ -1172,13 +1555,9 @@ letsgo:
     for (; l < len; ++l) {
         const exp_t * const n = oev[row[l]];
         /* generate hash value */
-        h = 0;
-        for (j = 0; j < evl; ++j) {
-            h +=  ht->rn[j] * n[j];
-        }
+        h = hash_exponent_vector(n, ht->rn, evl);
         k = h;
         i = 0;
-restart:
         for (; i < hsz; ++i) {
             k = (hi_t)(k+i) & mod;
             const hi_t hm  = ht->hmap[k];
@@ -1188,16 +1567,8 @@ restart:
             if (ht->hd[hm].val != h) {
                 continue;
             }
-            const exp_t * const ehm = ht->ev[hm];
-            for (j = 0; j < evl-1; j += 2) {
-                if (n[j] != ehm[j] || n[j+1] != ehm[j+1]) {
-                    i++;
-                    goto restart;
-                }
-            }
-            if (n[evl-1] != ehm[evl-1]) {
-                i++;
-                goto restart;
+            if (!exponent_vectors_are_equal(n, ht->ev[hm], evl)) {
+                continue;
             }
             row[l] = hm;
             l++;
@@ -1243,7 +1614,6 @@ static void reset_hash_table(
     rt0 = realtime();
 
     len_t i;
-    hi_t k;
     exp_t *e;
 
     spair_t *ps = psl->p;
@@ -1254,21 +1624,35 @@ static void reset_hash_table(
     const bl_t bld  = bs->ld;
     const len_t pld = psl->ld;
 
-    ht->ev  = calloc(esz, sizeof(exp_t *));
+    /* the old exponents are needed for reinserting the elements, a
+     * reserved region is released before a new one is reserved, so they
+     * are kept on the heap meanwhile */
+    if (ht->vsz > 0) {
+        oev = allocate_exponent_vectors(ht->eld, evl, 0);
+        memcpy(oev[0], ht->ev[0],
+                (unsigned long)ht->eld * evl * sizeof(exp_t));
+        free_exponent_vectors(ht->ev, evl, ht->vsz);
+        ht->ev  = allocate_exponent_vectors(esz, evl, ht->vsz);
+        if (ht->ev == NULL) {
+            /* continue on the heap */
+            release_virtual_memory(ht->hd, ht->vsz * sizeof(hd_t));
+            ht->vsz = 0;
+            ht->hd  = (hd_t *)malloc(esz * sizeof(hd_t));
+            ht->ev  = allocate_exponent_vectors(esz, evl, 0);
+        }
+    } else {
+        ht->ev  = allocate_exponent_vectors(esz, evl, 0);
+    }
     if (ht->ev == NULL) {
         fprintf(stderr, "Computation needs too much memory on this machine,\n");
         fprintf(stderr, "cannot reset ht->ev, esz = %lu\n", (unsigned long)esz);
         fprintf(stderr, "segmentation fault will follow.\n");
     }
-    exp_t *tmp  = (exp_t *)malloc(
-            (unsigned long)evl * esz * sizeof(exp_t));
-    if (tmp == NULL) {
-        fprintf(stderr, "Computation needs too much memory on this machine,\n");
-        fprintf(stderr, "resetting table failed, esz = %lu\n", (unsigned long)esz);
-        fprintf(stderr, "segmentation fault will follow.\n");
-    }
-    for (k = 0; k < esz; ++k) {
-        ht->ev[k]  = tmp + k*evl;
+    /* all elements are reinserted, an unfinished resizing is dropped */
+    if (ht->ohmap != NULL) {
+        free(ht->ohmap);
+        ht->ohmap = NULL;
+        ht->ohsz  = 0;
     }
     ht->eld = 1;
     memset(ht->hmap, 0, ht->hsz * sizeof(hi_t));
@@ -1288,10 +1672,7 @@ static void reset_hash_table(
         ps[i].lcm = insert_in_hash_table(e, ht);
 #endif
     }
-    /* note: all memory is allocated as a big block, so it is
-     *       enough to free oev[0].       */
-    free(oev[0]);
-    free(oev);
+    free_exponent_vectors(oev, evl, 0);
 
     /* timings */
     ct1 = cputime();
@@ -1344,6 +1725,160 @@ static inline hi_t get_lcm(
 #endif
 }
 
+/* Rows generated during symbolic preprocessing only live until the end of
+ * the linear algebra of the same round. Instead of allocating each of them
+ * on its own they are taken from a row arena: a region of virtual memory
+ * is reserved per F4 run and handed out to the threads in blocks, inside
+ * a block a row is allocated by bumping a pointer. The arena is reset at
+ * the end of each round, so its pages are reused by the next round. When
+ * the rows of a round did not fit, the region is enlarged to hold them
+ * for the next round, up to RA_RESERVE. Rows not coming from the arena
+ * (new pivots, basis elements, rows of a full arena) are malloc'ed, thus
+ * matrix rows have to be freed with free_matrix_row(). */
+#define RA_INITIAL ((size_t)1 << 28) /* 256 MB for the first round */
+#define RA_RESERVE ((size_t)1 << 36) /* at most 64 GB of virtual memory */
+#define RA_BLOCK   ((size_t)1 << 20) /* 1 MB per block */
+
+static ra_t *initialize_row_arena(
+    const int32_t nthrds
+    )
+{
+  void *base  = reserve_virtual_memory(RA_INITIAL);
+  /* if we cannot reserve the memory rows are malloc'ed */
+  if (base == NULL) {
+    return NULL;
+  }
+  ra_t *ra    = (ra_t *)malloc(sizeof(ra_t));
+  ra->base    = (char *)base;
+  ra->sz      = RA_INITIAL;
+  ra->ld      = 0;
+  ra->ovf     = 0;
+  ra->nthrds  = nthrds > 0 ? nthrds : 1;
+  /* blocks of different threads have to be on different cache lines */
+  void *tb    = NULL;
+  if (posix_memalign(&tb, 64,
+              (unsigned long)ra->nthrds * sizeof(rab_t)) != 0) {
+    release_virtual_memory(ra->base, ra->sz);
+    free(ra);
+    return NULL;
+  }
+  ra->tb      = (rab_t *)tb;
+  memset(ra->tb, 0, (unsigned long)ra->nthrds * sizeof(rab_t));
+
+  return ra;
+}
+
+/* all rows of the arena are invalid afterwards */
+static inline void reset_row_arena(
+    ra_t *ra
+    )
+{
+  if (ra == NULL) {
+    return;
+  }
+  /* the rows of this round did not fit, the next round gets a region
+   * large enough for them; without one all rows are malloc'ed */
+  if (ra->ovf > 0 && ra->sz < RA_RESERVE) {
+    size_t sz = ra->sz > 0 ? ra->sz : RA_INITIAL;
+    while (sz < ra->sz + ra->ovf && sz < RA_RESERVE) {
+      sz  *=  2;
+    }
+    if (ra->base != NULL) {
+      release_virtual_memory(ra->base, ra->sz);
+    }
+    ra->base  = (char *)reserve_virtual_memory(sz);
+    ra->sz    = ra->base != NULL ? sz : 0;
+  }
+  ra->ld  = 0;
+  ra->ovf = 0;
+  memset(ra->tb, 0, (unsigned long)ra->nthrds * sizeof(rab_t));
+}
+
+static void free_row_arena(
+    ra_t **rap
+    )
+{
+  ra_t *ra  = *rap;
+  if (ra == NULL) {
+    return;
+  }
+  if (ra->base != NULL) {
+    release_virtual_memory(ra->base, ra->sz);
+  }
+  free(ra->tb);
+  free(ra);
+  *rap  = NULL;
+}
+
+static inline int is_in_row_arena(
+    const ra_t * const ra,
+    const hm_t * const row
+    )
+{
+  return ra != NULL && ra->base != NULL && (const char *)row >= ra->base
+    && (const char *)row < ra->base + ra->sz;
+}
+
+/* may be called concurrently by the threads of one parallel region */
+static inline hm_t *allocate_matrix_row(
+    ra_t *ra,
+    const len_t len
+    )
+{
+  const size_t sz = (size_t)(len+OFFSET) * sizeof(hm_t);
+  if (ra == NULL) {
+    return (hm_t *)malloc(sz);
+  }
+  const int32_t t = omp_get_thread_num();
+  if (t >= ra->nthrds) {
+    return (hm_t *)malloc(sz);
+  }
+  /* keep rows 16 byte aligned */
+  const size_t asz  = (sz + 15) & ~(size_t)15;
+  rab_t *b  = ra->tb + t;
+  if (b->cur == NULL || (size_t)(b->end - b->cur) < asz) {
+    const size_t bsz  = asz > RA_BLOCK ? asz : RA_BLOCK;
+    const size_t pos  = __atomic_fetch_add(&ra->ld, bsz, __ATOMIC_RELAXED);
+    if (pos + bsz > ra->sz) {
+      __atomic_fetch_add(&ra->ovf, asz, __ATOMIC_RELAXED);
+      return (hm_t *)malloc(sz);
+    }
+    b->cur  = ra->base + pos;
+    b->end  = b->cur + bsz;
+  }
+  hm_t *row = (hm_t *)b->cur;
+  b->cur    +=  asz;
+
+  return row;
+}
+
+static inline void free_matrix_row(
+    const ra_t * const ra,
+    hm_t *row
+    )
+{
+  if (!is_in_row_arena(ra, row)) {
+    free(row);
+  }
+}
+
+/* rows which become basis elements have to survive the reset of the
+ * arena, so they are moved to malloc'ed memory */
+static inline hm_t *move_row_out_of_arena(
+    const ra_t * const ra,
+    hm_t *row
+    )
+{
+  if (!is_in_row_arena(ra, row)) {
+    return row;
+  }
+  const size_t sz = (size_t)(row[LENGTH]+OFFSET) * sizeof(hm_t);
+  hm_t *nrow  = (hm_t *)malloc(sz);
+  memcpy(nrow, row, sz);
+
+  return nrow;
+}
+
 static inline hm_t *poly_to_matrix_row(
     ht_t *sht,
     const ht_t *bht,
@@ -1364,7 +1899,70 @@ static inline hm_t *poly_to_matrix_row(
 
   return row;
 }
+/* Generates the row of the multiple of poly by the monomial (hm, em)
+ * without modifying the secondary hash table sht: terms already contained
+ * in sht get their index, all other terms are set to 0 and have to be
+ * inserted afterwards by insert_missing_multiplied_poly_in_hash_table().
+ * Thus several rows can be generated concurrently. */
+static inline hm_t *lookup_multiplied_poly_in_hash_table(
+    ra_t *ra,
+    const ht_t * const sht,
+    const ht_t * const bht,
+    const val_t hm,
+    const exp_t * const em,
+    const hm_t *poly
+    )
+{
+  len_t l;
+  hi_t k;
+
+  const len_t len = poly[LENGTH]+OFFSET;
+  const len_t evl = bht->evl;
+
+  exp_t n[evl];
+
+  hm_t *row = allocate_matrix_row(ra, poly[LENGTH]);
+  row[COEFFS]   = poly[COEFFS];
+  row[PRELOOP]  = poly[PRELOOP];
+  row[LENGTH]   = poly[LENGTH];
+
+  for (l = OFFSET; l < len; ++l) {
+    multiply_exponent_vectors(n, em, bht->ev[poly[l]], evl);
+    const val_t h = hm + bht->hd[poly[l]].val;
+    row[l] = is_contained_in_hash_table(n, sht, h, &k) == 1 ? k : 0;
+  }
+
+  return row;
+}
+
+static inline void insert_missing_multiplied_poly_in_hash_table(
+    hm_t *row,
+    const exp_t * const em,
+    const hm_t *poly,
+    const ht_t * const bht,
+    ht_t *sht
+    )
+{
+  len_t l;
+  exp_t *n;
+
+  const len_t len = poly[LENGTH]+OFFSET;
+  const len_t evl = bht->evl;
+
+  while (sht->eld+poly[LENGTH] >= sht->esz) {
+    enlarge_hash_table(sht);
+  }
+  for (l = OFFSET; l < len; ++l) {
+    if (row[l] == 0) {
+      n = sht->ev[sht->eld];
+      multiply_exponent_vectors(n, em, bht->ev[poly[l]], evl);
+      row[l] = insert_in_hash_table(n, sht);
+    }
+  }
+}
+
 static inline hm_t *multiplied_poly_to_matrix_row(
+    ra_t *ra,
     ht_t *sht,
     const ht_t *bht,
     const val_t hm,
@@ -1372,7 +1970,7 @@ static inline hm_t *multiplied_poly_to_matrix_row(
     const hm_t *poly
     )
 {
-  hm_t *row = (hm_t *)malloc((unsigned long)(poly[LENGTH]+OFFSET) * sizeof(hm_t));
+  hm_t *row = allocate_matrix_row(ra, poly[LENGTH]);
   row[COEFFS]   = poly[COEFFS];
   row[PRELOOP]  = poly[PRELOOP];
   row[LENGTH]   = poly[LENGTH];
@@ -199,6 +199,54 @@ void sort_terms_ff_32(
   *hmp  = hm;
 }
 
+void sort_terms_ff_64(
+    cf64_t **cfp,
+    hm_t **hmp,
+    ht_t *ht
+    )
+{
+  cf64_t *cf  = *cfp;
+  hm_t *hm    = *hmp;
+  hm_t *hmo   = hm+OFFSET;
+
+  const len_t len = hm[LENGTH];
+
+  len_t i, j, k;
+
+  hm_t tmphm    = 0;
+  cf64_t tmpcf  = 0;
+
+  /* generate array of pointers to hm entries */
+  hm_t *phm[len];
+  for (i = 0; i < len; ++i) {
+    phm[i]  = &hmo[i];
+  }
+
+  /* sort pointers to hm entries -> getting permutations */
+  sort_r(phm, (unsigned long)len, sizeof(phm[0]), initial_gens_cmp, ht);
+
+  /* sort cf and hm using permutations stored in phm */
+  for (i = 0; i < len; ++i) {
+    if (i != phm[i]-hmo) {
+      tmpcf = cf[i];
+      tmphm = hmo[i];
+      k     = i;
+      while (i != (j = phm[k]-hmo)) {
+        cf[k]   = cf[j];
+        hmo[k]  = hmo[j];
+        phm[k]  = &hmo[k];
+        k       = j;
+      }
+      cf[k]   = tmpcf;
+      hmo[k]  = tmphm;
+      phm[k]  = &hmo[k];
+    }
+  }
+
+  *cfp  = cf;
+  *hmp  = hm;
+}
+
 void sort_terms_qq(
     mpz_t **cfp,
     hm_t **hmp,
@@ -267,6 +315,7 @@ void import_input_data(
     cf8_t *cf8      =   NULL;
     cf16_t *cf16    =   NULL;
     cf32_t *cf32    =   NULL;
+    cf64_t *cf64    =   NULL;
     mpz_t *cfq      =   NULL;
     int32_t *cfs_ff =   NULL;
     mpz_t **cfs_qq  =   NULL;
@@ -371,6 +420,24 @@ void import_input_data(
                 off +=  lens[i];
             }
             break;
+        case 64:
+            cfs_ff  =   (int32_t *)vcfs;
+            for (i = start; i < stop; ++i) {
+                if (invalid_gens == NULL || invalid_gens[i] == 0) {
+                    cf64    = (cf64_t *)malloc((unsigned long)(lens[i]) * sizeof(cf64_t));
+                    bs->cf_64[ctr] = cf64;
+
+                    for (j = off; j < off+lens[i]; ++j) {
+                        /* make coefficient positive, |cfs_ff[j]| < fc */
+                        cf64[j-off] =   cfs_ff[j] < 0 ?
+                            st->fc - (cf64_t)(-(int64_t)cfs_ff[j]) : (cf64_t)cfs_ff[j];
+                    }
+                    sort_terms_ff_64(&(bs->cf_64[ctr]), &(bs->hm[ctr]), ht);
+                    ctr++;
+                }
+                off +=  lens[i];
+            }
+            break;
         case 0:
             cfs_qq  =   (mpz_t **)vcfs;
             mpz_t prod_den, mul;
@@ -524,8 +591,15 @@ static int64_t export_data(
         cf = (mpz_t *)(*mallocp)(
             (unsigned long)(nterms) * sizeof(mpz_t));
     } else {
-        cf = (int32_t *)(*mallocp)(
-            (unsigned long)(nterms) * sizeof(int32_t));
+        /* coefficients modulo primes of more than 31 bits are
+         * exported as int64_t */
+        if (md->ff_bits == 64) {
+            cf = (int64_t *)(*mallocp)(
+                (unsigned long)(nterms) * sizeof(int64_t));
+        } else {
+            cf = (int32_t *)(*mallocp)(
+                (unsigned long)(nterms) * sizeof(int32_t));
+        }
     }
 
     /* counters for lengths, exponents and coefficients */
@@ -538,7 +612,11 @@ static int64_t export_data(
             if (md->ff_bits == 0) {
                 mpz_init(((mpz_t *)cf+cc)[0]);
             } else {
-                ((int32_t *)cf+cc)[0] = (int32_t)0;
+                if (md->ff_bits == 64) {
+                    ((int64_t *)cf+cc)[0] = (int64_t)0;
+                } else {
+                    ((int32_t *)cf+cc)[0] = (int32_t)0;
+                }
             }
             for (k = 1; k < evl; ++k) {
                 exp[ce++] = (int32_t)0;
@@ -566,6 +644,11 @@ static int64_t export_data(
                     ((int32_t *)cf+cc)[j] = (int32_t)bs->cf_32[bs->hm[bi][COEFFS]][j];
                 }
                 break;
+            case 64:
+                for (j = 0; j < (len_t)len[cl]; ++j) {
+                    ((int64_t *)cf+cc)[j] = (int64_t)bs->cf_64[bs->hm[bi][COEFFS]][j];
+                }
+                break;
             case 0:
                 tmp_cf_q =  bs->cf_qq[bs->hm[bi][COEFFS]];
                 for (j = 0; j < len[cl]; ++j) {
@@ -596,44 +679,28 @@ static int64_t export_data(
     return nterms;
 }
 
-int32_t check_ff_bits(int32_t fc){
+int32_t check_ff_bits(uint64_t fc){
     if (fc == 0) {
         return 0;
     } else {
-        if (fc < (int32_t)(1) << 8) {
+        if (fc < (uint64_t)(1) << 8) {
             return 8;
         } else {
-            if (fc < (int32_t)(1) << 16) {
+            if (fc < (uint64_t)(1) << 16) {
                 return 16;
             } else {
-                if (fc < (int32_t)(1) << 23) {
+                if (fc < (uint64_t)(1) << 32) {
                     return 32;
                 } else {
-                    return 32;
+                    return 64;
                 }
             }
         }
     }
 }
 
-void set_ff_bits(md_t *st, int32_t fc){
-    if (fc == 0) {
-        st->ff_bits = 0;
-    } else {
-        if (fc < (int32_t)(1) << 8) {
-            st->ff_bits = 8;
-        } else {
-            if (fc < (int32_t)(1) << 16) {
-                st->ff_bits = 16;
-            } else {
-                if (fc < (int32_t)(1) << 23) {
-                    st->ff_bits = 32;
-                } else {
-                    st->ff_bits = 32;
-                }
-            }
-        }
-    }
+void set_ff_bits(md_t *st, uint64_t fc){
+    st->ff_bits = check_ff_bits(fc);
 }
 
 /* return 1 if validation was possible, zero otherwise */
@@ -1034,6 +1101,14 @@ void set_function_pointers(
       }
       break;
 
+    case 64:
+      /* only exact sparse linear algebra for primes of more than 32 bits */
+      linear_algebra          = exact_sparse_linear_algebra_ff_64;
+      exact_linear_algebra    = exact_sparse_linear_algebra_ff_64;
+      interreduce_matrix_rows = interreduce_matrix_rows_ff_64;
+      normalize_initial_basis = normalize_initial_basis_ff_64;
+      break;
+
     default:
       switch (st->laopt) {
         case 1:
@@ -1123,10 +1198,18 @@ int32_t check_and_set_meta_data_trace(
 }
 
 static inline void reset_function_pointers(
-        const uint32_t prime,
+        const uint64_t prime,
         const uint32_t laopt
         )
 {
+    /* only exact sparse linear algebra for primes of more than 32 bits */
+    if (prime >= (uint64_t)(1) << 32) {
+        linear_algebra          = exact_sparse_linear_algebra_ff_64;
+        exact_linear_algebra    = exact_sparse_linear_algebra_ff_64;
+        interreduce_matrix_rows = interreduce_matrix_rows_ff_64;
+        normalize_initial_basis = normalize_initial_basis_ff_64;
+        return;
+    }
     if (prime < (int32_t)(1) << 8) {
         exact_linear_algebra    = exact_sparse_linear_algebra_ff_8;
         interreduce_matrix_rows = interreduce_matrix_rows_ff_8;
@@ -27,9 +27,9 @@ void set_function_pointers(
         const md_t *st
         );
 
-void set_ff_bits(md_t *st, int32_t fc);
+void set_ff_bits(md_t *st, uint64_t fc);
 
-int32_t check_ff_bits(int32_t fc);
+int32_t check_ff_bits(uint64_t fc);
 
 void sort_terms_ff_8(
     cf8_t **cfp,
@@ -49,6 +49,12 @@ void sort_terms_ff_32(
     ht_t *ht
     );
 
+void sort_terms_ff_64(
+    cf64_t **cfp,
+    hm_t **hmp,
+    ht_t *ht
+    );
+
 void sort_terms_qq(
     mpz_t **cfp,
     hm_t **hmp,
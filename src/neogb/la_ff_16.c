@@ -813,7 +813,7 @@ static void probabilistic_sparse_reduced_echelon_form_ff_16(
                 do {
                     free(cfs);
                     cfs = NULL;
-                    free(npiv);
+                    free_matrix_row(mat->ra, npiv);
                     npiv  = NULL;
                     npiv  = reduce_dense_row_by_known_pivots_sparse_ff_16(
                             drl, mat, bs, pivs, sc, cfp, 0, 0, 0, st->fc);
@@ -836,7 +836,7 @@ static void probabilistic_sparse_reduced_echelon_form_ff_16(
                 bctr++;
             }
             for (j = i*rpb; j < nbl; ++j) {
-                free(upivs[j]);
+                free_matrix_row(mat->ra, upivs[j]);
                 upivs[j]  = NULL;
             }
         }
@@ -851,7 +851,7 @@ static void probabilistic_sparse_reduced_echelon_form_ff_16(
 
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncl; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
 
@@ -885,7 +885,7 @@ static void probabilistic_sparse_reduced_echelon_form_ff_16(
                 dr[ds[j+2]] = (int64_t)cfs[j+2];
                 dr[ds[j+3]] = (int64_t)cfs[j+3];
             }
-            free(pivs[k]);
+            free_matrix_row(mat->ra, pivs[k]);
             free(cfs);
             pivs[k] = NULL;
             pivs[k] = mat->tr[npivs++] =
@@ -965,7 +965,7 @@ static void exact_trace_sparse_reduced_echelon_form_ff_16(
         cfs = NULL;
         do {
             sc  = npiv[OFFSET];
-            free(npiv);
+            free_matrix_row(mat->ra, npiv);
             npiv  = NULL;
             free(cfs);
             npiv  = mat->tr[i]  = trace_reduce_dense_row_by_known_pivots_sparse_ff_16(
@@ -991,7 +991,7 @@ static void exact_trace_sparse_reduced_echelon_form_ff_16(
 
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncl; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
 
@@ -1024,7 +1024,7 @@ static void exact_trace_sparse_reduced_echelon_form_ff_16(
                 dr[ds[j+2]]  = (int64_t)cfs[j+2];
                 dr[ds[j+3]]  = (int64_t)cfs[j+3];
             }
-            free(pivs[k]);
+            free_matrix_row(mat->ra, pivs[k]);
             free(cfs);
             pivs[k] = NULL;
             pivs[k] = mat->tr[npivs++] =
@@ -1049,7 +1049,7 @@ static void exact_sparse_reduced_echelon_form_ff_16(
         md_t *st
         )
 {
-    len_t i = 0, j, k;
+    len_t i = 0, j, k, l, w;
     hi_t sc    = 0;    /* starting column */
 
     const len_t ncols = mat->nc;
@@ -1057,7 +1057,7 @@ static void exact_sparse_reduced_echelon_form_ff_16(
     const len_t ncr   = mat->ncr;
     const len_t ncl   = mat->ncl;
 
-    const int32_t nthrds = st->in_final_reduction_step == 1 ? 1 : st->nthrds;
+    const int32_t nthrds = st->nthrds;
 
     len_t bad_prime = 0;
 
@@ -1081,75 +1081,97 @@ static void exact_sparse_reduced_echelon_form_ff_16(
     /* unkown pivot rows we have to reduce with the known pivots first */
     hm_t **upivs  = mat->tr;
 
+    /* in the final reduction step the rows are reduced in waves, see
+     * compute_reduction_waves(), otherwise all rows form one wave */
+    len_t nw, *wo, *wr;
+    if (st->in_final_reduction_step == 1) {
+        wr  = compute_reduction_waves(&nw, &wo, pivs, ncols, upivs, nrl);
+    } else {
+        nw  = 1;
+        wo  = (len_t *)malloc(2 * sizeof(len_t));
+        wr  = (len_t *)malloc((unsigned long)nrl * sizeof(len_t));
+        wo[0] = 0;
+        wo[1] = nrl;
+        for (i = 0; i < nrl; ++i) {
+            wr[i] = i;
+        }
+    }
+
     int64_t *dr  = (int64_t *)malloc(
             (unsigned long)(nthrds * ncols) * sizeof(int64_t));
     /* mo need to have any sharing dependencies on parallel computation,
      * no data to be synchronized at this step of the linear algebra */
-#pragma omp parallel for num_threads(nthrds) \
-    private(i, j, k, sc) \
-    schedule(dynamic)
-    for (i = 0; i < nrl; ++i) {
-        if (bad_prime == 0) {
-            int64_t *drl    = dr + (omp_get_thread_num() * ncols);
-            hm_t *npiv      = upivs[i];
-            cf16_t *cfs     = tbr->cf_16[npiv[COEFFS]];
-            const len_t bi  = npiv[BINDEX];
-            const len_t mh  = npiv[MULT];
-            const len_t os  = npiv[PRELOOP];
-            const len_t len = npiv[LENGTH];
-            const hm_t * const ds = npiv + OFFSET;
-            k = 0;
-            memset(drl, 0, (unsigned long)ncols * sizeof(int64_t));
-            for (j = 0; j < os; ++j) {
-                drl[ds[j]]  = (int64_t)cfs[j];
-            }
-            for (; j < len; j += UNROLL) {
-                drl[ds[j]]    = (int64_t)cfs[j];
-                drl[ds[j+1]]  = (int64_t)cfs[j+1];
-                drl[ds[j+2]]  = (int64_t)cfs[j+2];
-                drl[ds[j+3]]  = (int64_t)cfs[j+3];
-            }
-            cfs = NULL;
-            do {
-                /* If we do normal form computations the first monomial in the polynomial might not
-                be a known pivot, thus setting it to npiv[OFFSET] can lead to wrong results. */
-                sc  = st->nf == 0 ? npiv[OFFSET] : 0;
-                free(npiv);
-                npiv  = NULL;
-                free(cfs);
-                cfs = NULL;
-                npiv  = mat->tr[i] = reduce_dense_row_by_known_pivots_sparse_ff_16(
-                        drl, mat, bs, pivs, sc, i, mh, bi, st->trace_level == LEARN_TRACER, st->fc);
-                if (st->nf > 0) {
-                    if (!npiv) {
-                        mat->tr[i]  = NULL;
-                        break;
-                    }
-                    mat->tr[i]  = npiv;
-                    cfs = mat->cf_16[npiv[COEFFS]];
-                    break;
-                } else {
-                    if (!npiv) {
-                        break;
+#pragma omp parallel num_threads(nthrds) private(i, j, k, l, w, sc)
+    {
+        for (w = 0; w < nw; ++w) {
+#pragma omp for schedule(dynamic)
+            for (l = wo[w]; l < wo[w+1]; ++l) {
+                i = wr[l];
+                if (bad_prime == 0) {
+                    int64_t *drl    = dr + (omp_get_thread_num() * ncols);
+                    hm_t *npiv      = upivs[i];
+                    cf16_t *cfs     = tbr->cf_16[npiv[COEFFS]];
+                    const len_t bi  = npiv[BINDEX];
+                    const len_t mh  = npiv[MULT];
+                    const len_t os  = npiv[PRELOOP];
+                    const len_t len = npiv[LENGTH];
+                    const hm_t * const ds = npiv + OFFSET;
+                    k = 0;
+                    memset(drl, 0, (unsigned long)ncols * sizeof(int64_t));
+                    for (j = 0; j < os; ++j) {
+                        drl[ds[j]]  = (int64_t)cfs[j];
                     }
-                    /* normalize coefficient array
-                     * NOTE: this has to be done here, otherwise the reduction may
-                     * lead to wrong results in a parallel computation since other
-                     * threads might directly use the new pivot once it is synced. */
-                    if (mat->cf_16[npiv[COEFFS]][0] != 1) {
-                        normalize_sparse_matrix_row_ff_16(
-                                mat->cf_16[npiv[COEFFS]], npiv[PRELOOP], npiv[LENGTH], st->fc);
+                    for (; j < len; j += UNROLL) {
+                        drl[ds[j]]    = (int64_t)cfs[j];
+                        drl[ds[j+1]]  = (int64_t)cfs[j+1];
+                        drl[ds[j+2]]  = (int64_t)cfs[j+2];
+                        drl[ds[j+3]]  = (int64_t)cfs[j+3];
                     }
-                    k   = __sync_bool_compare_and_swap(&pivs[npiv[OFFSET]], NULL, npiv);
-                    cfs = mat->cf_16[npiv[COEFFS]];
+                    cfs = NULL;
+                    do {
+                        /* If we do normal form computations the first monomial in the polynomial might not
+                        be a known pivot, thus setting it to npiv[OFFSET] can lead to wrong results. */
+                        sc  = st->nf == 0 ? npiv[OFFSET] : 0;
+                        free_matrix_row(mat->ra, npiv);
+                        npiv  = NULL;
+                        free(cfs);
+                        cfs = NULL;
+                        npiv  = mat->tr[i] = reduce_dense_row_by_known_pivots_sparse_ff_16(
+                                drl, mat, bs, pivs, sc, i, mh, bi, st->trace_level == LEARN_TRACER, st->fc);
+                        if (st->nf > 0) {
+                            if (!npiv) {
+                                mat->tr[i]  = NULL;
+                                break;
+                            }
+                            mat->tr[i]  = npiv;
+                            cfs = mat->cf_16[npiv[COEFFS]];
+                            break;
+                        } else {
+                            if (!npiv) {
+                                break;
+                            }
+                            /* normalize coefficient array
+                             * NOTE: this has to be done here, otherwise the reduction may
+                             * lead to wrong results in a parallel computation since other
+                             * threads might directly use the new pivot once it is synced. */
+                            if (mat->cf_16[npiv[COEFFS]][0] != 1) {
+                                normalize_sparse_matrix_row_ff_16(
+                                        mat->cf_16[npiv[COEFFS]], npiv[PRELOOP], npiv[LENGTH], st->fc);
+                            }
+                            k   = __sync_bool_compare_and_swap(&pivs[npiv[OFFSET]], NULL, npiv);
+                            cfs = mat->cf_16[npiv[COEFFS]];
+                        }
+                    } while (!k);
                 }
-            } while (!k);
+            }
         }
     }
+    free(wr);
+    free(wo);
 
     if (bad_prime == 1) {
         for (i = 0; i < ncl+ncr; ++i) {
-            free(pivs[i]);
+            free_matrix_row(mat->ra, pivs[i]);
             pivs[i] = NULL;
         }
         mat->np = 0;
@@ -1166,7 +1188,7 @@ static void exact_sparse_reduced_echelon_form_ff_16(
 
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncl; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
 
@@ -1200,7 +1222,7 @@ static void exact_sparse_reduced_echelon_form_ff_16(
                     dr[ds[j+2]]  = (int64_t)cfs[j+2];
                     dr[ds[j+3]]  = (int64_t)cfs[j+3];
                 }
-                free(pivs[k]);
+                free_matrix_row(mat->ra, pivs[k]);
                 free(cfs);
                 pivs[k] = NULL;
                 pivs[k] = mat->tr[npivs++] =
@@ -1281,7 +1303,7 @@ static int exact_application_sparse_reduced_echelon_form_ff_16(
             cfs = NULL;
             do {
                 sc  = npiv[OFFSET];
-                free(npiv);
+                free_matrix_row(mat->ra, npiv);
                 free(cfs);
                 npiv  = mat->tr[i]  = reduce_dense_row_by_known_pivots_sparse_ff_16(
                         drl, mat, bs, pivs, sc, i, mh, bi, 0, st->fc);
@@ -1309,7 +1331,7 @@ static int exact_application_sparse_reduced_echelon_form_ff_16(
     }
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncl; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
 
@@ -1342,7 +1364,7 @@ static int exact_application_sparse_reduced_echelon_form_ff_16(
                 dr[ds[j+2]]  = (int64_t)cfs[j+2];
                 dr[ds[j+3]]  = (int64_t)cfs[j+3];
             }
-            free(pivs[k]);
+            free_matrix_row(mat->ra, pivs[k]);
             free(cfs);
             pivs[k] = NULL;
             pivs[k] = mat->tr[npivs++] =
@@ -1412,7 +1434,7 @@ static cf16_t **sparse_AB_CD_linear_algebra_ff_16(
             drl[ds[j+3]]  = (int64_t)cfs[j+3];
         }
         sc  = 0; /* row columns are not sorted, so we have to start at 0 */
-        free(npiv);
+        free_matrix_row(mat->ra, npiv);
         drs[i]  = reduce_dense_row_by_old_pivots_ff_16(
                 drl, mat, bs, pivs, sc, st->fc);
     }
@@ -1421,7 +1443,7 @@ static cf16_t **sparse_AB_CD_linear_algebra_ff_16(
 
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncl; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
     free(pivs);
@@ -1852,7 +1874,7 @@ static cf16_t **probabilistic_sparse_dense_echelon_form_ff_16(
                 bctr++;
             }
             for (j = i*rpb; j < nbl; ++j) {
-                free(upivs[j]);
+                free_matrix_row(mat->ra, upivs[j]);
                 upivs[j]  = NULL;
             }
         }
@@ -1883,7 +1905,7 @@ static cf16_t **probabilistic_sparse_dense_echelon_form_ff_16(
 
 
     for (i = 0; i < nru; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
     }
     free(pivs);
     pivs  = NULL;
@@ -2258,11 +2280,13 @@ static void interreduce_matrix_rows_ff_16(
         const int free_basis
         )
 {
-    len_t i, j, k, l;
+    len_t i, l, w;
 
     const len_t nrows = mat->nr;
     const len_t ncols = mat->nc;
 
+    const int32_t nthrds = st->nthrds;
+
     /* adjust displaying timings for statistic printout */
     if (st->info_level > 1) {
         printf("                          ");
@@ -2290,37 +2314,53 @@ static void interreduce_matrix_rows_ff_16(
         pivs[mat->rr[i][OFFSET]]  = mat->rr[i];
     }
 
-    int64_t *dr = (int64_t *)malloc((unsigned long)ncols * sizeof(int64_t));
-    /* interreduce new pivots */
-    cf16_t *cfs;
-    /* starting column, coefficient array position in tmpcf */
-    hm_t sc;
-    k = nrows - 1;
+    /* rows with smaller lead terms come last in mat->tr */
+    len_t *tp = (len_t *)malloc((unsigned long)ncols * sizeof(len_t));
+    l = nrows;
     for (i = 0; i < ncols; ++i) {
-        l = ncols-1-i;
-        if (pivs[l] != NULL) {
-            memset(dr, 0, (unsigned long)ncols * sizeof(int64_t));
-            cfs = bs->cf_16[pivs[l][COEFFS]];
-            const len_t bi  = pivs[l][BINDEX];
-            const len_t mh  = pivs[l][MULT];
-            const len_t os  = pivs[l][PRELOOP];
-            const len_t len = pivs[l][LENGTH];
-            const hm_t * const ds = pivs[l] + OFFSET;
-            sc  = ds[0];
-            for (j = 0; j < os; ++j) {
-                dr[ds[j]] = (int64_t)cfs[j];
-            }
-            for (; j < len; j += UNROLL) {
-                dr[ds[j]]   = (int64_t)cfs[j];
-                dr[ds[j+1]] = (int64_t)cfs[j+1];
-                dr[ds[j+2]] = (int64_t)cfs[j+2];
-                dr[ds[j+3]] = (int64_t)cfs[j+3];
+        if (pivs[ncols-1-i] != NULL) {
+            tp[ncols-1-i] = --l;
+        }
+    }
+    len_t nw, *wo;
+    len_t *wr = compute_reduction_waves(&nw, &wo, pivs, ncols, mat->rr, nrows);
+
+    int64_t *dr = (int64_t *)malloc(
+            (unsigned long)(nthrds * ncols) * sizeof(int64_t));
+    /* interreduce new pivots, rows of one wave do not depend on each other */
+#pragma omp parallel num_threads(nthrds) private(i, l, w)
+    {
+        int64_t *drl  = dr + (omp_get_thread_num() * ncols);
+        for (w = 0; w < nw; ++w) {
+#pragma omp for schedule(dynamic)
+            for (i = wo[w]; i < wo[w+1]; ++i) {
+                len_t j;
+                hm_t *row = mat->rr[wr[i]];
+                l = row[OFFSET];
+                memset(drl, 0, (unsigned long)ncols * sizeof(int64_t));
+                const cf16_t * const cfs = bs->cf_16[row[COEFFS]];
+                const len_t bi  = row[BINDEX];
+                const len_t mh  = row[MULT];
+                const len_t os  = row[PRELOOP];
+                const len_t len = row[LENGTH];
+                const hm_t * const ds = row + OFFSET;
+                /* starting column */
+                const hm_t sc = ds[0];
+                for (j = 0; j < os; ++j) {
+                    drl[ds[j]] = (int64_t)cfs[j];
+                }
+                for (; j < len; j += UNROLL) {
+                    drl[ds[j]]   = (int64_t)cfs[j];
+                    drl[ds[j+1]] = (int64_t)cfs[j+1];
+                    drl[ds[j+2]] = (int64_t)cfs[j+2];
+                    drl[ds[j+3]] = (int64_t)cfs[j+3];
+                }
+                free_matrix_row(mat->ra, row);
+                pivs[l] = NULL;
+                pivs[l] = mat->tr[tp[l]] =
+                    reduce_dense_row_by_known_pivots_sparse_ff_16(
+                            drl, mat, bs, pivs, sc, l, mh, bi, 0, st->fc);
             }
-            free(pivs[l]);
-            pivs[l] = NULL;
-            pivs[l] = mat->tr[k--] =
-                reduce_dense_row_by_known_pivots_sparse_ff_16(
-                        dr, mat, bs, pivs, sc, l, mh, bi, 0, st->fc);
         }
     }
     for (i = 0; i < ncols; ++i) {
@@ -2336,4 +2376,7 @@ static void interreduce_matrix_rows_ff_16(
     st->np = mat->np = nrows;
     free(pivs);
     free(dr);
+    free(tp);
+    free(wr);
+    free(wo);
 }
@@ -2410,7 +2410,7 @@ static void probabilistic_sparse_reduced_echelon_form_ff_32(
                 do {
                     free(cfs);
                     cfs = NULL;
-                    free(npiv);
+                    free_matrix_row(mat->ra, npiv);
                     npiv  = NULL;
                     npiv  = reduce_dense_row_by_known_pivots_sparse_ff_32(
                             drl, mat, bs, pivs, sc, cfp, 0, 0, 0, st);
@@ -2433,7 +2433,7 @@ static void probabilistic_sparse_reduced_echelon_form_ff_32(
                 bctr++;
             }
             for (j = i*rpb; j < nbl; ++j) {
-                free(upivs[j]);
+                free_matrix_row(mat->ra, upivs[j]);
                 upivs[j]  = NULL;
             }
         }
@@ -2443,7 +2443,7 @@ static void probabilistic_sparse_reduced_echelon_form_ff_32(
 
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncl; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
 
@@ -2477,7 +2477,7 @@ static void probabilistic_sparse_reduced_echelon_form_ff_32(
                 dr[ds[j+2]] = (int64_t)cfs[j+2];
                 dr[ds[j+3]] = (int64_t)cfs[j+3];
             }
-            free(pivs[k]);
+            free_matrix_row(mat->ra, pivs[k]);
             free(cfs);
             pivs[k] = NULL;
             pivs[k] = mat->tr[npivs++] =
@@ -2592,7 +2592,7 @@ static void exact_sparse_reduced_echelon_form_ff_32(
         md_t *st
         )
 {
-    len_t i = 0, j, k;
+    len_t i = 0, j, k, l, w;
     hi_t sc = 0;    /* starting column */
 
     const len_t ncols = mat->nc;
@@ -2600,7 +2600,7 @@ static void exact_sparse_reduced_echelon_form_ff_32(
     const len_t ncr   = mat->ncr;
     const len_t ncl   = mat->ncl;
 
-    const int32_t nthrds = st->in_final_reduction_step == 1 ? 1 : st->nthrds;
+    const int32_t nthrds = st->nthrds;
 
     len_t bad_prime = 0;
 
@@ -2623,76 +2623,98 @@ static void exact_sparse_reduced_echelon_form_ff_32(
     /* unkown pivot rows we have to reduce with the known pivots first */
     hm_t **upivs  = mat->tr;
 
+    /* in the final reduction step the rows are reduced in waves, see
+     * compute_reduction_waves(), otherwise all rows form one wave */
+    len_t nw, *wo, *wr;
+    if (st->in_final_reduction_step == 1) {
+        wr  = compute_reduction_waves(&nw, &wo, pivs, ncols, upivs, nrl);
+    } else {
+        nw  = 1;
+        wo  = (len_t *)malloc(2 * sizeof(len_t));
+        wr  = (len_t *)malloc((unsigned long)nrl * sizeof(len_t));
+        wo[0] = 0;
+        wo[1] = nrl;
+        for (i = 0; i < nrl; ++i) {
+            wr[i] = i;
+        }
+    }
+
     int64_t *dr  = (int64_t *)malloc(
             (unsigned long)(nthrds * ncols) * sizeof(int64_t));
     /* mo need to have any sharing dependencies on parallel computation,
      * no data to be synchronized at this step of the linear algebra */
-#pragma omp parallel for num_threads(nthrds) \
-    private(i, j, k, sc) \
-    schedule(dynamic)
-    for (i = 0; i < nrl; ++i) {
-        if (bad_prime == 0) {
-            int64_t *drl  = dr + (omp_get_thread_num() * ncols);
-            hm_t *npiv      = upivs[i];
-            cf32_t *cfs     = tbr->cf_32[npiv[COEFFS]];
-            const len_t os  = npiv[PRELOOP];
-            const len_t len = npiv[LENGTH];
-            const len_t bi  = npiv[BINDEX];
-            const len_t mh  = npiv[MULT];
-            const hm_t * const ds = npiv + OFFSET;
-            k = 0;
-            memset(drl, 0, (unsigned long)ncols * sizeof(int64_t));
-            for (j = 0; j < os; ++j) {
-                drl[ds[j]]  = (int64_t)cfs[j];
-            }
-            for (; j < len; j += UNROLL) {
-                drl[ds[j]]    = (int64_t)cfs[j];
-                drl[ds[j+1]]  = (int64_t)cfs[j+1];
-                drl[ds[j+2]]  = (int64_t)cfs[j+2];
-                drl[ds[j+3]]  = (int64_t)cfs[j+3];
-            }
-            cfs = NULL;
-            do {
-                /* If we do normal form computations the first monomial in the polynomial might not
-                be a known pivot, thus setting it to npiv[OFFSET] can lead to wrong results. */
-                sc  = st->nf == 0 ? npiv[OFFSET] : 0;
-                free(npiv);
-                free(cfs);
-                npiv  = mat->tr[i] = reduce_dense_row_by_known_pivots_sparse_ff_32(
-                        drl, mat, bs, pivs, sc, i, mh, bi, st->trace_level == LEARN_TRACER, st);
-                if (st->nf > 0) {
-                    if (!npiv) {
-                        mat->tr[i]  = NULL;
-                        break;
-                    }
-                    mat->tr[i]  = npiv;
-                    cfs = mat->cf_32[npiv[COEFFS]];
-                    break;
-                } else {
-                    if (!npiv) {
-                        if (st->trace_level == APPLY_TRACER) {
-                            bad_prime = 1;
-                        }
-                        break;
+#pragma omp parallel num_threads(nthrds) private(i, j, k, l, w, sc)
+    {
+        for (w = 0; w < nw; ++w) {
+#pragma omp for schedule(dynamic)
+            for (l = wo[w]; l < wo[w+1]; ++l) {
+                i = wr[l];
+                if (bad_prime == 0) {
+                    int64_t *drl  = dr + (omp_get_thread_num() * ncols);
+                    hm_t *npiv      = upivs[i];
+                    cf32_t *cfs     = tbr->cf_32[npiv[COEFFS]];
+                    const len_t os  = npiv[PRELOOP];
+                    const len_t len = npiv[LENGTH];
+                    const len_t bi  = npiv[BINDEX];
+                    const len_t mh  = npiv[MULT];
+                    const hm_t * const ds = npiv + OFFSET;
+                    k = 0;
+                    memset(drl, 0, (unsigned long)ncols * sizeof(int64_t));
+                    for (j = 0; j < os; ++j) {
+                        drl[ds[j]]  = (int64_t)cfs[j];
                     }
-                    /* normalize coefficient array
-                     * NOTE: this has to be done here, otherwise the reduction may
-                     * lead to wrong results in a parallel computation since other
-                     * threads might directly use the new pivot once it is synced. */
-                    if (mat->cf_32[npiv[COEFFS]][0] != 1) {
-                        normalize_sparse_matrix_row_ff_32(
-                                mat->cf_32[npiv[COEFFS]], npiv[PRELOOP], npiv[LENGTH], st->fc);
+                    for (; j < len; j += UNROLL) {
+                        drl[ds[j]]    = (int64_t)cfs[j];
+                        drl[ds[j+1]]  = (int64_t)cfs[j+1];
+                        drl[ds[j+2]]  = (int64_t)cfs[j+2];
+                        drl[ds[j+3]]  = (int64_t)cfs[j+3];
                     }
-                    k   = __sync_bool_compare_and_swap(&pivs[npiv[OFFSET]], NULL, npiv);
-                    cfs = mat->cf_32[npiv[COEFFS]];
+                    cfs = NULL;
+                    do {
+                        /* If we do normal form computations the first monomial in the polynomial might not
+                        be a known pivot, thus setting it to npiv[OFFSET] can lead to wrong results. */
+                        sc  = st->nf == 0 ? npiv[OFFSET] : 0;
+                        free_matrix_row(mat->ra, npiv);
+                        free(cfs);
+                        npiv  = mat->tr[i] = reduce_dense_row_by_known_pivots_sparse_ff_32(
+                                drl, mat, bs, pivs, sc, i, mh, bi, st->trace_level == LEARN_TRACER, st);
+                        if (st->nf > 0) {
+                            if (!npiv) {
+                                mat->tr[i]  = NULL;
+                                break;
+                            }
+                            mat->tr[i]  = npiv;
+                            cfs = mat->cf_32[npiv[COEFFS]];
+                            break;
+                        } else {
+                            if (!npiv) {
+                                if (st->trace_level == APPLY_TRACER) {
+                                    bad_prime = 1;
+                                }
+                                break;
+                            }
+                            /* normalize coefficient array
+                             * NOTE: this has to be done here, otherwise the reduction may
+                             * lead to wrong results in a parallel computation since other
+                             * threads might directly use the new pivot once it is synced. */
+                            if (mat->cf_32[npiv[COEFFS]][0] != 1) {
+                                normalize_sparse_matrix_row_ff_32(
+                                        mat->cf_32[npiv[COEFFS]], npiv[PRELOOP], npiv[LENGTH], st->fc);
+                            }
+                            k   = __sync_bool_compare_and_swap(&pivs[npiv[OFFSET]], NULL, npiv);
+                            cfs = mat->cf_32[npiv[COEFFS]];
+                        }
+                    } while (!k);
                 }
-            } while (!k);
+            }
         }
     }
+    free(wr);
+    free(wo);
 
     if (bad_prime == 1) {
         for (i = 0; i < ncl+ncr; ++i) {
-            free(pivs[i]);
+            free_matrix_row(mat->ra, pivs[i]);
             pivs[i] = NULL;
         }
         mat->np = 0;
@@ -2709,7 +2731,7 @@ static void exact_sparse_reduced_echelon_form_ff_32(
 
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncl; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
 
@@ -2743,7 +2765,7 @@ static void exact_sparse_reduced_echelon_form_ff_32(
                     dr[ds[j+2]]  = (int64_t)cfs[j+2];
                     dr[ds[j+3]]  = (int64_t)cfs[j+3];
                 }
-                free(pivs[k]);
+                free_matrix_row(mat->ra, pivs[k]);
                 free(cfs);
                 pivs[k] = NULL;
                 pivs[k] = mat->tr[npivs++] =
@@ -2825,7 +2847,7 @@ static void exact_sparse_reduced_echelon_form_sat_ff_32(
         while (drl[sc] == 0) {
             sc++;
         }
-        free(npiv);
+        free_matrix_row(mat->ra, npiv);
         upivs[i]  = NULL;
         free(cfs);
         sat->cf_32[cf_idx]  = NULL;
@@ -2859,7 +2881,7 @@ static void exact_sparse_reduced_echelon_form_sat_ff_32(
     mat->np = mat->nr = mat->sz = nrl;
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncl; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
 
@@ -2972,7 +2994,7 @@ static void exact_sparse_reduced_echelon_form_sat_ff_32(
 
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncols; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
     for (i = 0; i < ncols; ++i) {
@@ -3055,7 +3077,7 @@ static void exact_trace_sparse_reduced_echelon_form_ff_32(
         cfs = NULL;
         do {
             sc  = npiv[OFFSET];
-            free(npiv);
+            free_matrix_row(mat->ra, npiv);
             free(cfs);
             npiv  = mat->tr[i]  = trace_reduce_dense_row_by_known_pivots_sparse_ff_32(
                     rba, drl, mat, bs, pivs, sc, i, mh, bi, st);
@@ -3081,7 +3103,7 @@ static void exact_trace_sparse_reduced_echelon_form_ff_32(
 
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncl; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
 
@@ -3114,7 +3136,7 @@ static void exact_trace_sparse_reduced_echelon_form_ff_32(
                 dr[ds[j+2]]  = (int64_t)cfs[j+2];
                 dr[ds[j+3]]  = (int64_t)cfs[j+3];
             }
-            free(pivs[k]);
+            free_matrix_row(mat->ra, pivs[k]);
             free(cfs);
             pivs[k] = NULL;
             pivs[k] = mat->tr[npivs++] =
@@ -3186,7 +3208,7 @@ static int exact_application_sparse_reduced_echelon_form_ff_32(
             cfs = NULL;
             do {
                 sc  = npiv[OFFSET];
-                free(npiv);
+                free_matrix_row(mat->ra, npiv);
                 free(cfs);
                 npiv  = mat->tr[i]  = reduce_dense_row_by_known_pivots_sparse_ff_32(
                         drl, mat, bs, pivs, sc, i, mh, bi, 0, st);
@@ -3216,7 +3238,7 @@ static int exact_application_sparse_reduced_echelon_form_ff_32(
     }
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncl; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
 
@@ -3249,7 +3271,7 @@ static int exact_application_sparse_reduced_echelon_form_ff_32(
                 dr[ds[j+2]]  = (int64_t)cfs[j+2];
                 dr[ds[j+3]]  = (int64_t)cfs[j+3];
             }
-            free(pivs[k]);
+            free_matrix_row(mat->ra, pivs[k]);
             free(cfs);
             pivs[k] = NULL;
             pivs[k] = mat->tr[npivs++] =
@@ -3319,7 +3341,7 @@ static cf32_t **sparse_AB_CD_linear_algebra_ff_32(
             drl[ds[j+3]]  = (int64_t)cfs[j+3];
         }
         sc  = ds[0];
-        free(npiv);
+        free_matrix_row(mat->ra, npiv);
         drs[i]  = reduce_dense_row_by_old_pivots_ff_32(
                 drl, mat, bs, pivs, sc, st->fc);
     }
@@ -3328,7 +3350,7 @@ static cf32_t **sparse_AB_CD_linear_algebra_ff_32(
 
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncl; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
     free(pivs);
@@ -3776,7 +3798,7 @@ static cf32_t **probabilistic_sparse_dense_echelon_form_ff_32(
                 bctr++;
             }
             for (j = i*rpb; j < nbl; ++j) {
-                free(upivs[j]);
+                free_matrix_row(mat->ra, upivs[j]);
                 upivs[j]  = NULL;
             }
         }
@@ -3807,7 +3829,7 @@ static cf32_t **probabilistic_sparse_dense_echelon_form_ff_32(
 
 
     for (i = 0; i < nru; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
     }
     free(pivs);
     pivs  = NULL;
@@ -3988,6 +4010,409 @@ static void exact_sparse_linear_algebra_ff_32(
     }
 }
 
+/* Linear algebra for a bundle of primes applying the same tracer.
+ *
+ * If the matrices of nb primes share their symbolic data, i.e. the rows of
+ * all of them are given by the same column indices, they are reduced in a
+ * single sweep over the pivots: a dense row stores the nb coefficients of a
+ * column contiguously (dr[nb*c+l] for column c and prime l) and so do the
+ * coefficient arrays of the pivots, thus a reduction step handles the nb
+ * primes with one load of the dense row entries.
+ *
+ * This only works as long as the new pivots of all primes have the same
+ * leading columns. Otherwise 1 is returned, the matrices are untouched and
+ * have to be reduced one by one. */
+
+/* returns 1 if the matrix of md can be reduced within a bundle */
+static inline int bundle_linear_algebra_ff_32_applies(
+        const md_t * const md
+        )
+{
+    return md->trace_level == APPLY_TRACER
+        && md->ff_bits == 32
+        && md->fc >= (uint32_t)(1) << 18
+        && md->fc < (uint32_t)(1) << 31
+        && md->laopt < 40
+        && md->nf == 0
+        && md->in_final_reduction_step == 0;
+}
+
+static hm_t *reduce_dense_row_by_known_pivots_sparse_31_bit_bundle(
+        int64_t *dr,
+        const mat_t * const mat,
+        hm_t *const *pivs,
+        cf32_t *const *kcf, /* coefficients of known pivots by column */
+        cf32_t **bcf,       /* coefficients of new pivots by COEFFS */
+        const hi_t dpiv,    /* pivot of dense row at the beginning */
+        const hm_t tmp_pos, /* position of new coeffs array in bcf */
+        const len_t mh,     /* multiplier hash for tracing */
+        const len_t bi,     /* basis index of generating element */
+        const int64_t *mod, /* the primes */
+        const len_t nb,     /* number of primes */
+        int *div,           /* set if the primes lead to different pivots */
+        double *nops        /* number of reductions done */
+        )
+{
+    hi_t i, j, k;
+    len_t l;
+    const cf32_t *cfs;
+    hm_t *dts;
+    int64_t np      = -1;
+    const len_t ncols = mat->nc;
+    const len_t ncl   = mat->ncl;
+
+    int64_t mod2[PRIME_BUNDLE] __attribute__((aligned(32)));
+    int64_t mul[PRIME_BUNDLE] __attribute__((aligned(32)));
+    for (l = 0; l < nb; ++l) {
+        mod2[l] = mod[l] * mod[l];
+    }
+#if defined HAVE_AVX2
+    const __m256i zerov = _mm256_setzero_si256();
+    const __m256i mod2v = _mm256_load_si256((__m256i *)mod2);
+#endif
+
+    k = 0;
+    for (i = dpiv; i < ncols; ++i) {
+        int64_t * const dc  = dr + (size_t)i * nb;
+        len_t nz = 0;
+        for (l = 0; l < nb; ++l) {
+            if (dc[l] != 0) {
+                dc[l] = dc[l] % mod[l];
+                nz    +=  dc[l] != 0;
+            }
+        }
+        if (nz == 0) {
+            continue;
+        }
+        if (pivs[i] == NULL) {
+            if (np == -1) {
+                /* a new pivot has to have the same leading column
+                 * for all primes */
+                if (nz != nb) {
+                    *div = 1;
+                    return NULL;
+                }
+                np  = i;
+            }
+            k++;
+            continue;
+        }
+
+        /* found reducer row, get multipliers */
+        for (l = 0; l < nb; ++l) {
+            mul[l]  = dc[l];
+        }
+        dts = pivs[i];
+        cfs = i < ncl ? kcf[i] : bcf[dts[COEFFS]];
+        const len_t len       = dts[LENGTH];
+        const hm_t * const ds = dts + OFFSET;
+#if defined HAVE_AVX2
+        if (nb == 4) {
+            const __m256i mulv  = _mm256_load_si256((__m256i *)mul);
+            for (j = 0; j < len; ++j) {
+                int64_t *d  = dr + (size_t)ds[j] * 4;
+                __m256i drv = _mm256_loadu_si256((__m256i *)d);
+                __m256i cfv = _mm256_cvtepu32_epi64(
+                        _mm_loadu_si128((__m128i *)(cfs + (size_t)j * 4)));
+                __m256i resv  = _mm256_sub_epi64(drv, _mm256_mul_epu32(mulv, cfv));
+                __m256i cmpv  = _mm256_cmpgt_epi64(zerov, resv);
+                resv  = _mm256_add_epi64(resv, _mm256_and_si256(cmpv, mod2v));
+                _mm256_storeu_si256((__m256i *)d, resv);
+            }
+        } else
+#endif
+        {
+            for (j = 0; j < len; ++j) {
+                int64_t *d            = dr + (size_t)ds[j] * nb;
+                const cf32_t *c       = cfs + (size_t)j * nb;
+                for (l = 0; l < nb; ++l) {
+                    d[l]  -=  mul[l] * c[l];
+                    d[l]  +=  (d[l] >> 63) & mod2[l];
+                }
+            }
+        }
+        for (l = 0; l < nb; ++l) {
+            dc[l] = 0;
+        }
+        *nops +=  len;
+    }
+
+    if (k == 0) {
+        /* zero reduction, unlucky prime */
+        *div = 1;
+        return NULL;
+    }
+
+    hm_t *row   = (hm_t *)malloc((unsigned long)(k+OFFSET) * sizeof(hm_t));
+    cf32_t *cf  = (cf32_t *)malloc((unsigned long)k * nb * sizeof(cf32_t));
+    j = 0;
+    hm_t *rs  = row + OFFSET;
+    for (i = ncl; i < ncols; ++i) {
+        const int64_t * const dc  = dr + (size_t)i * nb;
+        int64_t nz = 0;
+        for (l = 0; l < nb; ++l) {
+            nz  |=  dc[l];
+        }
+        if (nz != 0) {
+            rs[j] = (hm_t)i;
+            for (l = 0; l < nb; ++l) {
+                cf[(size_t)j * nb + l] = (cf32_t)dc[l];
+            }
+            j++;
+        }
+    }
+    row[BINDEX]   = bi;
+    row[MULT]     = mh;
+    row[COEFFS]   = tmp_pos;
+    row[PRELOOP]  = j % UNROLL;
+    row[LENGTH]   = j;
+    bcf[tmp_pos]  = cf;
+
+    return row;
+}
+
+static inline void normalize_sparse_matrix_row_ff_32_bundle(
+        cf32_t *cf,
+        const len_t len,
+        const int64_t *mod,
+        const len_t nb
+        )
+{
+    len_t i, l;
+
+    for (l = 0; l < nb; ++l) {
+        if (cf[l] == 1) {
+            continue;
+        }
+        const uint64_t inv  = mod_p_inverse_32(cf[l], mod[l]);
+        for (i = 0; i < len; ++i) {
+            cf[i*nb+l]  = (cf32_t)(((uint64_t)cf[i*nb+l] * inv) % mod[l]);
+        }
+    }
+}
+
+/* loads row with coefficients of prime l at cfs[l] into dr */
+static inline void load_sparse_row_to_dense_bundle(
+        int64_t *dr,
+        const hm_t * const row,
+        cf32_t *const *cfs,
+        const len_t nb
+        )
+{
+    len_t j, l;
+    const len_t len       = row[LENGTH];
+    const hm_t * const ds = row + OFFSET;
+    for (l = 0; l < nb; ++l) {
+        const cf32_t * const cf = cfs[l];
+        for (j = 0; j < len; ++j) {
+            dr[(size_t)ds[j] * nb + l] = (int64_t)cf[j];
+        }
+    }
+}
+
+static int exact_sparse_linear_algebra_ff_32_bundle(
+        mat_t **mats,
+        const bs_t * const *bss,
+        md_t **mds,
+        const len_t nb
+        )
+{
+    /* timings */
+    double ct0, ct1, rt0, rt1;
+    ct0 = cputime();
+    rt0 = realtime();
+
+    len_t i, j, k, l;
+    hi_t sc;
+    int div     = 0;
+    double nops = 0;
+
+    /* all matrices share their rows, only coefficients differ */
+    const mat_t * const mat = mats[0];
+    const len_t ncols = mat->nc;
+    const len_t nru   = mat->nru;
+    const len_t nrl   = mat->nrl;
+    const len_t ncr   = mat->ncr;
+    const len_t ncl   = mat->ncl;
+    const int32_t nthrds  = mds[0]->nthrds;
+
+    int64_t mod[PRIME_BUNDLE];
+    for (l = 0; l < nb; ++l) {
+        mod[l]  = (int64_t)mds[l]->fc;
+    }
+
+    /* known pivots have their leading term in the column of their index */
+    hm_t **pivs = (hm_t **)calloc((unsigned long)ncols, sizeof(hm_t *));
+    memcpy(pivs, mat->rr, (unsigned long)nru * sizeof(hm_t *));
+    cf32_t **kcf  = (cf32_t **)malloc((unsigned long)nru * sizeof(cf32_t *));
+#pragma omp parallel for num_threads(nthrds) private(i, j, l)
+    for (i = 0; i < nru; ++i) {
+        const len_t len = mat->rr[i][LENGTH];
+        kcf[i]  = (cf32_t *)malloc((unsigned long)len * nb * sizeof(cf32_t));
+        for (l = 0; l < nb; ++l) {
+            const cf32_t * const cf = bss[l]->cf_32[mats[l]->rr[i][COEFFS]];
+            for (j = 0; j < len; ++j) {
+                kcf[i][(size_t)j * nb + l]  = cf[j];
+            }
+        }
+    }
+    cf32_t **bcf  = (cf32_t **)calloc((unsigned long)nrl, sizeof(cf32_t *));
+
+    int64_t *dr  = (int64_t *)malloc(
+            (unsigned long)nthrds * ncols * nb * sizeof(int64_t));
+#pragma omp parallel for num_threads(nthrds) \
+    private(i, j, k, l, sc) reduction(+:nops) \
+    schedule(dynamic)
+    for (i = 0; i < nrl; ++i) {
+        if (div == 0) {
+            int64_t *drl    = dr + (size_t)omp_get_thread_num() * ncols * nb;
+            const hm_t *row = mat->tr[i];
+            cf32_t *cfs[PRIME_BUNDLE];
+            for (l = 0; l < nb; ++l) {
+                cfs[l]  = bss[l]->cf_32[mats[l]->tr[i][COEFFS]];
+            }
+            memset(drl, 0, (unsigned long)ncols * nb * sizeof(int64_t));
+            load_sparse_row_to_dense_bundle(drl, row, cfs, nb);
+            sc  = row[OFFSET];
+            hm_t *npiv  = NULL;
+            k = 0;
+            do {
+                int ldiv  = 0;
+                free(npiv);
+                free(bcf[i]);
+                bcf[i]  = NULL;
+                npiv  = reduce_dense_row_by_known_pivots_sparse_31_bit_bundle(
+                        drl, mat, pivs, kcf, bcf, sc, i, row[MULT], row[BINDEX],
+                        mod, nb, &ldiv, &nops);
+                if (ldiv != 0) {
+                    div   = 1;
+                    break;
+                }
+                normalize_sparse_matrix_row_ff_32_bundle(
+                        bcf[i], npiv[LENGTH], mod, nb);
+                sc  = npiv[OFFSET];
+                k   = __sync_bool_compare_and_swap(&pivs[npiv[OFFSET]], NULL, npiv);
+            } while (!k);
+        }
+    }
+
+    len_t npivs = 0; /* number of new pivots */
+    hm_t **piv  = NULL;
+    if (div == 0) {
+        /* interreduce new pivots */
+        dr  = realloc(dr, (unsigned long)ncols * nb * sizeof(int64_t));
+        piv = (hm_t **)malloc((unsigned long)ncr * sizeof(hm_t *));
+        for (i = 0; i < ncr; ++i) {
+            k = ncols-1-i;
+            if (pivs[k]) {
+                hm_t *row   = pivs[k];
+                const hm_t pos  = row[COEFFS];
+                cf32_t *cfs = bcf[pos];
+                const len_t len = row[LENGTH];
+                const hm_t * const ds = row + OFFSET;
+                memset(dr, 0, (unsigned long)ncols * nb * sizeof(int64_t));
+                for (j = 0; j < len; ++j) {
+                    for (l = 0; l < nb; ++l) {
+                        dr[(size_t)ds[j] * nb + l]  = (int64_t)cfs[(size_t)j * nb + l];
+                    }
+                }
+                sc  = ds[0];
+                pivs[k] = NULL;
+                bcf[pos]  = NULL;
+                pivs[k] = piv[npivs++] =
+                    reduce_dense_row_by_known_pivots_sparse_31_bit_bundle(
+                            dr, mat, pivs, kcf, bcf, sc, pos, row[MULT], row[BINDEX],
+                            mod, nb, &div, &nops);
+                free(row);
+                free(cfs);
+            }
+        }
+    }
+
+    if (div == 0) {
+        /* split the new pivots into the matrices of the primes, dropping
+         * the coefficients which vanish for a prime */
+        for (l = 0; l < nb; ++l) {
+            mat_t *m  = mats[l];
+            for (i = 0; i < nru; ++i) {
+                free_matrix_row(m->ra, m->rr[i]);
+            }
+            for (i = 0; i < nrl; ++i) {
+                free_matrix_row(m->ra, m->tr[i]);
+            }
+            m->tr     = realloc(m->tr, (unsigned long)npivs * sizeof(hm_t *));
+            m->cf_32  = realloc(m->cf_32,
+                    (unsigned long)npivs * sizeof(cf32_t *));
+        }
+#pragma omp parallel for num_threads(nthrds) private(i, j, k, l)
+        for (i = 0; i < npivs; ++i) {
+            const hm_t * const row  = piv[i];
+            const cf32_t * const cf = bcf[row[COEFFS]];
+            const len_t len         = row[LENGTH];
+            for (l = 0; l < nb; ++l) {
+                hm_t *nrow  = (hm_t *)malloc(
+                        (unsigned long)(len+OFFSET) * sizeof(hm_t));
+                cf32_t *ncf = (cf32_t *)malloc((unsigned long)len * sizeof(cf32_t));
+                for (k = 0, j = 0; j < len; ++j) {
+                    if (cf[(size_t)j * nb + l] != 0) {
+                        nrow[OFFSET+k]  = row[OFFSET+j];
+                        ncf[k]          = cf[(size_t)j * nb + l];
+                        k++;
+                    }
+                }
+                nrow[BINDEX]  = row[BINDEX];
+                nrow[MULT]    = row[MULT];
+                nrow[COEFFS]  = i;
+                nrow[PRELOOP] = k % UNROLL;
+                nrow[LENGTH]  = k;
+                mats[l]->tr[i]    = nrow;
+                mats[l]->cf_32[i] = ncf;
+            }
+        }
+    }
+
+    /* free bundle data */
+    for (i = 0; i < nru; ++i) {
+        free(kcf[i]);
+    }
+    free(kcf);
+    for (i = ncl; i < ncols; ++i) {
+        if (pivs[i] != NULL) {
+            free(bcf[pivs[i][COEFFS]]);
+            bcf[pivs[i][COEFFS]]  = NULL;
+            free(pivs[i]);
+        }
+    }
+    free(bcf);
+    free(pivs);
+    free(piv);
+    free(dr);
+
+    if (div != 0) {
+        return 1;
+    }
+
+    /* timings */
+    ct1 = cputime();
+    rt1 = realtime();
+    for (l = 0; l < nb; ++l) {
+        md_t *st  = mds[l];
+        mat_t *m  = mats[l];
+        st->np = m->np = m->nr = m->sz = npivs;
+        st->la_ctime  +=  ct1 - ct0;
+        st->la_rtime  +=  rt1 - rt0;
+        st->application_nr_mult +=  nops / 1000.0;
+        st->application_nr_add  +=  nops / 1000.0;
+        st->num_zerored += (nrl - m->np);
+        if (st->info_level > 1) {
+            printf("%9d new %7d zero", m->np, nrl - m->np);
+            fflush(stdout);
+        }
+    }
+
+    return 0;
+}
+
 static void copy_kernel_to_matrix(
         mat_t *mat,
         bs_t *kernel,
@@ -4257,11 +4682,13 @@ static void interreduce_matrix_rows_ff_32(
         const int free_basis
         )
 {
-    len_t i, j, k, l;
+    len_t i, l, w;
 
     const len_t nrows = mat->nr;
     const len_t ncols = mat->nc;
 
+    const int32_t nthrds = st->nthrds;
+
     /* adjust displaying timings for statistic printout */
     if (st->info_level > 1) {
         printf("                          ");
@@ -4279,38 +4706,53 @@ static void interreduce_matrix_rows_ff_32(
     for (i = 0; i < nrows; ++i) {
         pivs[mat->rr[i][OFFSET]]  = mat->rr[i];
     }
-
-    int64_t *dr = (int64_t *)malloc((unsigned long)ncols * sizeof(int64_t));
-    /* interreduce new pivots */
-    cf32_t *cfs;
-    /* starting column, coefficient array position in tmpcf */
-    hm_t sc;
-    k = nrows - 1;
+    /* rows with smaller lead terms come last in mat->tr */
+    len_t *tp = (len_t *)malloc((unsigned long)ncols * sizeof(len_t));
+    l = nrows;
     for (i = 0; i < ncols; ++i) {
-        l = ncols-1-i;
-        if (pivs[l] != NULL) {
-            memset(dr, 0, (unsigned long)ncols * sizeof(int64_t));
-            cfs = bs->cf_32[pivs[l][COEFFS]];
-            const len_t os  = pivs[l][PRELOOP];
-            const len_t len = pivs[l][LENGTH];
-            const len_t bi  = pivs[l][BINDEX];
-            const len_t mh  = pivs[l][MULT];
-            const hm_t * const ds = pivs[l] + OFFSET;
-            sc  = ds[0];
-            for (j = 0; j < os; ++j) {
-                dr[ds[j]] = (int64_t)cfs[j];
-            }
-            for (; j < len; j += UNROLL) {
-                dr[ds[j]]   = (int64_t)cfs[j];
-                dr[ds[j+1]] = (int64_t)cfs[j+1];
-                dr[ds[j+2]] = (int64_t)cfs[j+2];
-                dr[ds[j+3]] = (int64_t)cfs[j+3];
+        if (pivs[ncols-1-i] != NULL) {
+            tp[ncols-1-i] = --l;
+        }
+    }
+    len_t nw, *wo;
+    len_t *wr = compute_reduction_waves(&nw, &wo, pivs, ncols, mat->rr, nrows);
+
+    int64_t *dr = (int64_t *)malloc(
+            (unsigned long)(nthrds * ncols) * sizeof(int64_t));
+    /* interreduce new pivots, rows of one wave do not depend on each other */
+#pragma omp parallel num_threads(nthrds) private(i, l, w)
+    {
+        int64_t *drl  = dr + (omp_get_thread_num() * ncols);
+        for (w = 0; w < nw; ++w) {
+#pragma omp for schedule(dynamic)
+            for (i = wo[w]; i < wo[w+1]; ++i) {
+                len_t j;
+                hm_t *row = mat->rr[wr[i]];
+                l = row[OFFSET];
+                memset(drl, 0, (unsigned long)ncols * sizeof(int64_t));
+                const cf32_t * const cfs = bs->cf_32[row[COEFFS]];
+                const len_t os  = row[PRELOOP];
+                const len_t len = row[LENGTH];
+                const len_t bi  = row[BINDEX];
+                const len_t mh  = row[MULT];
+                const hm_t * const ds = row + OFFSET;
+                /* starting column */
+                const hm_t sc = ds[0];
+                for (j = 0; j < os; ++j) {
+                    drl[ds[j]] = (int64_t)cfs[j];
+                }
+                for (; j < len; j += UNROLL) {
+                    drl[ds[j]]   = (int64_t)cfs[j];
+                    drl[ds[j+1]] = (int64_t)cfs[j+1];
+                    drl[ds[j+2]] = (int64_t)cfs[j+2];
+                    drl[ds[j+3]] = (int64_t)cfs[j+3];
+                }
+                free_matrix_row(mat->ra, row);
+                pivs[l] = NULL;
+                pivs[l] = mat->tr[tp[l]] =
+                    reduce_dense_row_by_known_pivots_sparse_ff_32(
+                            drl, mat, bs, pivs, sc, l, mh, bi, 0,  st);
             }
-            free(pivs[l]);
-            pivs[l] = NULL;
-            pivs[l] = mat->tr[k--] =
-                reduce_dense_row_by_known_pivots_sparse_ff_32(
-                        dr, mat, bs, pivs, sc, l, mh, bi, 0,  st);
         }
     }
     if (free_basis != 0) {
@@ -4322,4 +4764,7 @@ static void interreduce_matrix_rows_ff_32(
     mat->np = nrows;
     free(pivs);
     free(dr);
+    free(tp);
+    free(wr);
+    free(wo);
 }
@@ -0,0 +1,462 @@
+/* This file is part of msolve.
+ *
+ * msolve is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * msolve is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with msolve.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors:
+ * Jérémy Berthomieu
+ * Christian Eder
+ * Mohab Safey El Din */
+
+#include "data.h"
+
+/* Linear algebra for primes 2^32 <= p < 2^63.
+ *
+ * The products of two coefficients do not fit into 64 bits anymore, so
+ * we cannot delay the modular reduction as for smaller primes. Dense rows
+ * are kept reduced, i.e. all entries are in [0, p). When reducing a dense
+ * row by a pivot the multiplier is fixed for the whole pivot row, thus we
+ * use Shoup's multiplication: after one precomputation per pivot row each
+ * product is reduced with one high and two low 64 bit multiplications.
+ *
+ * These primes are only reachable through neogb's interface: the
+ * multi-modular drivers of msolve still work with primes below 2^31 since
+ * their FGLM, CRT and lifting code is 32 bit. */
+
+static inline cf64_t *normalize_sparse_matrix_row_ff_64(
+        cf64_t *row,
+        const len_t len,
+        const uint64_t fc
+        )
+{
+    len_t i;
+
+    const uint64_t inv  = mod_p_inverse_64(row[0], fc);
+    const uint64_t invs = shoup_precomp_64(inv, fc);
+
+    for (i = 1; i < len; ++i) {
+        row[i]  = mod_p_mul_shoup_64(row[i], inv, invs, fc);
+    }
+    row[0]  = 1;
+
+    return row;
+}
+
+static hm_t *reduce_dense_row_by_known_pivots_sparse_ff_64(
+        int64_t *dr,
+        mat_t *mat,
+        hm_t *const *pivs,
+        const hi_t dpiv,    /* pivot of dense row at the beginning */
+        const hm_t tmp_pos, /* position of new coeffs array in tmpcf */
+        const len_t mh,     /* multiplier hash for tracing */
+        const len_t bi,     /* basis index of generating element */
+        const len_t tr,     /* trace data? */
+        md_t *st
+        )
+{
+    hi_t i, j, k;
+    cf64_t *cfs;
+    hm_t *dts;
+    const uint64_t mod          = st->fc;
+    const int64_t smod          = (int64_t)st->fc;
+    const len_t ncols           = mat->nc;
+    const len_t ncl             = mat->ncl;
+    cf64_t * const * const mcf  = mat->cf_64;
+
+    rba_t *rba;
+    if (tr > 0) {
+        rba = mat->rba[tmp_pos];
+    } else {
+        rba = NULL;
+    }
+
+    k = 0;
+    for (i = dpiv; i < ncols; ++i) {
+        if (dr[i] == 0) {
+            continue;
+        }
+        if (pivs[i] == NULL) {
+            k++;
+            continue;
+        }
+
+        /* found reducer row, get multiplier */
+        const uint64_t mul  = (uint64_t)dr[i];
+        const uint64_t muls = shoup_precomp_64(mul, mod);
+        dts   = pivs[i];
+        if (i < ncl) {
+            /* set corresponding bit of reducer in reducer bit array */
+            if (tr > 0) {
+                rba[i/32] |= 1U << (i % 32);
+            }
+        }
+        cfs   = mcf[dts[COEFFS]];
+        const len_t os  = dts[PRELOOP];
+        const len_t len = dts[LENGTH];
+        const hm_t * const ds = dts + OFFSET;
+        for (j = 0; j < os; ++j) {
+            dr[ds[j]]   -=  (int64_t)mod_p_mul_shoup_64(cfs[j], mul, muls, mod);
+            dr[ds[j]]   +=  (dr[ds[j]] >> 63) & smod;
+        }
+        for (; j < len; j += UNROLL) {
+            dr[ds[j]]   -=  (int64_t)mod_p_mul_shoup_64(cfs[j], mul, muls, mod);
+            dr[ds[j+1]] -=  (int64_t)mod_p_mul_shoup_64(cfs[j+1], mul, muls, mod);
+            dr[ds[j+2]] -=  (int64_t)mod_p_mul_shoup_64(cfs[j+2], mul, muls, mod);
+            dr[ds[j+3]] -=  (int64_t)mod_p_mul_shoup_64(cfs[j+3], mul, muls, mod);
+            dr[ds[j]]   +=  (dr[ds[j]] >> 63) & smod;
+            dr[ds[j+1]] +=  (dr[ds[j+1]] >> 63) & smod;
+            dr[ds[j+2]] +=  (dr[ds[j+2]] >> 63) & smod;
+            dr[ds[j+3]] +=  (dr[ds[j+3]] >> 63) & smod;
+        }
+        dr[i] = 0;
+        st->application_nr_mult +=  len / 1000.0;
+        st->application_nr_add  +=  len / 1000.0;
+        st->application_nr_red++;
+    }
+
+    if (k == 0) {
+        return NULL;
+    }
+
+    hm_t *row   = (hm_t *)malloc((unsigned long)(k+OFFSET) * sizeof(hm_t));
+    cf64_t *cf  = (cf64_t *)malloc((unsigned long)(k) * sizeof(cf64_t));
+    j = 0;
+    hm_t *rs  = row + OFFSET;
+    for (i = ncl; i < ncols; ++i) {
+        if (dr[i] != 0) {
+            rs[j] = (hm_t)i;
+            cf[j] = (cf64_t)dr[i];
+            j++;
+        }
+    }
+    row[BINDEX]   = bi;
+    row[MULT]     = mh;
+    row[COEFFS]   = tmp_pos;
+    row[PRELOOP]  = j % UNROLL;
+    row[LENGTH]   = j;
+    mat->cf_64[tmp_pos]  = cf;
+
+    return row;
+}
+
+static inline void load_sparse_row_to_dense_ff_64(
+        int64_t *dr,
+        const hm_t * const row,
+        const cf64_t * const cfs
+        )
+{
+    len_t j;
+    const len_t os  = row[PRELOOP];
+    const len_t len = row[LENGTH];
+    const hm_t * const ds = row + OFFSET;
+    for (j = 0; j < os; ++j) {
+        dr[ds[j]]   = (int64_t)cfs[j];
+    }
+    for (; j < len; j += UNROLL) {
+        dr[ds[j]]   = (int64_t)cfs[j];
+        dr[ds[j+1]] = (int64_t)cfs[j+1];
+        dr[ds[j+2]] = (int64_t)cfs[j+2];
+        dr[ds[j+3]] = (int64_t)cfs[j+3];
+    }
+}
+
+static void exact_sparse_reduced_echelon_form_ff_64(
+        mat_t *mat,
+        const bs_t * const tbr,
+        const bs_t * const bs,
+        md_t *st
+        )
+{
+    len_t i = 0, j, k, l, w;
+    hi_t sc = 0;    /* starting column */
+
+    const len_t ncols = mat->nc;
+    const len_t nrl   = mat->nrl;
+    const len_t ncr   = mat->ncr;
+    const len_t ncl   = mat->ncl;
+
+    const int32_t nthrds = st->nthrds;
+
+    len_t bad_prime = 0;
+
+    /* we fill in all known lead terms in pivs */
+    hm_t **pivs   = (hm_t **)calloc((unsigned long)ncols, sizeof(hm_t *));
+    if (st->in_final_reduction_step == 0) {
+        memcpy(pivs, mat->rr, (unsigned long)mat->nru * sizeof(hm_t *));
+    } else {
+        for (i = 0;  i < mat->nru; ++i) {
+            pivs[mat->rr[i][OFFSET]] = mat->rr[i];
+        }
+    }
+    j = nrl;
+    for (i = 0; i < mat->nru; ++i) {
+        mat->cf_64[j]      = bs->cf_64[mat->rr[i][COEFFS]];
+        mat->rr[i][COEFFS] = j;
+        ++j;
+    }
+
+    /* unkown pivot rows we have to reduce with the known pivots first */
+    hm_t **upivs  = mat->tr;
+
+    /* in the final reduction step the rows are reduced in waves, see
+     * compute_reduction_waves(), otherwise all rows form one wave */
+    len_t nw, *wo, *wr;
+    if (st->in_final_reduction_step == 1) {
+        wr  = compute_reduction_waves(&nw, &wo, pivs, ncols, upivs, nrl);
+    } else {
+        nw  = 1;
+        wo  = (len_t *)malloc(2 * sizeof(len_t));
+        wr  = (len_t *)malloc((unsigned long)nrl * sizeof(len_t));
+        wo[0] = 0;
+        wo[1] = nrl;
+        for (i = 0; i < nrl; ++i) {
+            wr[i] = i;
+        }
+    }
+
+    int64_t *dr  = (int64_t *)malloc(
+            (unsigned long)(nthrds * ncols) * sizeof(int64_t));
+    /* mo need to have any sharing dependencies on parallel computation,
+     * no data to be synchronized at this step of the linear algebra */
+#pragma omp parallel num_threads(nthrds) private(i, j, k, l, w, sc)
+    {
+        for (w = 0; w < nw; ++w) {
+#pragma omp for schedule(dynamic)
+            for (l = wo[w]; l < wo[w+1]; ++l) {
+                i = wr[l];
+                if (bad_prime == 0) {
+                    int64_t *drl    = dr + (omp_get_thread_num() * ncols);
+                    hm_t *npiv      = upivs[i];
+                    cf64_t *cfs     = tbr->cf_64[npiv[COEFFS]];
+                    const len_t bi  = npiv[BINDEX];
+                    const len_t mh  = npiv[MULT];
+                    k = 0;
+                    memset(drl, 0, (unsigned long)ncols * sizeof(int64_t));
+                    load_sparse_row_to_dense_ff_64(drl, npiv, cfs);
+                    cfs = NULL;
+                    do {
+                        /* If we do normal form computations the first monomial in the polynomial might not
+                        be a known pivot, thus setting it to npiv[OFFSET] can lead to wrong results. */
+                        sc  = st->nf == 0 ? npiv[OFFSET] : 0;
+                        free_matrix_row(mat->ra, npiv);
+                        free(cfs);
+                        npiv  = mat->tr[i] = reduce_dense_row_by_known_pivots_sparse_ff_64(
+                                drl, mat, pivs, sc, i, mh, bi, st->trace_level == LEARN_TRACER, st);
+                        if (st->nf > 0) {
+                            if (!npiv) {
+                                mat->tr[i]  = NULL;
+                                break;
+                            }
+                            mat->tr[i]  = npiv;
+                            cfs = mat->cf_64[npiv[COEFFS]];
+                            break;
+                        } else {
+                            if (!npiv) {
+                                if (st->trace_level == APPLY_TRACER) {
+                                    bad_prime = 1;
+                                }
+                                break;
+                            }
+                            /* normalize coefficient array
+                             * NOTE: this has to be done here, otherwise the reduction may
+                             * lead to wrong results in a parallel computation since other
+                             * threads might directly use the new pivot once it is synced. */
+                            if (mat->cf_64[npiv[COEFFS]][0] != 1) {
+                                normalize_sparse_matrix_row_ff_64(
+                                        mat->cf_64[npiv[COEFFS]], npiv[LENGTH], st->fc);
+                            }
+                            k   = __sync_bool_compare_and_swap(&pivs[npiv[OFFSET]], NULL, npiv);
+                            cfs = mat->cf_64[npiv[COEFFS]];
+                        }
+                    } while (!k);
+                }
+            }
+        }
+    }
+    free(wr);
+    free(wo);
+
+    if (bad_prime == 1) {
+        for (i = 0; i < ncl+ncr; ++i) {
+            free_matrix_row(mat->ra, pivs[i]);
+            pivs[i] = NULL;
+        }
+        mat->np = 0;
+        if (st->info_level > 0) {
+            fprintf(stderr, "Zero reduction while applying tracer, bad prime.\n");
+        }
+        return;
+    }
+
+    /* construct the trace */
+    if (st->trace_level == LEARN_TRACER && st->in_final_reduction_step == 0) {
+        construct_trace(st->tr, mat);
+    }
+
+    /* we do not need the old pivots anymore */
+    for (i = 0; i < ncl; ++i) {
+        free_matrix_row(mat->ra, pivs[i]);
+        pivs[i] = NULL;
+    }
+
+    len_t npivs = 0; /* number of new pivots */
+
+    if (st->nf == 0 && st->in_final_reduction_step == 0) {
+        dr      = realloc(dr, (unsigned long)ncols * sizeof(int64_t));
+        mat->tr = realloc(mat->tr, (unsigned long)ncr * sizeof(hm_t *));
+
+        /* interreduce new pivots */
+        cf64_t *cfs;
+        hm_t cf_array_pos;
+        for (i = 0; i < ncr; ++i) {
+            k = ncols-1-i;
+            if (pivs[k]) {
+                memset(dr, 0, (unsigned long)ncols * sizeof(int64_t));
+                cfs = mat->cf_64[pivs[k][COEFFS]];
+                cf_array_pos    = pivs[k][COEFFS];
+                const len_t bi  = pivs[k][BINDEX];
+                const len_t mh  = pivs[k][MULT];
+                sc  = pivs[k][OFFSET];
+                load_sparse_row_to_dense_ff_64(dr, pivs[k], cfs);
+                free_matrix_row(mat->ra, pivs[k]);
+                free(cfs);
+                pivs[k] = NULL;
+                pivs[k] = mat->tr[npivs++] =
+                    reduce_dense_row_by_known_pivots_sparse_ff_64(
+                            dr, mat, pivs, sc, cf_array_pos, mh, bi, 0, st);
+            }
+        }
+        mat->tr = realloc(mat->tr, (unsigned long)npivs * sizeof(hi_t *));
+        st->np = mat->np = mat->nr = mat->sz = npivs;
+    } else {
+        st->np = mat->np = mat->nr = mat->sz = nrl;
+    }
+    free(pivs);
+    pivs  = NULL;
+    free(dr);
+    dr  = NULL;
+}
+
+static void exact_sparse_linear_algebra_ff_64(
+        mat_t *mat,
+        const bs_t * const tbr,
+        const bs_t * const bs,
+        md_t *st
+        )
+{
+    /* timings */
+    double ct0, ct1, rt0, rt1;
+    ct0 = cputime();
+    rt0 = realtime();
+
+    /* allocate temporary storage space for sparse
+     * coefficients of all pivot rows */
+    mat->cf_64  = realloc(mat->cf_64,
+            (unsigned long)mat->nr * sizeof(cf64_t *));
+    exact_sparse_reduced_echelon_form_ff_64(mat, tbr, bs, st);
+
+    /* timings */
+    ct1 = cputime();
+    rt1 = realtime();
+    st->la_ctime  +=  ct1 - ct0;
+    st->la_rtime  +=  rt1 - rt0;
+
+    st->num_zerored += (mat->nrl - mat->np);
+    if (st->info_level > 1) {
+        printf("%9d new %7d zero", mat->np, mat->nrl - mat->np);
+        fflush(stdout);
+    }
+}
+
+static void interreduce_matrix_rows_ff_64(
+        mat_t *mat,
+        bs_t *bs,
+        md_t *st,
+        const int free_basis
+        )
+{
+    len_t i, l, w;
+
+    const len_t nrows = mat->nr;
+    const len_t ncols = mat->nc;
+
+    const int32_t nthrds = st->nthrds;
+
+    /* adjust displaying timings for statistic printout */
+    if (st->info_level > 1) {
+        printf("                          ");
+    }
+
+    mat->tr = realloc(mat->tr, (unsigned long)ncols * sizeof(hm_t *));
+
+    mat->cf_64  = realloc(mat->cf_64,
+            (unsigned long)ncols * sizeof(cf64_t *));
+    memset(mat->cf_64, 0, (unsigned long)ncols * sizeof(cf64_t *));
+    hm_t **pivs = (hm_t **)calloc((unsigned long)ncols, sizeof(hm_t *));
+    /* copy coefficient arrays from basis in matrix, maybe
+     * several rows need the same coefficient arrays, but we
+     * cannot share them here. */
+    for (i = 0; i < nrows; ++i) {
+        pivs[mat->rr[i][OFFSET]]  = mat->rr[i];
+    }
+
+    /* rows with smaller lead terms come last in mat->tr */
+    len_t *tp = (len_t *)malloc((unsigned long)ncols * sizeof(len_t));
+    l = nrows;
+    for (i = 0; i < ncols; ++i) {
+        if (pivs[ncols-1-i] != NULL) {
+            tp[ncols-1-i] = --l;
+        }
+    }
+    len_t nw, *wo;
+    len_t *wr = compute_reduction_waves(&nw, &wo, pivs, ncols, mat->rr, nrows);
+
+    int64_t *dr = (int64_t *)malloc(
+            (unsigned long)(nthrds * ncols) * sizeof(int64_t));
+    /* interreduce new pivots, rows of one wave do not depend on each other */
+#pragma omp parallel num_threads(nthrds) private(i, l, w)
+    {
+        int64_t *drl  = dr + (omp_get_thread_num() * ncols);
+        for (w = 0; w < nw; ++w) {
+#pragma omp for schedule(dynamic)
+            for (i = wo[w]; i < wo[w+1]; ++i) {
+                hm_t *row = mat->rr[wr[i]];
+                l = row[OFFSET];
+                memset(drl, 0, (unsigned long)ncols * sizeof(int64_t));
+                const cf64_t * const cfs = bs->cf_64[row[COEFFS]];
+                const len_t bi  = row[BINDEX];
+                const len_t mh  = row[MULT];
+                /* starting column */
+                const hm_t sc   = row[OFFSET];
+                load_sparse_row_to_dense_ff_64(drl, row, cfs);
+                free_matrix_row(mat->ra, row);
+                pivs[l] = NULL;
+                pivs[l] = mat->tr[tp[l]] =
+                    reduce_dense_row_by_known_pivots_sparse_ff_64(
+                            drl, mat, pivs, sc, l, mh, bi, 0,  st);
+            }
+        }
+    }
+    if (free_basis != 0) {
+        /* free now all polynomials in the basis and reset bs->ld to 0. */
+        free_basis_elements(bs);
+    }
+    free(mat->rr);
+    mat->rr = NULL;
+    mat->np = nrows;
+    free(pivs);
+    free(dr);
+    free(tp);
+    free(wr);
+    free(wo);
+}
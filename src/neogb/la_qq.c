@@ -401,7 +401,7 @@ static void exact_sparse_reduced_echelon_form_ab_first_qq(
             mpz_set(dr[ds[j+2]], cfs[j+2]);
             mpz_set(dr[ds[j+3]], cfs[j+3]);
         }
-        free(pivs[k]);
+        free_matrix_row(mat->ra, pivs[k]);
         cfs = NULL;;
         pivs[k] = NULL;
         pivs[k] =
@@ -471,7 +471,7 @@ static void exact_sparse_reduced_echelon_form_ab_first_qq(
                 }
             }
             free(cfs);
-            free(npiv);
+            free_matrix_row(mat->ra, npiv);
             npiv  = reduce_dense_row_by_known_pivots_sparse_ab_first_qq(
                     drl, mat, pivs, sc, i);
             if (!npiv) {
@@ -499,7 +499,7 @@ static void exact_sparse_reduced_echelon_form_ab_first_qq(
         }
         free(mat->cf_ab_qq[pivs[i][COEFFS]]);
         mat->cf_ab_qq[pivs[i][COEFFS]] = NULL;
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
 
@@ -538,7 +538,7 @@ static void exact_sparse_reduced_echelon_form_ab_first_qq(
                 mpz_swap(dr[ds[j+3]], cfs[j+3]);
                 mpz_clear(cfs[j+3]);
             }
-            free(pivs[k]);
+            free_matrix_row(mat->ra, pivs[k]);
             free(cfs);
             pivs[k] = NULL;
             pivs[k] = mat->tr[npivs] =
@@ -645,7 +645,7 @@ static void exact_sparse_reduced_echelon_form_qq(
                 }
             }
             free(cfs);
-            free(npiv);
+            free_matrix_row(mat->ra, npiv);
             npiv  = reduce_dense_row_by_known_pivots_sparse_qq(
                     drl, mat, bs, pivs, sc, i);
             if (!npiv) {
@@ -668,7 +668,7 @@ static void exact_sparse_reduced_echelon_form_qq(
 
     /* we do not need the old pivots anymore */
     for (i = 0; i < ncl; ++i) {
-        free(pivs[i]);
+        free_matrix_row(mat->ra, pivs[i]);
         pivs[i] = NULL;
     }
 
@@ -709,7 +709,7 @@ static void exact_sparse_reduced_echelon_form_qq(
                 mpz_swap(dr[ds[j+3]], cfs[j+3]);
                 mpz_clear(cfs[j+3]);
             }
-            free(pivs[k]);
+            free_matrix_row(mat->ra, pivs[k]);
             free(cfs);
             pivs[k] = NULL;
             pivs[k] = mat->tr[npivs] =
@@ -855,7 +855,7 @@ static void interreduce_matrix_rows_qq(
                 mpz_swap(dr[ds[j+2]], cfs[j+2]);
                 mpz_swap(dr[ds[j+3]], cfs[j+3]);
             }
-            free(pivs[l]);
+            free_matrix_row(mat->ra, pivs[l]);
             pivs[l] = NULL;
             pivs[l] = mat->tr[k--] =
                 reduce_dense_row_by_known_pivots_sparse_qq(
@@ -22,7 +22,7 @@
 #include "meta_data.h"
 md_t *copy_meta_data(
 		     const md_t * const gmd,
-		     const int32_t prime
+		     const uint64_t prime
 		     )
 {
     md_t *md = (md_t *)malloc(sizeof(md_t));
@@ -32,18 +32,10 @@ md_t *copy_meta_data(
     md->application_nr_mult = 0;
     md->application_nr_add  = 0;
     md->application_nr_red  = 0;
+    md->sdg = 0;
+    md->sdu = 0;
+    md->sdv = NULL;
 
-    if (md->fc < (int32_t)(1) << 8) {
-        md->ff_bits = 8;
-    } else {
-        if (md->fc < (int32_t)(1) << 16) {
-            md->ff_bits = 16;
-        } else {
-            if (md->fc < (int32_t)(1) << 31) {
-                md->ff_bits = 32;
-            }
-        }
-    }
     set_ff_bits(md, md->fc);
     return md;
 }
@@ -58,6 +50,7 @@ void free_meta_data(
         free_pairset(&(md->ps));
     }
     free(md->hcm);
+    free(md->sdv);
 
     ht_t *ht = md->ht;
     if (ht != NULL) {
@@ -110,7 +103,7 @@ void print_initial_statistics(
         fprintf(file, "#variables             %11d\n", st->nvars);
         fprintf(file, "#equations             %11d\n", st->ngens);
         fprintf(file, "#invalid equations     %11d\n", st->ngens_invalid);
-        fprintf(file, "field characteristic   %11u\n", st->fc);
+        fprintf(file, "field characteristic   %11lu\n", (unsigned long)st->fc);
         fprintf(file, "homogeneous input?     %11d\n", st->homogeneous);
         fprintf(file, "signature-based computation %6d\n", st->use_signatures);
         if (st->mo == 0 && st->nev == 0) {
@@ -26,7 +26,7 @@
 
 md_t *copy_meta_data(
 		     const md_t * const gmd,
-		     const int32_t prime
+		     const uint64_t prime
 		     );
 
 md_t *allocate_meta_data(
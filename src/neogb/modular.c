@@ -62,6 +62,241 @@ trace_t *initialize_trace(
     return tr;
 }
 
+/* binary format of a stored tracer, all entries in native byte order:
+ * magic, version, the basis hash table (layout, random values, divmask
+ * and all exponent vectors in insertion order), the length of the input
+ * basis and the trace data of each F4 round. Saturation steps are not
+ * stored. */
+#define TRACE_FILE_MAGIC    0x5254534d /* "MSTR" */
+#define TRACE_FILE_VERSION  2
+
+static int write_array(
+        FILE *f,
+        const void *a,
+        const size_t sz,
+        const size_t n
+        )
+{
+    return n == 0 || fwrite(a, sz, n, f) == n;
+}
+
+static int read_array(
+        FILE *f,
+        void *a,
+        const size_t sz,
+        const size_t n
+        )
+{
+    return n == 0 || fread(a, sz, n, f) == n;
+}
+
+/* number of rba_t words for a to be reduced row with rld/2 reducers,
+ * see construct_trace() */
+static inline unsigned long trace_rba_length(
+        const td_t * const td
+        )
+{
+    const len_t nrr = td->rld / 2;
+    return nrr / 32 + ((nrr % 32) != 0);
+}
+
+int write_trace(
+        FILE *f,
+        const trace_t * const tr,
+        const bs_t * const bs
+        )
+{
+    len_t i, j;
+
+    const ht_t * const bht  = bs->ht;
+    const uint32_t head[2]  = {TRACE_FILE_MAGIC, TRACE_FILE_VERSION};
+    const len_t layout[7]   = {bht->nv, bht->evl, bht->ebl,
+                               bht->ndv, bht->bpv, (len_t)bht->eld, bs->ld};
+
+    int ok = write_array(f, head, sizeof(uint32_t), 2)
+        && write_array(f, layout, sizeof(len_t), 7)
+        && write_array(f, bht->rn, sizeof(val_t), bht->evl)
+        && write_array(f, bht->dv, sizeof(len_t), bht->ndv)
+        && write_array(f, bht->dm, sizeof(sdm_t),
+                (unsigned long)bht->ndv * bht->bpv);
+
+    /* index 0 is never used in the basis hash table */
+    for (i = 1; ok && i < bht->eld; ++i) {
+        ok = write_array(f, bht->ev[i], sizeof(exp_t), bht->evl);
+    }
+
+    ok = ok && write_array(f, &(tr->ltd), sizeof(len_t), 1);
+    for (i = 0; ok && i < tr->ltd; ++i) {
+        const td_t *td = tr->td + i;
+        const len_t meta[4] = {(len_t)td->deg, td->rld, td->tld, td->nlm};
+        ok = write_array(f, meta, sizeof(len_t), 4)
+            && write_array(f, td->rri, sizeof(len_t), td->rld)
+            && write_array(f, td->tri, sizeof(len_t), td->tld)
+            && write_array(f, td->nlms, sizeof(hm_t), td->nlm);
+        const unsigned long nlrba = trace_rba_length(td);
+        for (j = 0; ok && j < td->tld/2; ++j) {
+            ok = write_array(f, td->rba[j], sizeof(rba_t), nlrba);
+        }
+    }
+    const len_t nlmh = tr->lmh != NULL ? tr->lml : 0;
+    ok = ok && write_array(f, &(tr->lml), sizeof(bl_t), 1)
+        && write_array(f, tr->lmps, sizeof(bl_t), tr->lml)
+        && write_array(f, tr->lm, sizeof(sdm_t), tr->lml)
+        && write_array(f, &nlmh, sizeof(len_t), 1)
+        && write_array(f, tr->lmh, sizeof(hm_t), nlmh);
+
+    return ok ? 0 : -1;
+}
+
+/* reads a tracer stored by write_trace(). bs must be the basis of the
+ * current input, its hash table after calculate_divmask() was applied: it
+ * is only accepted if the stored hash table starts with the same monomials
+ * and uses the same hashing and divmask data, the remaining stored
+ * monomials are then added to the hash table in their original order, so
+ * that all hashes in the trace stay valid. returns NULL if the tracer does
+ * not fit the input. */
+trace_t *read_trace(
+        FILE *f,
+        const bs_t * const bs
+        )
+{
+    len_t i, j;
+    uint32_t head[2];
+    len_t layout[7];
+
+    ht_t *bht = bs->ht;
+
+    if (!read_array(f, head, sizeof(uint32_t), 2)
+            || head[0] != TRACE_FILE_MAGIC
+            || head[1] != TRACE_FILE_VERSION) {
+        return NULL;
+    }
+    if (!read_array(f, layout, sizeof(len_t), 7)
+            || layout[0] != bht->nv || layout[1] != bht->evl
+            || layout[2] != bht->ebl || layout[3] != bht->ndv
+            || layout[4] != bht->bpv || layout[5] < bht->eld
+            || layout[6] != bs->ld) {
+        return NULL;
+    }
+    const len_t evl = bht->evl;
+    const len_t eld = layout[5];
+    const unsigned long ndm = (unsigned long)bht->ndv * bht->bpv;
+
+    val_t *rn = (val_t *)malloc((unsigned long)evl * sizeof(val_t));
+    len_t *dv = (len_t *)malloc((unsigned long)bht->ndv * sizeof(len_t));
+    sdm_t *dm = (sdm_t *)malloc(ndm * sizeof(sdm_t));
+    exp_t *ev = (exp_t *)malloc((unsigned long)evl * sizeof(exp_t));
+
+    int ok = read_array(f, rn, sizeof(val_t), evl)
+        && read_array(f, dv, sizeof(len_t), bht->ndv)
+        && read_array(f, dm, sizeof(sdm_t), ndm)
+        && memcmp(rn, bht->rn, (unsigned long)evl * sizeof(val_t)) == 0
+        && memcmp(dv, bht->dv, (unsigned long)bht->ndv * sizeof(len_t)) == 0
+        && memcmp(dm, bht->dm, ndm * sizeof(sdm_t)) == 0;
+
+    /* monomials of the input generators */
+    const len_t ild = (len_t)bht->eld;
+    for (i = 1; ok && i < ild; ++i) {
+        ok = read_array(f, ev, sizeof(exp_t), evl)
+            && memcmp(ev, bht->ev[i], (unsigned long)evl * sizeof(exp_t)) == 0;
+    }
+    /* monomials generated during learning */
+    for (i = ild; ok && i < eld; ++i) {
+        ok = read_array(f, ev, sizeof(exp_t), evl);
+        if (ok) {
+            while (bht->esz - bht->eld <= 1) {
+                enlarge_hash_table(bht);
+            }
+            ok = insert_in_hash_table(ev, bht) == i;
+        }
+    }
+    free(rn);
+    free(dv);
+    free(dm);
+    free(ev);
+    if (!ok) {
+        return NULL;
+    }
+
+    trace_t *tr = (trace_t *)calloc(1, sizeof(trace_t));
+    tr->sts = 8;
+    tr->ts  = calloc((unsigned long)tr->sts, sizeof(ts_t));
+    tr->rsz = 8;
+    tr->rd  = calloc((unsigned long)tr->rsz, sizeof(len_t));
+
+    /* length of the basis at the start of the current round, each round
+     * adds its nlm new elements */
+    len_t bld = bs->ld;
+
+    ok = read_array(f, &(tr->std), sizeof(len_t), 1);
+    tr->td  = calloc((unsigned long)tr->std + 1, sizeof(td_t));
+    for (i = 0; ok && i < tr->std; ++i) {
+        td_t *td = tr->td + i;
+        len_t meta[4];
+        ok = read_array(f, meta, sizeof(len_t), 4);
+        if (!ok) {
+            break;
+        }
+        td->deg   = (deg_t)meta[0];
+        td->rld   = meta[1];
+        td->tld   = meta[2];
+        td->nlm   = meta[3];
+        td->rri   = (len_t *)malloc((unsigned long)td->rld * sizeof(len_t));
+        td->tri   = (len_t *)malloc((unsigned long)td->tld * sizeof(len_t));
+        td->nlms  = (hm_t *)malloc((unsigned long)td->nlm * sizeof(hm_t));
+        td->rba   = (rba_t **)calloc((unsigned long)td->tld/2, sizeof(rba_t *));
+        /* free_trace() needs a consistent load */
+        tr->ltd++;
+        ok = read_array(f, td->rri, sizeof(len_t), td->rld)
+            && read_array(f, td->tri, sizeof(len_t), td->tld)
+            && read_array(f, td->nlms, sizeof(hm_t), td->nlm);
+        const unsigned long nlrba = trace_rba_length(td);
+        for (j = 0; ok && j < td->tld/2; ++j) {
+            td->rba[j]  = (rba_t *)calloc(nlrba, sizeof(rba_t));
+            ok = read_array(f, td->rba[j], sizeof(rba_t), nlrba);
+        }
+        /* rows are pairs of a basis index and a multiplier hash, both
+         * have to be valid in this round */
+        ok = ok && td->rld % 2 == 0 && td->tld % 2 == 0;
+        for (j = 0; ok && j < td->rld; j += 2) {
+            ok = td->rri[j] < bld && td->rri[j+1] < eld;
+        }
+        for (j = 0; ok && j < td->tld; j += 2) {
+            ok = td->tri[j] < bld && td->tri[j+1] < eld;
+        }
+        for (j = 0; ok && j < td->nlm; ++j) {
+            ok = td->nlms[j] < eld;
+        }
+        ok = ok && td->nlm <= (len_t)-1 - bld;
+        bld += td->nlm;
+    }
+    len_t nlmh = 0;
+    ok = ok && read_array(f, &(tr->lml), sizeof(bl_t), 1);
+    if (ok) {
+        tr->lmps  = (bl_t *)malloc((unsigned long)tr->lml * sizeof(bl_t));
+        tr->lm    = (sdm_t *)malloc((unsigned long)tr->lml * sizeof(sdm_t));
+        ok = read_array(f, tr->lmps, sizeof(bl_t), tr->lml)
+            && read_array(f, tr->lm, sizeof(sdm_t), tr->lml)
+            && read_array(f, &nlmh, sizeof(len_t), 1)
+            && nlmh <= tr->lml;
+    }
+    for (i = 0; ok && i < tr->lml; ++i) {
+        ok = tr->lmps[i] < bld;
+    }
+    if (ok && nlmh > 0) {
+        tr->lmh = (hm_t *)malloc((unsigned long)nlmh * sizeof(hm_t));
+        ok = read_array(f, tr->lmh, sizeof(hm_t), nlmh);
+        for (i = 0; ok && i < nlmh; ++i) {
+            ok = tr->lmh[i] < eld;
+        }
+    }
+    if (!ok || tr->ltd == 0) {
+        free_trace(&tr);
+        return NULL;
+    }
+    return tr;
+}
+
 void free_trace(
         trace_t **trp
         )
@@ -84,6 +319,7 @@ void free_trace(
             free(tr->td[i].rba);
             free(tr->td[i].nlms);
         }
+        free_symbolic_data(tr);
         free(tr->lm);
         free(tr->lmh);
         free(tr->lmps);
@@ -134,7 +370,7 @@ void reduce_basis_no_hash_table_switching(
     /* add all non-redundant basis elements as matrix rows */
     for (i = 0; i < bs->lml; ++i) {
         mat->rr[mat->nr] = multiplied_poly_to_matrix_row(
-                sht, bht, 0, etmp, bs->hm[bs->lmps[i]]);
+                mat->ra, sht, bht, 0, etmp, bs->hm[bs->lmps[i]]);
         sht->hd[mat->rr[mat->nr][OFFSET]].idx  = 1;
         mat->nr++;
     }
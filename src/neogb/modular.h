@@ -34,6 +34,17 @@ void free_trace(
         trace_t **trp
         );
 
+int write_trace(
+        FILE *f,
+        const trace_t * const tr,
+        const bs_t * const bs
+        );
+
+trace_t *read_trace(
+        FILE *f,
+        const bs_t * const bs
+        );
+
 void free_lucky_primes(
         primes_t **lpp
         );
@@ -117,7 +117,7 @@ static void select_all_spairs(
         const hi_t h    = bht->hd[lcm].val - bht->hd[b[OFFSET]].val;
         /* note that we use index mat->nc and not mat->nr since for each new
          * lcm we add exactly one row to mat->rr */
-        rrows[nrr]  = multiplied_poly_to_matrix_row(sht, bht, h, etmp, b);
+        rrows[nrr]  = multiplied_poly_to_matrix_row(mat->ra, sht, bht, h, etmp, b);
         /* track trace information ? */
         if (tht != NULL) { 
            rrows[nrr][BINDEX]  = prev;
@@ -153,7 +153,7 @@ static void select_all_spairs(
                 etmp[l]   =   (exp_t)(elcm[l] - eb[l]);
             }
             const hi_t h  = bht->hd[lcm].val - bht->hd[b[OFFSET]].val;
-            trows[ntr] = multiplied_poly_to_matrix_row(sht, bht, h, etmp, b);
+            trows[ntr] = multiplied_poly_to_matrix_row(mat->ra, sht, bht, h, etmp, b);
             /* track trace information ? */
             if (tht != NULL) {
                 trows[ntr][BINDEX]  = prev;
@@ -220,10 +220,26 @@ static int32_t select_spairs_by_minimal_degree(
     spair_t *ps     = psl->p;
     const len_t evl = bht->evl;
 
-    /* sort pair set */
-    sort_r(ps, (unsigned long)psl->ld, sizeof(spair_t), spair_cmp, bht);
     /* get minimal degree */
     mdeg  = ps[0].deg;
+    for (i = 1; i < psl->ld; ++i) {
+        if ((len_t)ps[i].deg < mdeg) {
+            mdeg  = ps[i].deg;
+        }
+    }
+    /* only the pairs of minimal degree are needed in order, so we move
+     * them to the front and sort just these, the remaining pairs stay
+     * unordered in the pair set */
+    spair_t sp;
+    npd = 0;
+    for (i = 0; i < psl->ld; ++i) {
+        if ((len_t)ps[i].deg == mdeg) {
+            sp        = ps[npd];
+            ps[npd++] = ps[i];
+            ps[i]     = sp;
+        }
+    }
+    sort_r(ps, (unsigned long)npd, sizeof(spair_t), spair_cmp, bht);
 
     /* compute a truncated GB? Check maximal degree. */
     if (md->max_gb_degree < mdeg) {
@@ -251,12 +267,6 @@ static int32_t select_spairs_by_minimal_degree(
     }
     printf("\n");
 #endif
-    for (i = 0; i < psl->ld; ++i) {
-        if (ps[i].deg > mdeg) {
-            break;
-        }
-    }
-    npd  = i;
     /* printf("npd %d\n", npd); */
     /* sort_r(ps, (unsigned long)npd, sizeof(spair_t), spair_cmp, bht); */
     /* now do maximal selection if it applies */
@@ -322,7 +332,7 @@ static int32_t select_spairs_by_minimal_degree(
         const hi_t h    = bht->hd[lcm].val - bht->hd[b[OFFSET]].val;
         /* note that we use index mat->nc and not mat->nr since for each new
          * lcm we add exactly one row to mat->rr */
-        rrows[nrr]  = multiplied_poly_to_matrix_row(sht, bht, h, etmp, b);
+        rrows[nrr]  = multiplied_poly_to_matrix_row(mat->ra, sht, bht, h, etmp, b);
         /* track trace information ? */
         if (md->trace_level == LEARN_TRACER) { 
            rrows[nrr][BINDEX]  = prev;
@@ -357,7 +367,7 @@ static int32_t select_spairs_by_minimal_degree(
                 etmp[l]   =   (exp_t)(elcm[l] - eb[l]);
             }
             const hi_t h  = bht->hd[lcm].val - bht->hd[b[OFFSET]].val;
-            trows[ntr] = multiplied_poly_to_matrix_row(sht, bht, h, etmp, b);
+            trows[ntr] = multiplied_poly_to_matrix_row(mat->ra, sht, bht, h, etmp, b);
             /* track trace information ? */
             if (md->trace_level == LEARN_TRACER) {
                 trows[ntr][BINDEX]  = prev;
@@ -482,40 +492,147 @@ static void select_tbr(
          * const deg_t d   = sht->hd[mulh].deg; */
         const hi_t h    = 0;
         trows[ntr++]    = multiplied_poly_to_matrix_row(
-                sht, bht, h, mul, b);
+                mat->ra, sht, bht, h, mul, b);
         mat->nr++;
     }
 }
 
 
-static inline void find_multiplied_reducer(
-        bs_t *bs,
-        const hm_t m,
-        len_t *nr,
-        hm_t **rows,
-        ht_t *sht,
-        const md_t * const md
+/* below this number of lead monomials the plain scan over bs->lm is
+ * faster than using the divisibility index */
+#define DVI_MIN_LML 256
+
+static dvi_t *initialize_divisibility_index(
+        const bs_t * const bs
         )
 {
     len_t i, k;
 
-    ht_t *bht = bs->ht;
+    const ht_t * const bht  = bs->ht;
+    const len_t evl = bht->evl;
+    const bl_t lml  = bs->lml;
+
+    dvi_t *dvi  = (dvi_t *)malloc(sizeof(dvi_t));
+    dvi->nw     = lml / 64 + ((lml % 64) != 0);
+    dvi->evl    = evl;
+    dvi->lml    = lml;
+    dvi->z      = (uint64_t *)calloc(
+            (unsigned long)evl * dvi->nw, sizeof(uint64_t));
+
+    for (i = 0; i < lml; ++i) {
+        const exp_t * const f = bht->ev[bs->hm[bs->lmps[i]][OFFSET]];
+        for (k = 0; k < evl; ++k) {
+            if (f[k] == 0) {
+                dvi->z[k*dvi->nw + i/64] |= (uint64_t)1 << (i % 64);
+            }
+        }
+    }
+    return dvi;
+}
 
-    const len_t rr  = *nr;
+static void free_divisibility_index(
+        dvi_t **dvip
+        )
+{
+    dvi_t *dvi  = *dvip;
+    if (dvi == NULL) {
+        return;
+    }
+    free(dvi->z);
+    free(dvi);
+    *dvip = NULL;
+}
+
+/* A lead monomial can only divide m if all entries of its exponent vector
+ * vanish where the ones of m vanish. Thus only the positions in the
+ * intersection of the corresponding bit arrays are checked, in increasing
+ * order, so that the result is the same as for the plain scan. */
+static inline len_t find_reducer_position_in_index(
+        const bs_t * const bs,
+        const hm_t m,
+        const ht_t * const sht,
+        const dvi_t * const dvi,
+        exp_t *etmp
+        )
+{
+    len_t i, k, nz, w;
+
+    const ht_t * const bht = bs->ht;
+
+    const len_t evl = bht->evl;
+    const len_t nw  = dvi->nw;
+
+    const exp_t * const e  = sht->ev[m];
+
+    const bl_t lml    = dvi->lml;
+    const sdm_t ns    = ~sht->hd[m].sdm;
+
+    const sdm_t * const lms = bs->lm;
+    const bl_t * const lmps = bs->lmps;
+
+    exp_t * const * const evb = bht->ev;
+
+    const uint64_t *zs[evl];
+
+    nz  = 0;
+    for (k = 0; k < evl; ++k) {
+        if (e[k] == 0) {
+            zs[nz++]  = dvi->z + k*nw;
+        }
+    }
+
+    for (w = 0; w < nw; ++w) {
+        uint64_t c  = (w < nw-1 || lml % 64 == 0) ?
+            ~(uint64_t)0 : ((uint64_t)1 << (lml % 64)) - 1;
+        for (k = 0; k < nz && c != 0; ++k) {
+            c &=  zs[k][w];
+        }
+        while (c != 0) {
+            i = w * 64 + (len_t)__builtin_ctzll(c);
+            c &=  c - 1;
+            if (lms[i] & ns) {
+                continue;
+            }
+            const exp_t * const f = evb[bs->hm[lmps[i]][OFFSET]];
+            if (divide_exponent_vectors(etmp, e, f, evl)) {
+                return i;
+            }
+        }
+    }
+    return lml;
+}
+
+/* returns the position i in bs->lm of the first lead monomial dividing the
+ * monomial m of the secondary hash table, bs->lml if there is none. the
+ * corresponding multiplier is stored in etmp. does not modify any data, so
+ * it can be called concurrently. if dvi is not NULL the divisibility index
+ * is used for the search. */
+static inline len_t find_reducer_position(
+        const bs_t * const bs,
+        const hm_t m,
+        const ht_t * const sht,
+        const dvi_t * const dvi,
+        exp_t *etmp
+        )
+{
+    len_t i;
+
+    if (dvi != NULL) {
+        return find_reducer_position_in_index(bs, m, sht, dvi, etmp);
+    }
+
+    const ht_t * const bht = bs->ht;
 
     const len_t evl = bht->evl;
 
     const exp_t * const e  = sht->ev[m];
 
-    const hd_t hdm    = sht->hd[m];
     const len_t lml   = bs->lml;
-    const sdm_t ns    = ~hdm.sdm;
+    const sdm_t ns    = ~sht->hd[m].sdm;
 
     const sdm_t * const lms = bs->lm;
     const bl_t * const lmps = bs->lmps;
 
-    exp_t etmp[bht->evl];
-    const hd_t * const hdb  = bht->hd;
     exp_t * const * const evb = bht->ev;
 
     i = 0;
@@ -526,16 +643,38 @@ start:
     if (i < lml) {
         const hm_t *b = bs->hm[lmps[i]];
         const exp_t * const f = evb[b[OFFSET]];
-        for (k=0; k < evl; ++k) {
-            if (e[k] < f[k]) {
-                i++;
-                goto start;
-            }
-            etmp[k] = (exp_t)(e[k]-f[k]);
+        if (!divide_exponent_vectors(etmp, e, f, evl)) {
+            i++;
+            goto start;
         }
+    }
+    return i;
+}
+
+static inline void find_multiplied_reducer(
+        bs_t *bs,
+        const hm_t m,
+        len_t *nr,
+        hm_t **rows,
+        ra_t *ra,
+        ht_t *sht,
+        const dvi_t * const dvi,
+        const md_t * const md
+        )
+{
+    ht_t *bht = bs->ht;
+
+    const len_t rr  = *nr;
+
+    exp_t etmp[bht->evl];
+
+    const len_t i = find_reducer_position(bs, m, sht, dvi, etmp);
 
-        const hi_t h  = hdm.val - hdb[b[OFFSET]].val;
-        rows[rr]  = multiplied_poly_to_matrix_row(sht, bht, h, etmp, b);
+    if (i < bs->lml) {
+        const bl_t * const lmps = bs->lmps;
+        const hm_t *b = bs->hm[lmps[i]];
+        const hi_t h  = sht->hd[m].val - bht->hd[b[OFFSET]].val;
+        rows[rr]  = multiplied_poly_to_matrix_row(ra, sht, bht, h, etmp, b);
         /* track trace information ? */
         if (md->trace_level == LEARN_TRACER) {
             rows[rr][BINDEX]  = lmps[i];
@@ -553,6 +692,108 @@ start:
     }
 }
 
+/* Parallel version of the reducer search in symbolic preprocessing.
+ * The monomials of the secondary hash table are handled in waves: for
+ * all monomials of the current frontier the reducers are searched and
+ * the terms of the multiplied reducers are looked up in the secondary
+ * hash table concurrently, nothing is inserted at this stage. Afterwards
+ * the rows are completed sequentially in the order of the monomials,
+ * i.e. missing terms are inserted. New monomials are thus added in exactly
+ * the same order as in the sequential version, the next wave starts with
+ * them. Only the lookups and the divisibility checks are done in parallel,
+ * but those are the dominant part for large matrices. */
+static void find_multiplied_reducers_in_parallel(
+        mat_t *mat,
+        bs_t *bs,
+        len_t *nr,
+        const hl_t oesld,
+        const dvi_t * const dvi,
+        md_t *md
+        )
+{
+    hl_t i, j;
+    len_t k, l;
+
+    len_t nrr = *nr;
+
+    ht_t *sht = md->ht;
+    ht_t *bht = bs->ht;
+
+    const len_t evl = bht->evl;
+    const len_t lml = bs->lml;
+    const bl_t * const lmps = bs->lmps;
+    /* bounds the memory used for the frontier */
+    const hl_t wsz  = (hl_t)1 << 16;
+    /* marks monomials which do not need a reducer */
+    const len_t done = (len_t)-1;
+
+    len_t *red    = (len_t *)malloc((unsigned long)wsz * sizeof(len_t));
+    hm_t **wrows  = (hm_t **)malloc((unsigned long)wsz * sizeof(hm_t *));
+    exp_t etmp[evl];
+
+    i = 1;
+    while (i < sht->eld) {
+        const hl_t lo = i;
+        const hl_t hi = sht->eld - lo > wsz ? lo + wsz : sht->eld;
+#pragma omp parallel for num_threads(md->nthrds) \
+        private(j, k) schedule(dynamic, 32)
+        for (j = lo; j < hi; ++j) {
+            wrows[j-lo] = NULL;
+            if (j < oesld && sht->hd[j].idx) {
+                red[j-lo] = done;
+                continue;
+            }
+            exp_t e[evl];
+            k = find_reducer_position(bs, j, sht, dvi, e);
+            red[j-lo] = k;
+            if (k < lml) {
+                const hm_t *b = bs->hm[lmps[k]];
+                const val_t h = sht->hd[j].val - bht->hd[b[OFFSET]].val;
+                wrows[j-lo]   = lookup_multiplied_poly_in_hash_table(
+                        mat->ra, sht, bht, h, e, b);
+            }
+        }
+        for (j = lo; j < hi; ++j) {
+            k = red[j-lo];
+            if (k == done) {
+                continue;
+            }
+            if (mat->sz == nrr) {
+                mat->sz *=  2;
+                mat->rr  =  realloc(mat->rr,
+                        (unsigned long)mat->sz * sizeof(hm_t *));
+            }
+            sht->hd[j].idx = 1;
+            mat->nc++;
+            if (k < lml) {
+                hm_t *row = wrows[j-lo];
+                const hm_t *b = bs->hm[lmps[k]];
+                const exp_t * const e = sht->ev[j];
+                const exp_t * const f = bht->ev[b[OFFSET]];
+                for (l = 0; l < evl; ++l) {
+                    etmp[l] = (exp_t)(e[l]-f[l]);
+                }
+                insert_missing_multiplied_poly_in_hash_table(
+                        row, etmp, b, bht, sht);
+                if (md->trace_level == LEARN_TRACER) {
+                    row[BINDEX] = lmps[k];
+                    if (bht->eld == bht->esz-1) {
+                        enlarge_hash_table(bht);
+                    }
+                    row[MULT]   = insert_in_hash_table(etmp, bht);
+                }
+                sht->hd[j].idx  = 2;
+                mat->rr[nrr++]  = row;
+            }
+        }
+        i = hi;
+    }
+    free(red);
+    free(wrows);
+
+    *nr = nrr;
+}
+
 static void symbolic_preprocessing(
         mat_t *mat,
         bs_t *bs,
@@ -587,11 +828,21 @@ static void symbolic_preprocessing(
         mat->sz *=  2;
         mat->rr =   realloc(mat->rr, (unsigned long)mat->sz * sizeof(hm_t *));
     }
+    /* the lead monomials do not change during symbolic preprocessing,
+     * for larger bases we index them for faster reducer searches */
+    dvi_t *dvi  = NULL;
+    if (bs->lml >= DVI_MIN_LML) {
+        dvi = initialize_divisibility_index(bs);
+    }
+    if (md->nthrds > 1) {
+        find_multiplied_reducers_in_parallel(mat, bs, &nrr, oesld, dvi, md);
+        i = sht->eld;
+    }
     for (; i < oesld; ++i) {
         if (!sht->hd[i].idx) {
             sht->hd[i].idx = 1;
             mat->nc++;
-            find_multiplied_reducer(bs, i, &nrr, mat->rr, sht, md);
+            find_multiplied_reducer(bs, i, &nrr, mat->rr, mat->ra, sht, dvi, md);
         }
     }
     for (; i < sht->eld; ++i) {
@@ -601,8 +852,9 @@ static void symbolic_preprocessing(
         }
         sht->hd[i].idx = 1;
         mat->nc++;
-        find_multiplied_reducer(bs, i, &nrr, mat->rr, sht, md);
+        find_multiplied_reducer(bs, i, &nrr, mat->rr, mat->ra, sht, dvi, md);
     }
+    free_divisibility_index(&dvi);
     /* realloc to real size */
     mat->rr   =   realloc(mat->rr, (unsigned long)nrr * sizeof(hm_t *));
     mat->nr   +=  nrr - onrr;
@@ -667,7 +919,7 @@ static void generate_matrix_from_trace(
         h     = bht->hd[td.rri[i++]].val;
 
 
-        rrows[nr] = multiplied_poly_to_matrix_row(sht, bht, h, emul, b);
+        rrows[nr] = multiplied_poly_to_matrix_row(mat->ra, sht, bht, h, emul, b);
         sht->hd[rrows[nr][OFFSET]].idx = 2;
         ++nr;
 
@@ -679,7 +931,7 @@ static void generate_matrix_from_trace(
         b     = bs->hm[td.tri[i++]];
         emul  = bht->ev[td.tri[i]];
         h     = bht->hd[td.tri[i]].val;
-        trows[nr] = multiplied_poly_to_matrix_row(sht, bht, h, emul, b);
+        trows[nr] = multiplied_poly_to_matrix_row(mat->ra, sht, bht, h, emul, b);
         /* At the moment rba is unused */
         rba[nr]   = td.rba[i/2];
         i++;
@@ -702,6 +954,307 @@ static void generate_matrix_from_trace(
     print_current_trace_meta_data(md);
 }
 
+/* The symbolic part of a tracer application, i.e. the matrix rows given by
+ * column indices, only depends on the supports of the basis elements. The
+ * first run applying a tracer stores it for each round, all other runs
+ * reuse it as long as the supports of their basis elements agree, they
+ * then only copy the rows and do the linear algebra on their coefficients. */
+
+/* at most 4 GB of symbolic data are stored */
+#define SD_MAX_ENTRIES ((size_t)1 << 30)
+
+static void record_symbolic_supports(
+        trace_t *tr,
+        const bs_t * const bs,
+        const len_t from,
+        const len_t to
+        )
+{
+    len_t i, j;
+
+    for (i = from; i < to && i < tr->bsz; ++i) {
+        const hm_t * const b  = bs->hm[i];
+        const len_t len       = b[LENGTH]+OFFSET;
+        /* hashes above sdeld may differ between the runs */
+        for (j = OFFSET; j < len; ++j) {
+            if (b[j] >= tr->sdeld) {
+                break;
+            }
+        }
+        if (j == len) {
+            tr->bsup[i] = (hm_t *)malloc((unsigned long)len * sizeof(hm_t));
+            memcpy(tr->bsup[i], b, (unsigned long)len * sizeof(hm_t));
+        }
+    }
+}
+
+/* called when a run starts applying the tracer, the first run for a tracer
+ * generates the symbolic data */
+static void initialize_symbolic_data(
+        md_t *md,
+        const bs_t * const bs,
+        const bs_t * const gbs
+        )
+{
+    len_t i;
+    trace_t *tr = md->tr;
+
+    md->sdg = md->sdu = 0;
+    md->sdv = NULL;
+    if (md->trace_level != APPLY_TRACER || tr == NULL) {
+        return;
+    }
+#pragma omp critical (symbolic_data)
+    {
+        if (tr->sds == NULL) {
+            tr->sds   = (int32_t *)calloc((unsigned long)tr->ltd, sizeof(int32_t));
+            tr->sd    = (sd_t *)calloc((unsigned long)tr->ltd, sizeof(sd_t));
+            tr->bsz   = md->ngens;
+            for (i = 0; i < tr->ltd; ++i) {
+                tr->bsz +=  tr->td[i].nlm;
+            }
+            tr->bsup  = (hm_t **)calloc((unsigned long)tr->bsz, sizeof(hm_t *));
+            tr->sdht  = gbs->ht;
+            tr->sdeld = gbs->ht->eld;
+            md->sdg   = 1;
+        }
+    }
+    if (md->sdg == 1) {
+        record_symbolic_supports(tr, bs, 0, md->ngens);
+    } else {
+        /* hash indices have to agree with the ones of the generating run */
+        if (gbs->ht == tr->sdht && bs->ht->eld == tr->sdeld) {
+            md->sdv = (int8_t *)calloc((unsigned long)tr->bsz, sizeof(int8_t));
+        }
+    }
+}
+
+static void free_symbolic_data(
+        trace_t *tr
+        )
+{
+    len_t i;
+
+    if (tr->sd != NULL) {
+        for (i = 0; i < tr->ltd; ++i) {
+            sd_t *sd  = tr->sd + i;
+            free(sd->rows);
+            free(sd->rr);
+            free(sd->tr);
+            if (sd->ht != NULL) {
+                free(sd->ht->ev[0]);
+                free(sd->ht->ev);
+                free(sd->ht->hd);
+                free(sd->ht);
+            }
+        }
+    }
+    if (tr->bsup != NULL) {
+        for (i = 0; i < tr->bsz; ++i) {
+            free(tr->bsup[i]);
+        }
+    }
+    free(tr->sd);
+    free(tr->sds);
+    free(tr->bsup);
+    tr->sd    = NULL;
+    tr->sds   = NULL;
+    tr->bsup  = NULL;
+}
+
+/* stores the rows of mat, their hashes are already converted to columns,
+ * returns 1 if they are stored */
+static int store_symbolic_data(
+        const mat_t * const mat,
+        md_t *md,
+        const ht_t * const sht
+        )
+{
+    len_t i;
+    size_t nt = 0;
+
+    if (md->sdg != 1 || mat->nr == 0) {
+        return 0;
+    }
+    trace_t *tr = md->tr;
+
+    for (i = 0; i < mat->nru; ++i) {
+        nt  +=  mat->rr[i][LENGTH]+OFFSET;
+    }
+    for (i = 0; i < mat->nrl; ++i) {
+        nt  +=  mat->tr[i][LENGTH]+OFFSET;
+    }
+    if (tr->sdnt + nt > SD_MAX_ENTRIES) {
+        return 0;
+    }
+    tr->sdnt  +=  nt;
+
+    sd_t *sd  = tr->sd + md->trace_rd;
+    sd->nru   = mat->nru;
+    sd->nrl   = mat->nrl;
+    sd->ncl   = mat->ncl;
+    sd->ncr   = mat->ncr;
+    sd->rows  = (hm_t *)malloc(nt * sizeof(hm_t));
+    sd->rr    = (hm_t **)malloc((unsigned long)mat->nru * sizeof(hm_t *));
+    sd->tr    = (hm_t **)malloc((unsigned long)mat->nrl * sizeof(hm_t *));
+
+    hm_t *row = sd->rows;
+    for (i = 0; i < mat->nru; ++i) {
+        const len_t len = mat->rr[i][LENGTH]+OFFSET;
+        memcpy(row, mat->rr[i], (unsigned long)len * sizeof(hm_t));
+        sd->rr[i] = row;
+        row       +=  len;
+    }
+    for (i = 0; i < mat->nrl; ++i) {
+        const len_t len = mat->tr[i][LENGTH]+OFFSET;
+        memcpy(row, mat->tr[i], (unsigned long)len * sizeof(hm_t));
+        sd->tr[i] = row;
+        row       +=  len;
+    }
+
+    /* columns needed when new rows become basis elements */
+    const len_t evl   = sht->evl;
+    const hi_t *hcm   = md->hcm;
+    ht_t *ht  = (ht_t *)calloc(1, sizeof(ht_t));
+    ht->nv    = sht->nv;
+    ht->evl   = sht->evl;
+    ht->ebl   = sht->ebl;
+    ht->eld   = ht->esz = mat->ncr+1;
+    ht->hd    = (hd_t *)calloc((unsigned long)ht->esz, sizeof(hd_t));
+    ht->ev    = (exp_t **)malloc((unsigned long)ht->esz * sizeof(exp_t *));
+    ht->ev[0] = (exp_t *)malloc((unsigned long)ht->esz * evl * sizeof(exp_t));
+    for (i = 0; i < ht->esz; ++i) {
+        const hi_t h  = i == 0 ? hcm[0] : hcm[mat->ncl+i-1];
+        ht->ev[i]     = ht->ev[0] + (unsigned long)i * evl;
+        memcpy(ht->ev[i], sht->ev[h], (unsigned long)evl * sizeof(exp_t));
+        ht->hd[i]     = sht->hd[h];
+    }
+    sd->ht  = ht;
+
+    const int64_t nterms  = (int64_t)(nt - (size_t)mat->nr * OFFSET);
+    sd->density = (double)nterms * 100 / (double)mat->nr / (double)mat->nc;
+
+    /* all basis elements used in this round are recorded already */
+    __atomic_store_n(tr->sds + md->trace_rd, 1, __ATOMIC_RELEASE);
+
+    return 1;
+}
+
+static inline int symbolic_support_agrees(
+        const trace_t * const tr,
+        const bs_t * const bs,
+        md_t *md,
+        const len_t bi
+        )
+{
+    if (md->sdv[bi] == 0) {
+        const hm_t * const s  = tr->bsup[bi];
+        const hm_t * const b  = bs->hm[bi];
+        md->sdv[bi] = (s != NULL
+                && s[LENGTH] == b[LENGTH]
+                && s[PRELOOP] == b[PRELOOP]
+                && s[COEFFS] == b[COEFFS]
+                && memcmp(s+OFFSET, b+OFFSET,
+                    (unsigned long)b[LENGTH] * sizeof(hm_t)) == 0) ? 1 : 2;
+    }
+    return md->sdv[bi] == 1;
+}
+
+/* generates the matrix of the current round from the shared symbolic data,
+ * returns 0 if it is not available or does not fit the basis */
+static int generate_matrix_from_symbolic_data(
+        mat_t *mat,
+        const bs_t * const bs,
+        md_t *md
+        )
+{
+    len_t i;
+
+    const len_t idx     = md->trace_rd;
+    const trace_t *tr   = md->tr;
+
+    md->sdu = 0;
+    if (md->sdv == NULL
+            || __atomic_load_n(tr->sds + idx, __ATOMIC_ACQUIRE) == 0) {
+        return 0;
+    }
+    const td_t td = tr->td[idx];
+    for (i = 0; i < td.rld; i += 2) {
+        if (!symbolic_support_agrees(tr, bs, md, td.rri[i])) {
+            return 0;
+        }
+    }
+    for (i = 0; i < td.tld; i += 2) {
+        if (!symbolic_support_agrees(tr, bs, md, td.tri[i])) {
+            return 0;
+        }
+    }
+
+    /* timings */
+    double ct, rt;
+    ct = cputime();
+    rt = realtime();
+
+    const sd_t *sd  = tr->sd + idx;
+
+    mat->rr   = (hm_t **)malloc((unsigned long)sd->nru * sizeof(hm_t *));
+    mat->tr   = (hm_t **)malloc((unsigned long)sd->nrl * sizeof(hm_t *));
+    mat->rba  = (rba_t **)malloc((unsigned long)sd->nrl * sizeof(rba_t *));
+
+#pragma omp parallel num_threads(md->nthrds) private(i)
+    {
+#pragma omp for schedule(dynamic, 64) nowait
+        for (i = 0; i < sd->nru; ++i) {
+            const len_t len = sd->rr[i][LENGTH];
+            mat->rr[i]  = allocate_matrix_row(mat->ra, len);
+            memcpy(mat->rr[i], sd->rr[i],
+                    (unsigned long)(len+OFFSET) * sizeof(hm_t));
+        }
+#pragma omp for schedule(dynamic, 64)
+        for (i = 0; i < sd->nrl; ++i) {
+            const len_t len = sd->tr[i][LENGTH];
+            mat->tr[i]  = allocate_matrix_row(mat->ra, len);
+            memcpy(mat->tr[i], sd->tr[i],
+                    (unsigned long)(len+OFFSET) * sizeof(hm_t));
+            mat->rba[i] = td.rba[i];
+        }
+    }
+    mat->nru  = sd->nru;
+    mat->nrl  = sd->nrl;
+    mat->nr   = mat->sz = mat->nru + mat->nrl;
+    mat->ncl  = sd->ncl;
+    mat->ncr  = sd->ncr;
+    mat->nc   = mat->ncl + mat->ncr;
+
+    /* columns map to the entries of the shared column table */
+    hi_t *hcm = realloc(md->hcm, (unsigned long)(mat->nc+1) * sizeof(hi_t));
+    hcm[0]    = 0;
+    for (i = mat->ncl; i < mat->nc; ++i) {
+        hcm[i]  = i - mat->ncl + 1;
+    }
+    md->hcm = hcm;
+    md->sdu = 1;
+
+    md->num_rowsred +=  mat->nrl;
+
+    /* timings */
+    md->tracer_ctime += cputime() - ct;
+    md->tracer_rtime += realtime() - rt;
+
+    print_current_trace_meta_data(md);
+    if (md->info_level > 1) {
+        printf(" %7d x %-7d %8.2f%%", mat->nr, mat->nc, sd->density);
+        fflush(stdout);
+    }
+    if ((int64_t)mat->nr * mat->nc > md->mat_max_nrows * md->mat_max_ncols) {
+        md->mat_max_nrows   = mat->nr;
+        md->mat_max_ncols   = mat->nc;
+        md->mat_max_density = sd->density;
+    }
+
+    return 1;
+}
+
 static void generate_saturation_reducer_rows_from_trace(
         mat_t *mat,
         const trace_t * const trace,
@@ -734,7 +1287,7 @@ static void generate_saturation_reducer_rows_from_trace(
         emul  = bht->ev[ts.rri[i]];
         h     = bht->hd[ts.rri[i++]].val;
 
-        rrows[nr] = multiplied_poly_to_matrix_row(sht, bht, h, emul, b);
+        rrows[nr] = multiplied_poly_to_matrix_row(mat->ra, sht, bht, h, emul, b);
         sht->hd[rrows[nr][OFFSET]].idx = 2;
         ++nr;
 
@@ -767,7 +1320,9 @@ static int preprocessing(
         }
         symbolic_preprocessing(mat, bs, md);
     } else {
-        generate_matrix_from_trace(mat, bs, md);
+        if (!generate_matrix_from_symbolic_data(mat, bs, md)) {
+            generate_matrix_from_trace(mat, bs, md);
+        }
     }
     return 0;
 }
@@ -240,3 +240,77 @@ static void add_minimal_lmh_to_trace(
  * #endif
  *     return prev;
  * } */
+
+/* Splits the rows of an interreduction into waves which can be reduced
+ * in parallel while giving the same result as reducing them one after
+ * the other, smallest lead term first. A fully reduced row has no pivot
+ * column in its tail, so the pivots a row meets during its reduction
+ * are the ones reachable from its support via rows which are not reduced
+ * in this step. Each row is put into the first wave after all reduced
+ * rows reachable this way. pivs holds the known pivots at their lead
+ * columns, rows are the nr rows to be reduced, they may be stored in pivs
+ * as well. On return wo[w] is the start of wave w in the returned array
+ * of row indices, wo[nw] = nr. */
+static len_t *compute_reduction_waves(
+        len_t *nwp,
+        len_t **wop,
+        hm_t * const *pivs,
+        const len_t ncols,
+        hm_t * const *rows,
+        const len_t nr
+        )
+{
+    len_t i, j;
+    int64_t c;
+
+    int8_t *red   = (int8_t *)calloc((unsigned long)ncols, sizeof(int8_t));
+    int32_t *lvl  = (int32_t *)malloc((unsigned long)ncols * sizeof(int32_t));
+    hm_t **cr     = (hm_t **)malloc((unsigned long)ncols * sizeof(hm_t *));
+    memcpy(cr, pivs, (unsigned long)ncols * sizeof(hm_t *));
+    for (i = 0; i < nr; ++i) {
+        cr[rows[i][OFFSET]]   = rows[i];
+        red[rows[i][OFFSET]]  = 1;
+    }
+    /* all tail columns of a row are right of its lead column */
+    int32_t nw  = 0;
+    for (c = (int64_t)ncols-1; c >= 0; --c) {
+        if (cr[c] == NULL) {
+            lvl[c]  = -1;
+            continue;
+        }
+        const len_t len = cr[c][LENGTH];
+        const hm_t * const ds = cr[c] + OFFSET;
+        int32_t m = -1;
+        for (j = 1; j < len; ++j) {
+            m = lvl[ds[j]] > m ? lvl[ds[j]] : m;
+        }
+        if (red[c] == 1) {
+            lvl[c]  = m + 1;
+            nw  = lvl[c] >= nw ? lvl[c] + 1 : nw;
+        } else {
+            lvl[c]  = m;
+        }
+    }
+    len_t *wo = (len_t *)calloc((unsigned long)nw + 1, sizeof(len_t));
+    len_t *wr = (len_t *)malloc((unsigned long)nr * sizeof(len_t));
+    for (i = 0; i < nr; ++i) {
+        wo[lvl[rows[i][OFFSET]] + 1]++;
+    }
+    for (i = 1; i <= (len_t)nw; ++i) {
+        wo[i] +=  wo[i-1];
+    }
+    /* rows keep their relative order inside a wave */
+    len_t *pos  = (len_t *)malloc((unsigned long)(nw + 1) * sizeof(len_t));
+    memcpy(pos, wo, (unsigned long)(nw + 1) * sizeof(len_t));
+    for (i = 0; i < nr; ++i) {
+        wr[pos[lvl[rows[i][OFFSET]]]++] = i;
+    }
+    free(pos);
+    free(cr);
+    free(lvl);
+    free(red);
+
+    *nwp  = (len_t)nw;
+    *wop  = wo;
+    return wr;
+}
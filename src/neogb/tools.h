@@ -121,4 +121,57 @@ static inline uint32_t mod_p_inverse_32(
 
     return d;
 }
+
+/* p < 2^63, so that all intermediate values fit into an int64_t */
+static inline uint64_t mod_p_inverse_64(
+        const uint64_t val,
+        const uint64_t p
+        )
+{
+    int64_t a, b, c, d, e, f;
+    a =   (int64_t)p;
+    b =   (int64_t)(val % p);
+    c =   1;
+    d =   0;
+
+    while (b != 0) {
+        f = b;
+        e = a/f;
+        b = a - e*f;
+        a = f;
+        f = c;
+        c = d - e*f;
+        d = f;
+    }
+
+    /* if d < 0 we shift correspondingly */
+    d +=  (d >> 63) & (int64_t)p;
+
+    return (uint64_t)d;
+}
+
+/* Shoup's precomputation for multiplying by a fixed w < p: floor(w*2^64/p) */
+static inline uint64_t shoup_precomp_64(
+        const uint64_t w,
+        const uint64_t p
+        )
+{
+    return (uint64_t)(((unsigned __int128)w << 64) / p);
+}
+
+/* a*w mod p for p < 2^63, ws = shoup_precomp_64(w, p), a < 2^64: the
+ * quotient estimate is at most one too small, so one correction step
+ * is enough */
+static inline uint64_t mod_p_mul_shoup_64(
+        const uint64_t a,
+        const uint64_t w,
+        const uint64_t ws,
+        const uint64_t p
+        )
+{
+    const uint64_t q  = (uint64_t)(((unsigned __int128)a * ws) >> 64);
+    const uint64_t r  = a * w - q * p;
+
+    return r >= p ? r - p : r;
+}
 #endif
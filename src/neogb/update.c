@@ -120,7 +120,8 @@ static void insert_and_update_spairs(
 
     len_t nl  = pl+bl;
     /* Gebauer-Moeller: check old pairs first */
-    /* note: old pairs are sorted by the given spair order */
+    /* note: old pairs are not sorted, only the ones of minimal degree
+     * are sorted when selecting pairs for the next matrix */
 #pragma omp parallel for num_threads(nthrds) \
     private(i, j,  l)
     for (i = 0; i < pl; ++i) {
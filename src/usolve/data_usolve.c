@@ -19,6 +19,15 @@
  * Mohab Safey El Din */
 
 
+/* subtree of the bisection tree which is isolated by a single thread */
+typedef struct{
+  mpz_t *upol; /* polynomial at the root of the subtree */
+  unsigned long int deg;
+  mpz_t c; /* the subtree investigates (c / 2^k, (c+1) / 2^k) */
+  long k;
+  unsigned long int pos; /* number of roots found left of the subtree */
+} bisection_task;
+
 typedef struct{
   int search;/*when >0 (resp. <0, =0) computes positive (resp. negative, all) roots */
   long int bound_pos; /*log2(M) where M dominates the largest positive root*/
@@ -46,6 +55,13 @@ typedef struct{
   mpz_t **pols_threads;
   mpz_t *Values;
 
+  /* used for task-parallel bisection: subtrees at depth task_depth are
+   * collected in tasks and isolated in parallel, 0 if sequential */
+  long int task_depth;
+  bisection_task *tasks;
+  unsigned long int ntasks;
+  unsigned long int tasks_alloc;
+
   float time_desc;
   float time_shift;
 
@@ -53,6 +69,9 @@ typedef struct{
   unsigned int verbose;
   unsigned int bfile;
   unsigned int classical_algo;
+  /* Taylor shifts by 1 are computed modulo word-size primes when set to 2,
+     with big integers when set to 0, 1 chooses by degree and bit size */
+  unsigned int multimod_shift;
 
   unsigned int print_stats;
   int debug;
@@ -78,8 +78,7 @@ static unsigned long int descartes(mpz_t *upol1, mpz_t *upol2,
     mpz_set(upol2[i], upol1[deg-i]);
   }
 
-  taylorshift1_dac(upol2, deg, flags->tmpol,
-                   flags->shift_pwx, flags->pwx, flags->nthreads);
+  taylorshift1(upol2, deg, flags);
   nb = mpz_poly_sgn_variations_coeffs(upol2, deg);
 
   return nb;
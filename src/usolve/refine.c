@@ -874,6 +874,232 @@ void refine_QIR_roots(mpz_t *upol, unsigned long int *deg, interval *roots,
   free(tab);
 }
 
+/* refines the negative root rt of upol(x), upol being given as upol(-x) */
+/* pos_rt and newc are scratch space, tab is as in refine_QIR_positive_root */
+static void refine_QIR_negative_root_adaptative(mpz_t *upol, unsigned long int *deg,
+                                                interval *rt, interval *pos_rt,
+                                                mpz_t newc, mpz_t *tab,
+                                                int prec, int verbose){
+  if(rt->k > 0){
+    if(rt->isexact!=1){
+      mpz_add_ui(pos_rt->numer, rt->numer, 1);
+      mpz_neg(pos_rt->numer, pos_rt->numer);
+    }
+    pos_rt->k = rt->k;
+    pos_rt->sign_left = - (rt->sign_left);
+    pos_rt->isexact = rt->isexact;
+  }
+  else {
+    if(rt->isexact!=1){
+      mpz_set_ui(newc, 1);
+      mpz_mul_2exp(newc, newc, -rt->k);
+      mpz_add(pos_rt->numer, rt->numer, newc);
+      mpz_neg(pos_rt->numer, pos_rt->numer);
+    }
+    pos_rt->k = rt->k;
+    pos_rt->sign_left = - (rt->sign_left);
+    pos_rt->isexact = rt->isexact;
+  }
+
+  if(pos_rt->isexact==0){
+    get_values_at_bounds(upol, *deg, pos_rt, tab);
+    if(mpz_sgn(tab[0])==0 || mpz_sgn(tab[1])==0){
+      fprintf(stderr, "Error in refinement (neg. roots): these values should not be zero\n");
+      exit(1);
+    }
+    long d = 1 + ilog2_mpz(pos_rt->numer) - rt->k;
+
+    /* fprintf(stderr, "[%d, %ld]", prec, */
+    /*         prec + ((*deg) * MAX(0, d)) / 32); */
+    refine_QIR_positive_root(upol, deg, pos_rt, tab,
+                             prec + (((*deg)-1) * MAX(0, d)) / 32, verbose);
+
+    if(mpz_sgn(tab[0])==mpz_sgn(tab[1])){
+      fprintf(stderr, "BUG in refinement (sgn tab[0]==sgn tab[1]) for neg. roots");
+      exit(1);
+    }
+  }
+
+  if(pos_rt->isexact==1){
+    if(pos_rt->k < 0){
+      pos_rt->k = 0;
+    }
+  }
+  //We assume precision >=0
+  if(pos_rt->isexact!=1){
+    rt->k = pos_rt->k;
+    rt->isexact = pos_rt->isexact;
+    mpz_add_ui(rt->numer, pos_rt->numer, 1);
+    mpz_neg(rt->numer, rt->numer);
+  }
+  else{
+    rt->k = pos_rt->k;
+    if(rt->isexact!=1){
+      rt->isexact = pos_rt->isexact;
+      mpz_set(rt->numer, pos_rt->numer);
+      mpz_neg(rt->numer, rt->numer);
+    }
+  }
+}
+
+static void refine_QIR_positive_root_adaptative(mpz_t *upol, unsigned long int *deg,
+                                                interval *rt, mpz_t *tab,
+                                                int prec, int verbose){
+  if(rt->isexact==0){
+    get_values_at_bounds(upol, *deg, rt, tab);
+    if(mpz_sgn(tab[1])==0 || mpz_sgn(tab[0])==0){
+      fprintf(stderr, "Error in refinement (pos. roots): these values should not be zero\n");
+      exit(1);
+    }
+    long d = 1 + ilog2_mpz(rt->numer) - rt->k;
+
+    /* fprintf(stderr, "[%d, %ld]", prec, prec + ((*deg) * MAX(0, 1 + d)) / 32); */
+    refine_QIR_positive_root(upol, deg, rt, tab,
+                             prec + (((*deg) - 1) * MAX(0, 1 + d)) / 32, verbose);
+    if(mpz_sgn(tab[0])==mpz_sgn(tab[1])){
+      fprintf(stderr,"BUG in refinement (sgn tab[0]=sgn tab[1] for pos. roots)");
+      exit(1);
+    }
+    if(rt->isexact==1){
+      if(rt->k < 0){
+        rt->k = 0;
+      }
+    }
+  }
+}
+
+/* refines roots[lo], ..., roots[hi-1] in parallel, they are negative roots
+   if neg = 1 (and upol is then given as upol(-x)), positive ones otherwise.
+
+   Refinement divides upol by the roots which are found to be exact, this
+   changes the values seen by the next roots. To get the same intervals as
+   the sequential loop, each thread refines on its own copy of upol and, when
+   a root becomes exact, the roots after it are refined again with the
+   divided polynomial. */
+static void refine_QIR_roots_adaptative_parallel(mpz_t *upol, unsigned long int *deg,
+                                                 interval *roots,
+                                                 unsigned long int lo,
+                                                 unsigned long int hi, int neg,
+                                                 int prec, int verbose,
+                                                 int nthreads){
+  const unsigned long int n = hi - lo;
+  const unsigned long int odeg = *deg;
+  unsigned long int i;
+
+  /* intervals as given by isolation, to restart refinement */
+  interval *init = (interval *)malloc(n * sizeof(interval));
+  int *exact = (int *)calloc(n, sizeof(int));
+  for(i = 0; i < n; i++){
+    mpz_init_set(init[i].numer, roots[lo+i].numer);
+    init[i].k = roots[lo+i].k;
+    init[i].isexact = roots[lo+i].isexact;
+    init[i].sign_left = roots[lo+i].sign_left;
+  }
+
+  /* per thread copies of upol and scratch space */
+  mpz_t **tpol = (mpz_t **)malloc(nthreads * sizeof(mpz_t *));
+  unsigned long int *tdeg = (unsigned long int *)malloc(nthreads *
+                                                        sizeof(unsigned long int));
+  mpz_t **ttab = (mpz_t **)malloc(nthreads * sizeof(mpz_t *));
+  interval *tpos_rt = (interval *)malloc(nthreads * sizeof(interval));
+  mpz_t *tnewc = (mpz_t *)malloc(nthreads * sizeof(mpz_t));
+  for(int t = 0; t < nthreads; t++){
+    tpol[t] = (mpz_t *)malloc((odeg + 1) * sizeof(mpz_t));
+    for(i = 0; i <= odeg; i++){
+      mpz_init(tpol[t][i]);
+    }
+    tdeg[t] = 0;
+    ttab[t] = (mpz_t *)malloc(8 * sizeof(mpz_t));
+    for(i = 0; i < 8; i++){
+      mpz_init(ttab[t][i]);
+    }
+    mpz_init(tpos_rt[t].numer);
+    mpz_init(tnewc[t]);
+  }
+
+  /* roots are handled by batches to bound the work lost on exact roots */
+  const unsigned long int bsz = 16 * nthreads;
+  unsigned long int start = 0;
+  while(start < n){
+    const unsigned long int end = (start + bsz < n) ? start + bsz : n;
+    for(int t = 0; t < nthreads; t++){
+      tdeg[t] = 0;
+    }
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+    for(unsigned long int l = start; l < end; l++){
+      const int t = omp_get_thread_num();
+      /* the copy is stale after an exact root has been divided out */
+      if(tdeg[t] != *deg){
+        for(unsigned long int j = 0; j <= *deg; j++){
+          mpz_set(tpol[t][j], upol[j]);
+        }
+        tdeg[t] = *deg;
+      }
+      interval *rt = roots + lo + l;
+      const unsigned int isexact = rt->isexact;
+      if(neg){
+        refine_QIR_negative_root_adaptative(tpol[t], tdeg + t, rt, tpos_rt + t,
+                                            tnewc[t], ttab[t], prec, verbose);
+      }
+      else{
+        refine_QIR_positive_root_adaptative(tpol[t], tdeg + t, rt, ttab[t],
+                                            prec, verbose);
+      }
+      exact[l] = (isexact == 0 && rt->isexact == 1);
+    }
+
+    /* first root which has been found to be exact */
+    for(i = start; i < end; i++){
+      if(exact[i]){
+        break;
+      }
+    }
+    if(i >= end){
+      start = end;
+      continue;
+    }
+    interval *rt = roots + lo + i;
+    if(neg){
+      mpz_neg(tnewc[0], rt->numer);
+      USOLVEnumer_quotient(upol, deg, tnewc[0], rt->k);
+    }
+    else{
+      USOLVEnumer_quotient(upol, deg, rt->numer, rt->k);
+    }
+    start = i + 1;
+    for(i = start; i < end; i++){
+      exact[i] = 0;
+      mpz_set(roots[lo+i].numer, init[i].numer);
+      roots[lo+i].k = init[i].k;
+      roots[lo+i].isexact = init[i].isexact;
+      roots[lo+i].sign_left = init[i].sign_left;
+    }
+  }
+
+  for(int t = 0; t < nthreads; t++){
+    for(i = 0; i <= odeg; i++){
+      mpz_clear(tpol[t][i]);
+    }
+    free(tpol[t]);
+    for(i = 0; i < 8; i++){
+      mpz_clear(ttab[t][i]);
+    }
+    free(ttab[t]);
+    mpz_clear(tpos_rt[t].numer);
+    mpz_clear(tnewc[t]);
+  }
+  free(tpol);
+  free(tdeg);
+  free(ttab);
+  free(tpos_rt);
+  free(tnewc);
+  for(i = 0; i < n; i++){
+    mpz_clear(init[i].numer);
+  }
+  free(init);
+  free(exact);
+}
+
 /* Refinement using Newton-Interval like technique (but replacing Newton with */
 /* linear interpolation) */
 /* it takes as input a pointer to deg because it may change after performing */
@@ -907,79 +1133,27 @@ void refine_QIR_roots_adaptative(mpz_t *upol, unsigned long int *deg, interval *
     }
   }
 
-  for(i = 0; i < nbneg; i++){
-
-    interval *rt = roots + i;
-
-    /* display_root(stderr, rt); */
-
-    if(rt->k > 0){
-      if(rt->isexact!=1){
-        mpz_add_ui(pos_rt->numer, rt->numer, 1);
-        mpz_neg(pos_rt->numer, pos_rt->numer);
-      }
-      pos_rt->k = rt->k;
-      pos_rt->sign_left = - (rt->sign_left);
-      pos_rt->isexact = rt->isexact;
-    }
-    else {
-      if(rt->isexact!=1){
-        mpz_set_ui(newc, 1);
-        mpz_mul_2exp(newc, newc, -rt->k);
-        mpz_add(pos_rt->numer, rt->numer, newc);
-        mpz_neg(pos_rt->numer, pos_rt->numer);
-      }
-      pos_rt->k = rt->k;
-      pos_rt->sign_left = - (rt->sign_left);
-      pos_rt->isexact = rt->isexact;
-    }
-
-    if(pos_rt->isexact==0){
-      get_values_at_bounds(upol, *deg, pos_rt, tab);
-      if(mpz_sgn(tab[0])==0 || mpz_sgn(tab[1])==0){
-        fprintf(stderr, "Error in refinement (neg. roots): these values should not be zero\n");
-        exit(1);
-      }
-      long d = 1 + ilog2_mpz(pos_rt->numer) - rt->k;
+  if(nthreads > 1 && nbneg > 1){
+    refine_QIR_roots_adaptative_parallel(upol, deg, roots, 0, nbneg, 1,
+                                         prec, verbose, nthreads);
+  }
+  else{
+    for(i = 0; i < nbneg; i++){
 
-      /* fprintf(stderr, "[%d, %ld]", prec, */
-      /*         prec + ((*deg) * MAX(0, d)) / 32); */
-      refine_QIR_positive_root(upol, deg, pos_rt, tab,
-                               prec + (((*deg)-1) * MAX(0, d)) / 32, verbose);
+      interval *rt = roots + i;
 
-      if(mpz_sgn(tab[0])==mpz_sgn(tab[1])){
-        fprintf(stderr, "BUG in refinement (sgn tab[0]==sgn tab[1]) for neg. roots");
-        exit(1);
-      }
-    }
+      /* display_root(stderr, rt); */
 
-    if(pos_rt->isexact==1){
-      if(pos_rt->k < 0){
-        pos_rt->k = 0;
-      }
-    }
-    //We assume precision >=0
-    if(pos_rt->isexact!=1){
-      rt->k = pos_rt->k;
-      rt->isexact = pos_rt->isexact;
-      mpz_add_ui(rt->numer, pos_rt->numer, 1);
-      mpz_neg(rt->numer, rt->numer);
-    }
-    else{
-      rt->k = pos_rt->k;
-      if(rt->isexact!=1){
-        rt->isexact = pos_rt->isexact;
-        mpz_set(rt->numer, pos_rt->numer);
-        mpz_neg(rt->numer, rt->numer);
-      }
-    }
+      refine_QIR_negative_root_adaptative(upol, deg, rt, pos_rt, newc, tab,
+                                          prec, verbose);
 
-    e_time += realtime() - refine_time;
-    if(e_time>=step){
-      refine_time = realtime();
-      e_time = 0;
-      if(verbose>=1){
-        fprintf(stderr, "{%.2f%s}", ((double)i / nb) * 100, "%");
+      e_time += realtime() - refine_time;
+      if(e_time>=step){
+        refine_time = realtime();
+        e_time = 0;
+        if(verbose>=1){
+          fprintf(stderr, "{%.2f%s}", ((double)i / nb) * 100, "%");
+        }
       }
     }
   }
@@ -995,40 +1169,26 @@ void refine_QIR_roots_adaptative(mpz_t *upol, unsigned long int *deg, interval *
     }
   }
 
-  for(i=nbneg; i < nb; i++){
-    interval *rt = roots + i;
+  if(nthreads > 1 && nbpos > 1){
+    refine_QIR_roots_adaptative_parallel(upol, deg, roots, nbneg, nb, 0,
+                                         prec, verbose, nthreads);
+  }
+  else{
+    for(i=nbneg; i < nb; i++){
+      interval *rt = roots + i;
 
-    if(rt->isexact==0){
-      get_values_at_bounds(upol, *deg, rt, tab);
-      if(mpz_sgn(tab[1])==0 || mpz_sgn(tab[0])==0){
-        fprintf(stderr, "Error in refinement (pos. roots): these values should not be zero\n");
-        exit(1);
-      }
-      long d = 1 + ilog2_mpz(rt->numer) - rt->k;
+      refine_QIR_positive_root_adaptative(upol, deg, rt, tab, prec, verbose);
 
-      /* fprintf(stderr, "[%d, %ld]", prec, prec + ((*deg) * MAX(0, 1 + d)) / 32); */
-      refine_QIR_positive_root(upol, deg, rt, tab,
-                               prec + (((*deg) - 1) * MAX(0, 1 + d)) / 32, verbose);
-      if(mpz_sgn(tab[0])==mpz_sgn(tab[1])){
-        fprintf(stderr,"BUG in refinement (sgn tab[0]=sgn tab[1] for pos. roots)");
-        exit(1);
-      }
-      if(rt->isexact==1){
-        if(rt->k < 0){
-          rt->k = 0;
+      e_time += realtime() - refine_time;
+      if(e_time>=step){
+        refine_time = realtime();
+        e_time = 0;
+        if(verbose>=1){
+          fprintf(stderr, "{%.2f%s}", ((double)(i) / nb) * 100, "%");
         }
       }
-    }
 
-    e_time += realtime() - refine_time;
-    if(e_time>=step){
-      refine_time = realtime();
-      e_time = 0;
-      if(verbose>=1){
-        fprintf(stderr, "{%.2f%s}", ((double)(i) / nb) * 100, "%");
-      }
     }
-
   }
   if(verbose>=1){
     fprintf(stderr, "\n");
@@ -244,6 +244,85 @@ static void taylorshift1_dac(mpz_t *upol,
 }
 
 
+/* multimodular Taylor shift by 1 (in place)
+
+   upol is reduced modulo primes between 2^31 and 2^32, the shifts modulo
+   these primes are computed in parallel and the coefficients are lifted
+   back by Chinese remaindering. Since the coefficients of upol(x+1) are
+   bounded by 2^(deg+1) times those of upol, enough primes are taken to
+   recover them in the symmetric representation. */
+static void taylorshift1_multimod(mpz_t *upol,
+                                  const unsigned long int deg,
+                                  const unsigned int nthreads){
+  const unsigned long int cont = mpz_poly_remove_binary_content(upol, deg);
+  const unsigned long int nbits = mpz_poly_max_bsize_coeffs(upol, deg);
+  const uint32_t nprimes = (nbits + deg + 2 + 30) / 31;
+  const unsigned long int len = deg + 1;
+
+  mpz_t one;
+  mpz_init_set_ui(one, 1);
+  mpz_CRT_batch_t cb;
+  mpz_CRT_batch_init(cb, nprimes, one);
+  mp_limb_t p = UWORD(1) << 31;
+  for(uint32_t i = 0; i < nprimes; i++){
+    p = n_nextprime(p, 0);
+    mpz_CRT_batch_add_prime(cb, p);
+  }
+  mpz_CRT_batch_prepare(cb);
+
+  /* residues of coefficient j modulo prime i are stored at j * nprimes + i */
+  uint32_t *res = (uint32_t *)malloc(sizeof(uint32_t) * len * nprimes);
+
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+  for(unsigned long int j = 0; j < len; j++){
+    mpz_CRT_batch_reduce(res + j * nprimes, upol[j], cb);
+  }
+
+#pragma omp parallel num_threads(nthreads)
+  {
+    mp_ptr tpol = (mp_ptr)malloc(sizeof(mp_limb_t) * len);
+#pragma omp for schedule(dynamic)
+    for(uint32_t i = 0; i < nprimes; i++){
+      nmod_t mod;
+      nmod_init(&mod, cb->primes[i]);
+      for(unsigned long int j = 0; j < len; j++){
+        tpol[j] = res[j * nprimes + i];
+      }
+      _nmod_poly_taylor_shift(tpol, UWORD(1), len, mod);
+      for(unsigned long int j = 0; j < len; j++){
+        res[j * nprimes + i] = tpol[j];
+      }
+    }
+    free(tpol);
+  }
+
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+  for(unsigned long int j = 0; j < len; j++){
+    mpz_set_ui(upol[j], 0);
+    mpz_CRT_batch_lift(upol[j], res + j * nprimes, cb, 1);
+  }
+
+  rescale_upoly_2exp(upol, deg, cont);
+
+  free(res);
+  mpz_CRT_batch_clear(cb);
+  mpz_clear(one);
+}
+
+/* Taylor shift by 1 (in place), the multimodular variant is used for large
+   degrees unless the coefficients are much larger than the degree, in which
+   case reduction and Chinese remaindering dominate */
+static void taylorshift1(mpz_t *upol, const unsigned long int deg,
+                         usolve_flags *flags){
+  if(flags->multimod_shift == 2 ||
+     (flags->multimod_shift == 1 && deg >= THRESHOLDMULTIMOD &&
+      mpz_poly_max_bsize_coeffs(upol, deg) <= MULTIMODBITSRATIO * deg)){
+    taylorshift1_multimod(upol, deg, flags->nthreads);
+    return;
+  }
+  taylorshift1_dac(upol, deg, flags->tmpol,
+                   flags->shift_pwx, flags->pwx, flags->nthreads);
+}
 
 static inline void decompose_bits_poly(mpz_t **upols, mpz_t *upol,
                                        const unsigned long int deg,
@@ -35,10 +35,18 @@
 #include "flint/flint.h"
 #include "flint/fmpz.h"
 #include "flint/fmpz_poly.h"
+#include "flint/nmod_poly.h"
 
 #include "../msolve/msolve-data.h"
 
 #define THRESHOLDSHIFT 256
+/* minimal degree for multimodular Taylor shifts */
+#define THRESHOLDMULTIMOD 1024
+/* multimodular Taylor shifts are used while the bit size of the coefficients
+   is at most MULTIMODBITSRATIO times the degree */
+#define MULTIMODBITSRATIO 32
+/* minimal degree for isolating subtrees of the bisection tree in parallel */
+#define THRESHOLDTASKS 128
 #define POWER_HACK 1
 
 #define ilog2(a) mpz_sizeinbase(a,2)
@@ -53,6 +61,7 @@
 
 #include "data_usolve.c"
 #include "utils.c"
+#include "../crt/mpz_CRT_batch.c"
 #include "taylor_shift.c"
 #include "descartes.c"
 #include "evaluate.c"
@@ -669,6 +678,32 @@ static long nb_2_case_in_bisection_rec(mpz_t c, const long k,
 }
 
 
+/* stores a copy of upol, the subtree rooted at (c / 2^k, (c+1) / 2^k) is
+ * isolated later on, its roots come after the nbr roots found so far */
+static void push_bisection_task(mpz_t *upol, const unsigned long int deg,
+                                const mpz_t c, const long k,
+                                const unsigned long int nbr,
+                                usolve_flags *flags){
+  if(flags->ntasks == flags->tasks_alloc){
+    flags->tasks_alloc = 2 * flags->tasks_alloc + 16;
+    flags->tasks = realloc(flags->tasks,
+                           flags->tasks_alloc * sizeof(bisection_task));
+  }
+  bisection_task *t = flags->tasks + flags->ntasks;
+  t->upol = (mpz_t *)malloc((deg + 1) * sizeof(mpz_t));
+  for(unsigned long int i = 0; i <= deg; i++){
+    mpz_init_set(t->upol[i], upol[i]);
+  }
+  t->deg = deg;
+  mpz_init_set(t->c, c);
+  t->k = k;
+  t->pos = nbr;
+  flags->ntasks++;
+  if(flags->verbose >= 1){
+    fprintf(stderr, "&");
+  }
+}
+
 static long nb_default_case_in_bisection_rec(mpz_t *upol, unsigned long int *deg,
                                              mpz_t c,
                                              const long k, mpz_t tmp,
@@ -691,8 +726,14 @@ static long nb_default_case_in_bisection_rec(mpz_t *upol, unsigned long int *deg
                                            *deg, flags->nthreads);
 
   if(branch_left==1){
-    oldk = bisection_rec(upol, deg, tmp, k+1, roots, nbr,
-                         flags, tmp_half);
+    if(flags->task_depth > 0 && k + 1 >= flags->task_depth){
+      push_bisection_task(upol, *deg, tmp, k+1, *nbr, flags);
+      oldk = k + 1;
+    }
+    else{
+      oldk = bisection_rec(upol, deg, tmp, k+1, roots, nbr,
+                           flags, tmp_half);
+    }
   }
   else{
     if(flags->verbose >= 1) fprintf(stderr, "!");
@@ -733,9 +774,7 @@ static long nb_default_case_in_bisection_rec(mpz_t *upol, unsigned long int *deg
     taylorshift1_naive(upol, *deg);
   }
   else{
-    taylorshift1_dac(upol, *deg,
-                     flags->tmpol, flags->shift_pwx, flags->pwx,
-                     flags->nthreads);
+    taylorshift1(upol, *deg, flags);
   }
   flags->time_shift += (realtime()-e_time);
   (flags->transl)++;
@@ -745,8 +784,14 @@ static long nb_default_case_in_bisection_rec(mpz_t *upol, unsigned long int *deg
                                              flags->nthreads);
     }
   if(branch_right==1){
-    oldk = bisection_rec(upol, deg, tmp, k+1, roots, nbr,
-                         flags, tmp_half);
+    if(flags->task_depth > 0 && k + 1 >= flags->task_depth){
+      push_bisection_task(upol, *deg, tmp, k+1, *nbr, flags);
+      oldk = k + 1;
+    }
+    else{
+      oldk = bisection_rec(upol, deg, tmp, k+1, roots, nbr,
+                           flags, tmp_half);
+    }
   }
   else{
     oldk = k + 1;
@@ -951,12 +996,18 @@ static void initialize_flags(usolve_flags *flags){
   flags->tmp_threads = NULL;
   flags->pols_threads = NULL;
 
+  flags->task_depth = 0;
+  flags->tasks = NULL;
+  flags->ntasks = 0;
+  flags->tasks_alloc = 0;
+
   flags->time_desc = 0;
   flags->time_shift = 0;
   flags->nthreads = 1;
   flags->verbose = 0;
   flags->bfile = 0;
   flags->classical_algo = 0;
+  flags->multimod_shift = 1;
   flags->print_stats = 0;
   flags->debug = 0;
 }
@@ -1067,6 +1118,228 @@ static inline void free_heap_flags(usolve_flags *flags,
   }
 }
 
+static void free_task_flags(usolve_flags *flags,
+                            const unsigned long int deg){
+  free_heap_flags(flags, deg);
+  if(flags->classical_algo == 0){
+    free(flags->tmpol);
+    free(flags->tmpol_desc);
+    if(flags->shift_pwx != NULL){
+      unallocate_shift_pwx(flags->shift_pwx,
+                           flags->npwr, flags->pwx);
+      free(flags->shift_pwx);
+    }
+  }
+  else{
+    mpz_clear(flags->Values[0]);
+    mpz_clear(flags->Values[1]);
+    free(flags->Values);
+  }
+}
+
+/* (re)initializes the heap data of tf, a copy of the flags, for a
+   polynomial of degree deg, *tdeg is the degree it is allocated for */
+static void prepare_task_flags(usolve_flags *tf, unsigned long int *tdeg,
+                               const unsigned long int deg){
+  if(*tdeg == 0 || tf->cur_deg != deg){
+    if(*tdeg > 0){
+      free_task_flags(tf, *tdeg);
+    }
+    initialize_heap_flags(tf, deg);
+    *tdeg = deg;
+  }
+}
+
+static void copy_task_flags(usolve_flags *tf, const usolve_flags *flags,
+                            const unsigned int nthreads){
+  *tf = *flags;
+  tf->nthreads = nthreads;
+  tf->task_depth = 0;
+  tf->tasks = NULL;
+  tf->ntasks = 0;
+  tf->tasks_alloc = 0;
+  tf->transl = 0;
+  tf->node_looked = 0;
+  tf->half_done = 0;
+  tf->time_desc = 0;
+  tf->time_shift = 0;
+}
+
+static void add_task_stats(usolve_flags *flags, const usolve_flags *tf){
+  flags->transl += tf->transl;
+  flags->node_looked += tf->node_looked;
+  flags->half_done += tf->half_done;
+  flags->time_desc += tf->time_desc;
+  flags->time_shift += tf->time_shift;
+}
+
+static void free_bisection_task(bisection_task *t){
+  for(unsigned long int j = 0; j <= t->deg; j++){
+    mpz_clear(t->upol[j]);
+  }
+  free(t->upol);
+  mpz_clear(t->c);
+}
+
+/* inserts the tnbr[i] roots troots[i] found in the subtree of tasks[i]
+   into the sorted array roots of length *nbr, frees troots[i] */
+static void merge_task_roots(interval *roots, unsigned long int *nbr,
+                             const bisection_task *tasks,
+                             const unsigned long int ntasks,
+                             interval **troots,
+                             const unsigned long int *tnbr){
+  unsigned long int nb = *nbr;
+  for(unsigned long int i = 0; i < ntasks; i++){
+    nb += tnbr[i];
+  }
+  interval *merged = (interval *)malloc((nb + 1) * sizeof(interval));
+  unsigned long int n = 0, j = 0;
+  for(unsigned long int i = 0; i < ntasks; i++){
+    for(; j < tasks[i].pos; j++){
+      merged[n++] = roots[j];
+    }
+    for(unsigned long int l = 0; l < tnbr[i]; l++){
+      merged[n++] = troots[i][l];
+    }
+    free(troots[i]);
+  }
+  for(; j < *nbr; j++){
+    merged[n++] = roots[j];
+  }
+  for(n = 0; n < nb; n++){
+    roots[n] = merged[n];
+  }
+  *nbr = nb;
+  free(merged);
+}
+
+/* Isolates the roots of upol in (0, 1) as bisection_rec does.
+
+   With several threads, the bisection tree is first explored level by
+   level: the subtrees which are still to be investigated are collected
+   as tasks, each one with its own copy of the polynomial, until there are
+   enough of them for all threads. The tasks are then isolated in
+   parallel, each one by a single thread with its own flags. Since a task
+   knows how many roots lie left of its interval, the roots it finds are
+   merged into roots in sorted order. */
+static void bisection_with_tasks(mpz_t *upol, unsigned long *deg,
+                                 mpz_t c,
+                                 interval *roots,
+                                 unsigned long int *nbr,
+                                 usolve_flags *flags,
+                                 mpz_t tmp_half){
+
+  if(flags->nthreads <= 1 || flags->hasrealroots == 1
+     || *deg < THRESHOLDTASKS){
+    bisection_rec(upol, deg, c, 0, roots, nbr, flags, tmp_half);
+    return;
+  }
+
+  const unsigned long int ntarget = 4 * flags->nthreads;
+  unsigned long int i, j;
+
+  flags->ntasks = 0;
+  flags->task_depth = 2;
+  bisection_rec(upol, deg, c, 0, roots, nbr, flags, tmp_half);
+  flags->task_depth = 0;
+
+  /* splits the tasks further, the intermediate levels of the tree are
+     still handled with all threads working on each node */
+  usolve_flags ef;
+  unsigned long int edeg = 0;
+  copy_task_flags(&ef, flags, flags->nthreads);
+  for(int r = 0; r < 32 && flags->ntasks > 0 && flags->ntasks < ntarget; r++){
+    const unsigned long int ntasks = flags->ntasks;
+    bisection_task *tasks = flags->tasks;
+    interval **troots = (interval **)malloc(ntasks * sizeof(interval *));
+    unsigned long int *tnbr = (unsigned long int *)calloc(ntasks,
+                                                          sizeof(unsigned long int));
+    unsigned long int *first = (unsigned long int *)malloc((ntasks + 1) *
+                                                           sizeof(unsigned long int));
+    for(i = 0; i < ntasks; i++){
+      bisection_task *t = tasks + i;
+      prepare_task_flags(&ef, &edeg, t->deg);
+      first[i] = ef.ntasks;
+      ef.task_depth = t->k + 2;
+      unsigned long int d = t->deg;
+      troots[i] = (interval *)malloc((t->deg + 1) * sizeof(interval));
+      bisection_rec(t->upol, &d, t->c, t->k, troots[i], tnbr + i,
+                    &ef, tmp_half);
+      ef.task_depth = 0;
+      free_bisection_task(t);
+    }
+    first[ntasks] = ef.ntasks;
+    /* positions of new tasks are relative to the roots found in the
+       subtree they stem from */
+    unsigned long int off = 0;
+    for(i = 0; i < ntasks; i++){
+      for(j = first[i]; j < first[i+1]; j++){
+        ef.tasks[j].pos += tasks[i].pos + off;
+      }
+      off += tnbr[i];
+    }
+    merge_task_roots(roots, nbr, tasks, ntasks, troots, tnbr);
+    free(first);
+    free(troots);
+    free(tnbr);
+    free(tasks);
+    flags->tasks = ef.tasks;
+    flags->ntasks = ef.ntasks;
+    flags->tasks_alloc = ef.tasks_alloc;
+    ef.tasks = NULL;
+    ef.ntasks = 0;
+    ef.tasks_alloc = 0;
+  }
+  if(edeg > 0){
+    free_task_flags(&ef, edeg);
+  }
+  add_task_stats(flags, &ef);
+
+  const unsigned long int ntasks = flags->ntasks;
+  bisection_task *tasks = flags->tasks;
+  if(flags->verbose >= 1){
+    fprintf(stderr, "[%lu tasks]", ntasks);
+  }
+
+  interval **troots = (interval **)malloc((ntasks + 1) * sizeof(interval *));
+  unsigned long int *tnbr = (unsigned long int *)calloc(ntasks + 1,
+                                                        sizeof(unsigned long int));
+
+#pragma omp parallel num_threads(flags->nthreads)
+  {
+    usolve_flags tf;
+    unsigned long int tdeg = 0;
+    mpz_t th;
+    copy_task_flags(&tf, flags, 1);
+    mpz_init(th);
+
+#pragma omp for schedule(dynamic)
+    for(unsigned long int l = 0; l < ntasks; l++){
+      bisection_task *t = tasks + l;
+      prepare_task_flags(&tf, &tdeg, t->deg);
+      unsigned long int d = t->deg;
+      troots[l] = (interval *)malloc((t->deg + 1) * sizeof(interval));
+      bisection_rec(t->upol, &d, t->c, t->k, troots[l], tnbr + l, &tf, th);
+      free_bisection_task(t);
+    }
+    if(tdeg > 0){
+      free_task_flags(&tf, tdeg);
+    }
+    mpz_clear(th);
+#pragma omp critical
+    add_task_stats(flags, &tf);
+  }
+
+  merge_task_roots(roots, nbr, tasks, ntasks, troots, tnbr);
+
+  free(troots);
+  free(tnbr);
+  free(flags->tasks);
+  flags->tasks = NULL;
+  flags->ntasks = 0;
+  flags->tasks_alloc = 0;
+}
+
 static void display_stats(usolve_flags *flags){
 
   fprintf(stderr,"\n");
@@ -1159,9 +1432,9 @@ interval *bisection_Uspensky(mpz_t *upol0, unsigned long deg,
     initialize_heap_flags(flags, deg);
 
     unsigned olddeg = deg;
-    bisection_rec(upol, &deg, e, 0,
-                  pos_roots, nb_pos_roots,
-                  flags, tmp_half);
+    bisection_with_tasks(upol, &deg, e,
+                         pos_roots, nb_pos_roots,
+                         flags, tmp_half);
     nb_positive_roots = *nb_pos_roots;
 
     free_heap_flags(flags, olddeg);
@@ -1215,9 +1488,9 @@ interval *bisection_Uspensky(mpz_t *upol0, unsigned long deg,
 
     initialize_heap_flags(flags, deg);
     unsigned long int olddeg = deg;
-    bisection_rec(upol, &deg, e, 0,
-                  neg_roots, nb_neg_roots,
-                  flags, tmp_half);
+    bisection_with_tasks(upol, &deg, e,
+                         neg_roots, nb_neg_roots,
+                         flags, tmp_half);
     nb_negative_roots = (*nb_neg_roots);
     free_heap_flags(flags, olddeg);
     unallocate_shift_pwx(flags->shift_pwx,
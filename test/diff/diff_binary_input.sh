@@ -0,0 +1,57 @@
+#!/bin/bash
+
+file=cyclic5-31
+
+$(pwd)/msolve -f input_files/$file.ms -B test/diff/$file.bin
+if [ $? -gt 0 ]; then
+    exit 1
+fi
+
+$(pwd)/msolve -f test/diff/$file.bin -o test/diff/$file.res \
+      -d 4 -P 2 -l 2 -t 1
+if [ $? -gt 0 ]; then
+    exit 2
+fi
+
+diff test/diff/$file.res output_files/$file.res
+if [ $? -gt 0 ]; then
+    exit 3
+fi
+
+rm test/diff/$file.res test/diff/$file.bin
+
+file=kat7-qq
+
+$(pwd)/msolve -f input_files/$file.ms -B test/diff/$file.bin
+if [ $? -gt 0 ]; then
+    exit 21
+fi
+
+$(pwd)/msolve -f test/diff/$file.bin -o test/diff/$file.res \
+      -P 2 -d 0 -l 2 -t 2
+if [ $? -gt 0 ]; then
+    exit 22
+fi
+
+diff test/diff/$file.res output_files/$file.res
+if [ $? -gt 0 ]; then
+    exit 23
+fi
+
+rm test/diff/$file.res test/diff/$file.bin
+
+# coefficients outside [0, p) are reduced as in the text format
+file=cyclic5-31
+
+$(pwd)/msolve -f input_files/$file-unreduced.bin -o test/diff/$file.res \
+      -d 4 -P 2 -l 2 -t 1
+if [ $? -gt 0 ]; then
+    exit 31
+fi
+
+diff test/diff/$file.res output_files/$file.res
+if [ $? -gt 0 ]; then
+    exit 32
+fi
+
+rm test/diff/$file.res
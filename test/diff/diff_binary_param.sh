@@ -0,0 +1,27 @@
+#!/bin/bash
+
+file=kat7-qq
+
+$(pwd)/msolve -f input_files/$file.ms -o test/diff/$file.res \
+      -O test/diff/$file.param -P 2 -d 0 -l 2 -t 1
+if [ $? -gt 0 ]; then
+    exit 1
+fi
+
+diff test/diff/$file.res output_files/$file.res
+if [ $? -gt 0 ]; then
+    exit 2
+fi
+
+$(pwd)/msolve -f input_files/$file.ms -o test/diff/$file.res \
+      -F test/diff/$file.param -P 2 -d 0 -l 2 -t 1
+if [ $? -gt 0 ]; then
+    exit 21
+fi
+
+diff test/diff/$file.res output_files/$file.res
+if [ $? -gt 0 ]; then
+    exit 22
+fi
+
+rm test/diff/$file.res test/diff/$file.param
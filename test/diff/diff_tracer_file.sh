@@ -0,0 +1,54 @@
+#!/bin/bash
+
+file=kat7-qq
+
+$(pwd)/msolve -f input_files/$file.ms -o test/diff/$file.res \
+      -W test/diff/$file.tracer -P 2 -d 0 -l 2 -t 1
+if [ $? -gt 0 ]; then
+    exit 1
+fi
+
+diff test/diff/$file.res output_files/$file.res
+if [ $? -gt 0 ]; then
+    exit 2
+fi
+
+if [ ! -s test/diff/$file.tracer ]; then
+    exit 3
+fi
+
+$(pwd)/msolve -f input_files/$file.ms -o test/diff/$file.res \
+      -T test/diff/$file.tracer -P 2 -d 0 -l 2 -t 1 -v 1 \
+      2> test/diff/$file.err
+if [ $? -gt 0 ]; then
+    exit 21
+fi
+
+diff test/diff/$file.res output_files/$file.res
+if [ $? -gt 0 ]; then
+    exit 22
+fi
+
+grep -q "Tracer loaded" test/diff/$file.err
+if [ $? -gt 0 ]; then
+    exit 23
+fi
+
+$(pwd)/msolve -f input_files/$file.ms -o test/diff/$file.res \
+      -T test/diff/$file.tracer -P 2 -d 0 -l 2 -t 2 -v 1 \
+      2> test/diff/$file.err
+if [ $? -gt 0 ]; then
+    exit 41
+fi
+
+diff test/diff/$file.res output_files/$file.res
+if [ $? -gt 0 ]; then
+    exit 42
+fi
+
+grep -q "Tracer loaded" test/diff/$file.err
+if [ $? -gt 0 ]; then
+    exit 43
+fi
+
+rm test/diff/$file.res test/diff/$file.tracer test/diff/$file.err
@@ -0,0 +1,143 @@
+/* This file is part of msolve.
+ *
+ * msolve is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * msolve is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with msolve.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * Authors:
+ * Jérémy Berthomieu
+ * Christian Eder
+ * Vincent Neiger
+ * Mohab Safey El Din */
+
+#include "../../src/msolve/libmsolve.c"
+
+#define TEST_BATCH_NUMBER_SYSTEMS 3
+#define TEST_BATCH_NUMBER_TERMS 5
+
+/** x^2 + y^2 - a, x*y - b for several pairs (a, b), all systems share
+ * the same support, thus the tracer learned for the first one applies
+ * to the others **/
+static const int32_t test_batch_ab[TEST_BATCH_NUMBER_SYSTEMS][2] = {
+    {5, 2}, {10, 3}, {13, 6}
+};
+
+/** compare the result of one system solved by msolve_julia_batch with
+ * the one msolve_julia returns
+ * returns 0 if equal, returns nonzero otherwise
+ **/
+static int julia_result_cmp(
+        int32_t ld1, int32_t nr_vars1, int32_t dim1, int32_t dquot1,
+        int32_t *lens1, void *cfs1, int32_t n_real_sols1,
+        void *real_sols_num1, int32_t *real_sols_den1,
+        int32_t ld2, int32_t nr_vars2, int32_t dim2, int32_t dquot2,
+        int32_t *lens2, void *cfs2, int32_t n_real_sols2,
+        void *real_sols_num2, int32_t *real_sols_den2)
+{
+    if (ld1 != ld2) return 1;
+    if (nr_vars1 != nr_vars2) return 1;
+    if (dim1 != dim2) return 1;
+    if (dquot1 != dquot2) return 1;
+    if (n_real_sols1 != n_real_sols2) return 1;
+    if (dim1 != 0 || dquot1 == 0) return 0;
+
+    long nterms = 0;
+    for (long i = 0; i < ld1; i++) {
+        if (lens1[i] != lens2[i])
+            return 1;
+        nterms += lens1[i];
+    }
+    for (long i = 0; i < nterms; i++)
+        if (mpz_cmp(((mpz_t *)cfs1)[i], ((mpz_t *)cfs2)[i]))
+            return 1;
+
+    const long nsols = 2 * (long)n_real_sols1 * nr_vars1;
+    for (long i = 0; i < nsols; i++) {
+        if (mpz_cmp(((mpz_t *)real_sols_num1)[i], ((mpz_t *)real_sols_num2)[i]))
+            return 1;
+        if (real_sols_den1[i] != real_sols_den2[i])
+            return 1;
+    }
+
+    return 0;
+}
+
+/** this tests that msolve_julia_batch returns for each system the same
+ * result as msolve_julia does when solving it on its own
+ **/
+int main(void)
+{
+    int32_t lens[2] = {3, 2};
+    int32_t exps[2*TEST_BATCH_NUMBER_TERMS] = {
+        2, 0,   0, 2,   0, 0,
+        1, 1,   0, 0
+    };
+    char *var_names[2] = {"x", "y"};
+
+    mpz_t nums[TEST_BATCH_NUMBER_SYSTEMS][2*TEST_BATCH_NUMBER_TERMS];
+    mpz_t *cf_ptrs[TEST_BATCH_NUMBER_SYSTEMS][2*TEST_BATCH_NUMBER_TERMS];
+    void *cfs[TEST_BATCH_NUMBER_SYSTEMS];
+    for (long k = 0; k < TEST_BATCH_NUMBER_SYSTEMS; k++) {
+        const int32_t cf[TEST_BATCH_NUMBER_TERMS] = {
+            1, 1, -test_batch_ab[k][0], 1, -test_batch_ab[k][1]
+        };
+        for (long i = 0; i < TEST_BATCH_NUMBER_TERMS; i++) {
+            mpz_init_set_si(nums[k][2*i], cf[i]);
+            mpz_init_set_ui(nums[k][2*i+1], 1);
+            cf_ptrs[k][2*i]   = &nums[k][2*i];
+            cf_ptrs[k][2*i+1] = &nums[k][2*i+1];
+        }
+        cfs[k] = (void *)cf_ptrs[k];
+    }
+
+    int32_t ld[TEST_BATCH_NUMBER_SYSTEMS];
+    int32_t nr_vars[TEST_BATCH_NUMBER_SYSTEMS];
+    int32_t dim[TEST_BATCH_NUMBER_SYSTEMS];
+    int32_t dquot[TEST_BATCH_NUMBER_SYSTEMS];
+    int32_t *rp_lens[TEST_BATCH_NUMBER_SYSTEMS];
+    char **rp_var_names[TEST_BATCH_NUMBER_SYSTEMS];
+    void *rp_cfs_lf[TEST_BATCH_NUMBER_SYSTEMS];
+    void *rp_cfs[TEST_BATCH_NUMBER_SYSTEMS];
+    int32_t n_real_sols[TEST_BATCH_NUMBER_SYSTEMS];
+    void *real_sols_num[TEST_BATCH_NUMBER_SYSTEMS];
+    int32_t *real_sols_den[TEST_BATCH_NUMBER_SYSTEMS];
+
+    msolve_julia_batch(malloc, TEST_BATCH_NUMBER_SYSTEMS, ld, nr_vars, dim,
+            dquot, rp_lens, rp_var_names, rp_cfs_lf, rp_cfs, n_real_sols,
+            real_sols_num, real_sols_den, lens, exps, cfs, var_names,
+            0, 0, 0, 2, 2, 12, 1, 0, 0, 2, 0, 0, 0, 2, 128, 0);
+
+    for (long k = 0; k < TEST_BATCH_NUMBER_SYSTEMS; k++) {
+        int32_t ld1, nr_vars1, dim1, dquot1, n_real_sols1;
+        int32_t *rp_lens1 = NULL, *real_sols_den1 = NULL;
+        char **rp_var_names1 = NULL;
+        void *rp_cfs_lf1 = NULL, *rp_cfs1 = NULL, *real_sols_num1 = NULL;
+
+        msolve_julia(malloc, &ld1, &nr_vars1, &dim1, &dquot1, &rp_lens1,
+                &rp_var_names1, &rp_cfs_lf1, &rp_cfs1, &n_real_sols1,
+                &real_sols_num1, &real_sols_den1, lens, exps, cfs[k],
+                var_names, NULL, 0, 0, 0, 2, 2, 12, 1, 0, 0, 2, 0, 0, 0, 2,
+                128, 0);
+
+        if (dim1 != 0 || dquot1 != 4 || n_real_sols1 != 4)
+            return 1;
+
+        if (julia_result_cmp(ld[k], nr_vars[k], dim[k], dquot[k],
+                    rp_lens[k], rp_cfs[k], n_real_sols[k],
+                    real_sols_num[k], real_sols_den[k],
+                    ld1, nr_vars1, dim1, dquot1, rp_lens1, rp_cfs1,
+                    n_real_sols1, real_sols_num1, real_sols_den1))
+            return 1;
+    }
+
+    return 0;
+}
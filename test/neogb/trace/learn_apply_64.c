@@ -0,0 +1,146 @@
+#include "../../../src/neogb/libneogb.h"
+
+/* katsura-3 over the rationals */
+static const int32_t nr_vars  = 4;
+static const int32_t nr_gens  = 4;
+static const int32_t lens[]   = {5, 5, 4, 4};
+static const int32_t cfs[]    = {
+    1, 2, 2, 2, -1,
+    1, 2, 2, 2, -1,
+    2, 2, 2, -1,
+    1, 2, 2, -1
+};
+static const int32_t exps[]   = {
+    1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1,  0, 0, 0, 0,
+    2, 0, 0, 0,  0, 2, 0, 0,  0, 0, 2, 0,  0, 0, 0, 2,  1, 0, 0, 0,
+    1, 1, 0, 0,  0, 1, 1, 0,  0, 0, 1, 1,  0, 1, 0, 0,
+    0, 2, 0, 0,  1, 0, 1, 0,  0, 1, 0, 1,  0, 0, 1, 0
+};
+
+/* primes above 2^32, handled with 64 bit coefficients */
+static const uint64_t p_learn = 4611686018427388039UL;
+static const uint64_t p_apply = 9223372036853727331UL;
+
+static bs_t *prepare_input(
+        md_t **stp,
+        mpz_t **pcfs
+        )
+{
+    int *invalid_gens       =   NULL;
+    uint32_t field_char     =   0;
+    int32_t mon_order       =   0;
+    int32_t elim_block_len  =   0;
+    int32_t nv              =   nr_vars;
+    int32_t ng              =   nr_gens;
+    int32_t nr_nf           =   0;
+    int32_t ht_size         =   12;
+    int32_t nr_threads      =   1;
+    int32_t max_nr_pairs    =   0;
+    int32_t reset_ht        =   2;
+    int32_t la_option       =   2;
+    int32_t use_signatures  =   0;
+    int32_t reduce_gb       =   1;
+    int32_t truncate_lifting =  0;
+    int32_t info_level      =   0;
+
+    validate_input_data(&invalid_gens, pcfs, lens, &field_char, &mon_order,
+            &elim_block_len, &nv, &ng, &nr_nf, &ht_size, &nr_threads,
+            &max_nr_pairs, &reset_ht, &la_option, &use_signatures,
+            &reduce_gb, &truncate_lifting, &info_level);
+
+    md_t *st  = allocate_meta_data();
+    check_and_set_meta_data_trace(st, lens, exps, pcfs, invalid_gens,
+            field_char, mon_order, elim_block_len, nv, ng, nr_nf, ht_size,
+            nr_threads, max_nr_pairs, reset_ht, la_option, use_signatures,
+            reduce_gb, 1073741827, 1, 0, truncate_lifting, info_level);
+
+    bs_t *bs  = initialize_basis(st);
+    import_input_data(bs, st, 0, st->ngens_input, lens, exps, pcfs,
+            invalid_gens);
+    calculate_divmask(bs->ht);
+    sort_r(bs->hm, (unsigned long)bs->ld, sizeof(hm_t *),
+            initial_input_cmp, bs->ht);
+    remove_content_of_initial_basis(bs);
+
+    *stp  = st;
+    return bs;
+}
+
+/* both bases have to agree term by term */
+static int cmp_bases(
+        const bs_t * const a,
+        const bs_t * const b
+        )
+{
+    len_t i, j, k;
+
+    if (a->lml != b->lml) {
+        return 1;
+    }
+    for (i = 0; i < a->lml; ++i) {
+        const hm_t *ha  = a->hm[a->lmps[i]];
+        const hm_t *hb  = b->hm[b->lmps[i]];
+        if (ha[LENGTH] != hb[LENGTH]) {
+            return 1;
+        }
+        const cf64_t *ca  = a->cf_64[ha[COEFFS]];
+        const cf64_t *cb  = b->cf_64[hb[COEFFS]];
+        for (j = 0; j < ha[LENGTH]; ++j) {
+            if (ca[j] != cb[j]) {
+                return 1;
+            }
+            const exp_t *ea = a->ht->ev[ha[OFFSET+j]];
+            const exp_t *eb = b->ht->ev[hb[OFFSET+j]];
+            for (k = 0; k < a->ht->evl; ++k) {
+                if (ea[k] != eb[k]) {
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+    len_t i;
+    int32_t err   = 0;
+    const len_t nterms  = 18;
+
+    mpz_t *q      = malloc(2 * nterms * sizeof(mpz_t));
+    mpz_t **pcfs  = malloc(2 * nterms * sizeof(mpz_t *));
+    for (i = 0; i < nterms; ++i) {
+        mpz_init_set_si(q[2*i], cfs[i]);
+        mpz_init_set_ui(q[2*i+1], 1);
+        pcfs[2*i]   = &q[2*i];
+        pcfs[2*i+1] = &q[2*i+1];
+    }
+
+    /* learn the tracer modulo p_learn and apply it modulo p_apply */
+    md_t *st    = NULL;
+    bs_t *bs_qq = prepare_input(&st, pcfs);
+    st->f4_qq_round = 1;
+    bs_t *bs    = core_gba(bs_qq, st, &err, p_learn);
+    if (err || bs == NULL || bs->lml == 0) {
+        return 1;
+    }
+    st->f4_qq_round = 2;
+    bs_t *bs_tr = core_gba(bs_qq, st, &err, p_apply);
+    if (err || bs_tr == NULL) {
+        return 2;
+    }
+
+    /* learning modulo p_apply directly gives the same basis */
+    md_t *st2   = NULL;
+    bs_t *bs_qq2  = prepare_input(&st2, pcfs);
+    st2->f4_qq_round = 1;
+    bs_t *bs_ref  = core_gba(bs_qq2, st2, &err, p_apply);
+    if (err || bs_ref == NULL) {
+        return 3;
+    }
+    if (cmp_bases(bs_tr, bs_ref) != 0) {
+        return 4;
+    }
+
+    return 0;
+}